@@ -3,6 +3,10 @@
 # Execute the unit tests with coverage support
 make COV=1 run-test
 
+# Execute the unit tests with the direction cache in single precision
+sudo make clean
+make CACHE_FLOAT=1 run-test
+
 # Run the unit tests in Python
 if [[ $CC = *"gcc"* ]] && [[ $SCS_RUN_PYTHON == 1 ]]; then 
     cd python/;
@@ -90,6 +90,7 @@ void genRandomProbData(scs_int nnz, scs_int col_nnz, ScsData *d, ScsCone *k,
     scs_float *s = opt_sol->s = scs_calloc(m, sizeof(scs_float));
     /* temporary variables */
     scs_float *z = scs_calloc(m, sizeof(scs_float));
+    ScsConeWork *coneWork = scs_init_conework(k);
     scs_int i, j, r;
 
     A->i = scs_calloc(nnz, sizeof(scs_int));
@@ -102,7 +103,8 @@ void genRandomProbData(scs_int nnz, scs_int col_nnz, ScsData *d, ScsCone *k,
         y[i] = z[i] = rand_scs_float();
     }
 
-    scs_project_dual_cone(y, k, SCS_NULL, SCS_NULL, -1);
+    scs_project_dual_cone(y, k, coneWork, SCS_NULL, -1);
+    scs_finish_cone(coneWork);
 
     for (i = 0; i < m; i++) {
         b[i] = s[i] = y[i] - z[i];
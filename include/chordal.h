@@ -0,0 +1,148 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 Pantelis Sopasakis (https://alphaville.github.io),
+ *                    Krina Menounou (https://www.linkedin.com/in/krinamenounou), 
+ *                    Panagiotis Patrinos (http://homes.esat.kuleuven.be/~ppatrino)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * 
+ */
+#ifndef SCS_CHORDAL_H
+#define SCS_CHORDAL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "scs.h"
+
+    /**
+     * \brief Chordal decomposition of a single positive semidefinite cone.
+     * 
+     * The cone is replaced by a collection of smaller PSD cones, one for each
+     * clique of a chordal extension of its aggregate sparsity pattern. The
+     * cliques are stored in topological order, that is, every clique comes
+     * before its parent in the clique tree.
+     */
+    typedef struct scs_chordal_block {
+        scs_int size; /**< \brief dimension of the original PSD cone */
+        scs_int row_offset; /**< \brief first row of the original cone in \f$A\f$ */
+        scs_int col_offset; /**< \brief first column of the clique variables in the decomposed problem */
+        scs_int clique_row_offset; /**< \brief first row of the clique cones in the decomposed problem */
+        scs_int num_cliques; /**< \brief number of cliques */
+        scs_int *clique_ptr; /**< \brief clique \c k consists of the vertices <code>clique_vertices[clique_ptr[k]..clique_ptr[k+1]-1]</code> */
+        scs_int *clique_vertices; /**< \brief vertices of the cliques (sorted within each clique) */
+        scs_int *parent; /**< \brief parent of each clique in the clique tree (\c -1 for roots) */
+    } ScsChordalBlock;
+
+    /**
+     * \brief Chordal decomposition of the PSD cones of a problem.
+     * 
+     * Every decomposed cone \f$\mathcal{S}_+^N\f$ with (chordal) aggregate 
+     * sparsity pattern \f$E\f$ and cliques \f$C_1,\ldots,C_p\f$ is replaced 
+     * by the equality constraints 
+     * \f[
+     *  A_E x + \sum_{k=1}^{p} H_k \tilde{s}_k = b_E,
+     * \f]
+     * where \f$H_k\f$ scatters the entries of the clique matrices to the 
+     * entries of the original one, and the cone constraints 
+     * \f$\tilde{s}_k \in \mathcal{S}_+^{|C_k|}\f$. The clique variables 
+     * \f$\tilde{s}_k\f$ are appended to \f$x\f$.
+     */
+    struct scs_chordal {
+        scs_int m; /**< \brief number of rows of the original problem */
+        scs_int n; /**< \brief number of columns of the original problem */
+        ScsData *data; /**< \brief decomposed problem data (settings are shared with the original) */
+        ScsCone *cone; /**< \brief decomposed cone */
+        ScsSolution *sol; /**< \brief solution of the decomposed problem */
+        scs_int *row_map; /**< \brief maps rows of the original problem to rows of the decomposed one (\c -1 if dropped) */
+        scs_int num_blocks; /**< \brief number of decomposed PSD cones */
+        ScsChordalBlock *blocks; /**< \brief decomposed PSD cones */
+    };
+
+    /**
+     * Computes the chordal decomposition of the PSD cones of a given problem.
+     * 
+     * @param data problem data
+     * @param cone problem cone
+     * 
+     * @return the decomposition, or \c SCS_NULL if none of the PSD cones is 
+     * worth decomposing (or if memory could not be allocated).
+     */
+    ScsChordal *scs_chordal_init(
+            const ScsData * RESTRICT data,
+            const ScsCone * RESTRICT cone);
+
+    /**
+     * Copies the vectors \f$b\f$ and \f$c\f$ of the original problem into the
+     * decomposed one.
+     * 
+     * @param chordal chordal decomposition
+     * @param data original problem data
+     * 
+     * @return \c 0 on success, or \c -1 if an entry of \f$b\f$ which is 
+     * outside the sparsity pattern of a decomposed PSD cone (and was zero when
+     * ::scs_chordal_init was called) is nonzero; such entries cannot be 
+     * represented in the decomposed problem, which must then be set up again.
+     */
+    scs_int scs_chordal_update_data(
+            ScsChordal * RESTRICT chordal,
+            const ScsData * RESTRICT data);
+
+    /**
+     * Maps a solution of the original problem to a solution of the decomposed
+     * one (e.g., to warm start the solver).
+     * 
+     * @param chordal chordal decomposition
+     * @param sol solution of the original problem
+     */
+    void scs_chordal_lift_solution(
+            ScsChordal * RESTRICT chordal,
+            const ScsSolution * RESTRICT sol);
+
+    /**
+     * Maps the solution of the decomposed problem, \c chordal->sol, back to 
+     * the original problem. 
+     * 
+     * The dual variables of the decomposed cones are recovered by a positive
+     * semidefinite completion along the clique tree.
+     * 
+     * @param chordal chordal decomposition
+     * @param sol solution of the original problem (arrays are allocated if 
+     * they are \c SCS_NULL)
+     * 
+     * @return status code (\c 0 on success)
+     */
+    scs_int scs_chordal_recover_solution(
+            const ScsChordal * RESTRICT chordal,
+            ScsSolution * RESTRICT sol);
+
+    /**
+     * Frees the memory allocated for a chordal decomposition.
+     * 
+     * @param chordal chordal decomposition
+     */
+    void scs_chordal_free(ScsChordal * RESTRICT chordal);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SCS_CHORDAL_H */
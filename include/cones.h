@@ -63,6 +63,30 @@ extern "C" {
          * \forall i\}\f$
          */
         scs_int l;
+        /**
+         * \brief Dimension of the box cone \f$(n_{\mathrm{b}})\f$, including
+         * the homogenizing variable \f$t\f$ (0 means no box cone)
+         * 
+         * The box cone is 
+         * \f$\mathcal{K}^{b} = \{(t, s)\in\mathbb{R}\times\mathbb{R}^{n_b-1}: 
+         * t \geq 0, t b_l \leq s \leq t b_u\}\f$.
+         * 
+         * Bounds \f$b_l \leq s \leq b_u\f$ then take one row per variable 
+         * (plus a row fixing \f$t=1\f$) instead of two LP rows.
+         * 
+         * \sa \ref #bl "lower bounds", \ref #bu "upper bounds"
+         */
+        scs_int bsize;
+        /**
+         * \brief Lower bounds of the box cone \f$(b_l)\f$, of length 
+         * <code>bsize-1</code>; entries may be <code>-INFINITY</code>
+         */
+        scs_float *bl;
+        /**
+         * \brief Upper bounds of the box cone \f$(b_u)\f$, of length 
+         * <code>bsize-1</code>; entries may be <code>INFINITY</code>
+         */
+        scs_float *bu;
         /** 
          * \brief Array of SOC constraints 
          * \f$(n_{\mathrm{q},1},\ldots, n_{\mathrm{q},N_{\mathrm{q}}})\f$.
@@ -85,6 +109,24 @@ extern "C" {
          * \sa \ref #q "array of second-order cones"
          */
         scs_int qsize; 
+        /** 
+         * \brief Array of rotated SOC constraints 
+         * \f$(n_{\mathrm{r},1},\ldots, n_{\mathrm{r},N_{\mathrm{r}}})\f$.
+         * 
+         * The rotated second-order cone of dimension \f$n \geq 2\f$ is 
+         * \f$\mathcal{Q}_r^{n} = \{(u, v, w)\in\mathbb{R}\times\mathbb{R}
+         * \times\mathbb{R}^{n-2}: 2uv \geq \|w\|^2, u, v \geq 0\}\f$; it is 
+         * self-dual.
+         * 
+         * \sa \ref #rqsize "number of rotated second-order cones"
+         */
+        scs_int *RESTRICT rq;
+        /** 
+         * \brief Length of the rotated SOC array \f$(N_{\mathrm{r}})\f$
+         * 
+         * \sa \ref #rq "array of rotated second-order cones"
+         */
+        scs_int rqsize;
         /** 
          * \brief array of PSD constraints \f$(k_1,\ldots, k_{N_{\mathrm{s}}})\f$
          * 
@@ -137,6 +179,47 @@ extern "C" {
         scs_float * RESTRICT work;
         blasint * RESTRICT iwork, lwork, liwork;
 #endif
+        /** 
+         * dual variables of the last projections onto the exponential cones 
+         * (first the \c ep primal, then the \c ed dual ones), used to 
+         * warm-start the next projection
+         */
+        scs_float * RESTRICT exp_rho;
+        /* structure-of-arrays buffers for the exponential cones: */
+        scs_float * RESTRICT exp_v;
+        scs_int * RESTRICT exp_idx;
+        /* structure-of-arrays buffers for the power cones: */
+        scs_float * RESTRICT pow_v;
+        scs_float * RESTRICT pow_proj;
+        scs_int * RESTRICT pow_idx;
+        /** 
+         * values of \f$r\f$ at the last projections onto the power cones, 
+         * used to warm-start the Newton iterations of the next projection
+         */
+        scs_float * RESTRICT pow_r;
+        /* buffer for the projection onto the box cone and warm start of t: */
+        scs_float * RESTRICT box_v;
+        scs_float box_t;
+        /**
+         * time (in milliseconds) spent on the projections onto each type of 
+         * cone since the last call to ::scs_reset_cone_stats
+         */
+        scs_float lp_time, box_time, soc_time, psd_time, exp_time, pow_time;
+        /** number of projections onto each type of cone */
+        scs_int lp_projections, box_projections, soc_projections,
+        psd_projections, exp_projections, pow_projections;
+        /** 
+         * number of exponential cone projections which required an iterative
+         * procedure and total number of iterations (regula falsi/bisection)
+         */
+        scs_int exp_iterative, exp_iters;
+        /** 
+         * number of power cone projections which required Newton's method
+         * and total number of Newton iterations
+         */
+        scs_int pow_iterative, pow_newton_iters;
+        /** number of eigenpairs computed in the projections onto PSD cones */
+        scs_int psd_eigenpairs;
         scs_float total_cone_time;
     } ScsConeWork;
 
@@ -163,7 +246,10 @@ extern "C" {
     /** 
      * pass in iter to control how accurate the cone projection
      * with iteration, set iter < 0 for exact projection, warm_start contains guess
-     * of solution, can be SCS_NULL
+     * of solution, can be SCS_NULL; c is the workspace of k (see 
+     * ::scs_init_conework), which is required: it holds the buffers of the 
+     * projections, their warm starts and statistics. Returns -1 if c is 
+     * SCS_NULL or a projection fails and 0 otherwise.
      */
     scs_int scs_project_dual_cone(
             scs_float * RESTRICT x,
@@ -175,10 +261,100 @@ extern "C" {
     void scs_finish_cone(
             ScsConeWork * RESTRICT coneWork);
 
+    /**
+     * Summary of the cone projection statistics which are stored in \c info
+     * 
+     * @param info information about the solution; the statistics are read
+     * from the fields of \c info which start with \c cone_
+     * @param c cone workspace
+     * @return string which is allocated here and should be freed
+     * 
+     * @see ::scs_set_cone_stats
+     */
     char *scs_get_cone_summary(
             const ScsInfo * RESTRICT info,
             ScsConeWork * RESTRICT c);
 
+    /**
+     * Resets the timers and counters of the cone projections.
+     * 
+     * @param c cone workspace
+     */
+    void scs_reset_cone_stats(
+            ScsConeWork * RESTRICT c);
+
+    /**
+     * Copies the timers and counters of the cone projections (accumulated 
+     * since the last call to ::scs_reset_cone_stats) into \c info.
+     * 
+     * @param c cone workspace
+     * @param info information structure to be updated
+     */
+    void scs_set_cone_stats(
+            const ScsConeWork * RESTRICT c,
+            ScsInfo * RESTRICT info);
+
+    /**
+     * Adds the timers and counters of the cone projections of one cone 
+     * workspace to those of another one (e.g., when cone projections are 
+     * carried out with separate workspaces in parallel).
+     * 
+     * @param c cone workspace to be updated
+     * @param other cone workspace whose statistics are added to those of \c c
+     */
+    void scs_add_cone_stats(
+            ScsConeWork * RESTRICT c,
+            const ScsConeWork * RESTRICT other);
+
+    /**
+     * Size of the warm-start state of the cone projections (see 
+     * ::scs_get_cone_warm_start).
+     * 
+     * @param k cone
+     * @return number of elements of the warm-start state
+     */
+    scs_int scs_cone_warm_start_size(const ScsCone * RESTRICT k);
+
+    /**
+     * Copies the warm-start state of the cone projections (dual variables of 
+     * the exponential cones, values of \f$r\f$ of the power cones and \f$t\f$
+     * of the box cone) into \c ws.
+     * 
+     * @param c cone workspace
+     * @param k cone
+     * @param ws array of length ::scs_cone_warm_start_size
+     */
+    void scs_get_cone_warm_start(
+            const ScsConeWork * RESTRICT c,
+            const ScsCone * RESTRICT k,
+            scs_float * RESTRICT ws);
+
+    /**
+     * Sets the warm-start state of the cone projections (the inverse of 
+     * ::scs_get_cone_warm_start).
+     * 
+     * @param c cone workspace
+     * @param k cone
+     * @param ws array of length ::scs_cone_warm_start_size
+     */
+    void scs_set_cone_warm_start(
+            ScsConeWork * RESTRICT c,
+            const ScsCone * RESTRICT k,
+            const scs_float * RESTRICT ws);
+
+    /**
+     * Copies the warm-start state of the cone projections from one cone 
+     * workspace to another.
+     * 
+     * @param c cone workspace to be updated
+     * @param other cone workspace whose warm-start state is copied
+     * @param k cone
+     */
+    void scs_copy_cone_warm_start(
+            ScsConeWork * RESTRICT c,
+            const ScsConeWork * RESTRICT other,
+            const ScsCone * RESTRICT k);
+
 #ifdef __cplusplus
 }
 #endif
@@ -97,6 +97,18 @@ extern "C" {
      * Default maximum number of iterations.
      */
 #define SCS_MAX_ITERS_DEFAULT (10000)
+    /**
+     * Default maximum number of iterations between two convergence checks.
+     */
+#define SCS_MAX_CHECK_INTERVAL_DEFAULT (1)
+    /**
+     * By default, the convergence checks are synchronous.
+     */
+#define SCS_ASYNC_MONITOR_DEFAULT (0)
+    /**
+     * By default, the solver does not install a handler for interrupts (ctrl-c).
+     */
+#define SCS_HANDLE_INTERRUPTS_DEFAULT (0)
 #define SCS_EPS_DEFAULT (1E-3)
 #define SCS_ALPHA_DEFAULT (1.5)
 #define SCS_RHO_X_DEFAULT (0.001)
@@ -106,6 +118,9 @@ extern "C" {
 #define SCS_NORMALIZE_DEFAULT (1)
 #define SCS_DO_RECORD_PROGRESS_DEFAULT (0)
 #define SCS_WARM_START_DEFAULT (0)
+#define SCS_CHORDAL_DECOMPOSITION_DEFAULT (0)
+#define SCS_PRESOLVE_CONES_DEFAULT (1)
+#define SCS_INEXACT_CONE_PROJECTIONS_DEFAULT (0)
 
     /* Parameters for Superscs*/
 #define SCS_DO_SUPERSCS_DEFAULT (1)
@@ -119,6 +134,7 @@ extern "C" {
 
     /* Line-search defaults */
 #define SCS_LS_DEFAULT  (10)
+#define SCS_LS_PARALLEL_DEFAULT (1)
 #define SCS_BETA_DEFAULT (0.5)
 #define SCS_SIGMA_DEFAULT (1E-2)
 
@@ -128,6 +144,8 @@ extern "C" {
 #define SCS_THETABAR_DEFAULT (1E-1)
 #define SCS_ALPHAC_DEFAULT (1E-2) 
 #define SCS_MEMORY_DEFAULT (5)
+#define SCS_ANDERSON_GRAM_DEFAULT (0)
+#define SCS_ADAPTIVE_MEMORY_DEFAULT (0)
 #define SCS_SC_INIT_DEFAULT (0)
 #define SCS_BROYDEN_ISCS_SCALE_DEFAULT (1)
 #define SCS_OVERRIDE_STREAMS_DEFAULT (0)
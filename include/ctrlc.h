@@ -55,22 +55,39 @@ extern int utSetInterruptEnabled(int);
 
 #else
 
-/* Use POSIX clocl_gettime() for timing on non-Windows machines */
+/* Use POSIX sigaction for signal handling on non-Windows machines */
 #include <signal.h>
 
 #endif
 
-/* METHODS are the same for both */
-void startInterruptListener(void);
-void endInterruptListener(void);
-int isInterrupted(void);
+#endif /* END IF CTRLC > 0 */
+
+/*
+ * Interrupt listener of a solve. 
+ * 
+ * A listener is started per solve (only if requested) and reports only the 
+ * interrupts received while it is active, so concurrent solves do not clear 
+ * or consume each other's interrupts.
+ */
+typedef struct scs_interrupt_listener {
+    int active; /* whether the listener has been started */
+    int mark; /* number of interrupts received before the listener started */
+    int istate; /* previous interrupt state (MATLAB) */
+} ScsInterruptListener;
+
+#if CTRLC > 0
+
+/* METHODS are the same for all platforms */
+void startInterruptListener(ScsInterruptListener *listener, int enabled);
+void endInterruptListener(ScsInterruptListener *listener);
+int isInterrupted(const ScsInterruptListener *listener);
 
 #else /* CTRLC = 0 */
 
 /* No signal handling. */
-#define startInterruptListener()
-#define endInterruptListener()
-#define isInterrupted() 0
+#define startInterruptListener(listener, enabled) ((listener)->active = 0)
+#define endInterruptListener(listener) ((listener)->active = 0)
+#define isInterrupted(listener) 0
 
 #endif /* END IF CTRLC > 0 */
 
@@ -63,6 +63,18 @@ extern "C" {
      */
     scs_int scs_reset_direction_cache(ScsDirectionCache * cache);
 
+    /**
+     * Initializes the active memory of the cache, which is equal to its 
+     * (allocated) memory unless the memory is adaptive, in which case it 
+     * starts from half of it. The cached pairs are not discarded.
+     * 
+     * @param cache the cache
+     * @param adaptive whether the memory is adaptive 
+     * 
+     * @see ScsSettings#adaptive_memory
+     */
+    void scs_reset_adaptive_memory(ScsDirectionCache * cache, scs_int adaptive);
+
     /**
      * Restarted Broyden (as it is reported in the paper).
      * 
@@ -86,27 +98,39 @@ extern "C" {
     scs_int scs_compute_dir_anderson(ScsWork *work);
 
     /**
-     * Full Broyden method.
+     * Anderson's acceleration using the normal equations: the Gram matrix 
+     * \f$Y^{\top}Y\f$ is updated with one new row and column per call and 
+     * the regularized normal equations are solved by Cholesky. If the Gram 
+     * matrix is ill-conditioned, a QR factorization of \f$Y\f$ is used instead.
      * 
-     * @param work
-     * @param i
+     * @param work Work structure with all available information about the current
+     * iteration (current FPR, values of \f$s_k\f$, \f$y_k\f$ etc).
      * 
      * @return status code of the method.
      * 
-     * @see \ref sec-full-broyden "Full Broyden Algorithm"
-     * 
-     * \warning Not implemented yet
+     * @see ScsSettings#anderson_gram
      */
-    scs_int scs_compute_dir_full_broyden(ScsWork *work, scs_int i);
+    scs_int scs_compute_dir_anderson_gram(ScsWork *work);
 
     /**
-     * Frees memory allocated for the full Broyden method.
+     * Limited-memory full Broyden method with Powell's safeguard, using the 
+     * compact representation of the inverse Jacobian estimate. Unlike the 
+     * restarted Broyden method, the oldest pair is discarded when the memory
+     * is full.
+     * 
+     * @param work Work structure with all available information about the current
+     * iteration (current FPR, values of \f$s_k\f$, \f$y_k\f$ etc).
+     * 
+     * @return status code of the method.
+     * 
+     * @see \ref sec-full-broyden "Full Broyden Algorithm"
      */
-    void scs_free_full_broyden(void);
+    scs_int scs_compute_dir_full_broyden(ScsWork *work);
 
     /**
      * Computes a direction according to the value of 
-     * <code>work->stgs->direction</code>.
+     * <code>work->stgs->direction</code>. If ScsSettings#adaptive_memory is 
+     * set, the active memory of the cache is updated afterwards.
      * 
      * @param work workspace structure
      * @param i iteration count
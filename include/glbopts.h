@@ -114,6 +114,20 @@ extern "C" {
 #endif
 #endif
 
+    /**
+     * \brief Type of the vectors stored in the direction cache
+     * 
+     * If \c CACHE_FLOAT is defined, the vectors \f$s_i\f$, \f$u_i\f$
+     * (or \f$y_i\f$) and \f$s_i-y_i\f$ in ::ScsDirectionCache are stored in 
+     * single precision, which halves the memory they occupy, while all 
+     * computations are carried out in ::scs_float.
+     */
+#ifdef CACHE_FLOAT
+    typedef float scs_cache_float;
+#else
+    typedef scs_float scs_cache_float;
+#endif
+
 #define SCS_NULL 0
 
 #ifndef MAX
@@ -198,6 +212,18 @@ extern "C" {
      * A finite-memory cache where \f$(Y, U)\f$ are stored.
      */
     typedef struct scs_direction_cache ScsDirectionCache;
+    /**
+     * \brief Chordal decomposition of the positive semidefinite cones.
+     */
+    typedef struct scs_chordal ScsChordal;
+    /**
+     * \brief Canonical reordering of the cones of a problem.
+     */
+    typedef struct scs_presolve ScsPresolve;
+    /**
+     * \brief Asynchronous convergence monitor of SuperSCS.
+     */
+    typedef struct scs_monitor ScsMonitor;
 
     /**
      * \brief Direction computation method (in SuperSCS)
@@ -219,7 +245,7 @@ extern "C" {
          */
         fixed_point_residual = 200,
         /**
-         * Full Broyden method
+         * Full Broyden method (limited-memory, without restarts)
          */
         full_broyden = 300
     }
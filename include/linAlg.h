@@ -35,6 +35,24 @@ extern "C" {
 #include "scs.h"
 #include <math.h>
 
+#ifndef SCS_PARALLEL_VECTOR_THRESHOLD
+    /**
+     * Vectors of at least this length are processed in parallel (if compiled
+     * with OpenMP) by ::scs_inner_product, ::scs_norm_squared,
+     * ::scs_add_scaled_array, ::scs_axpy and ::scs_subtract_array.
+     */
+#define SCS_PARALLEL_VECTOR_THRESHOLD 100000
+#endif
+
+#ifndef SCS_PARALLEL_VECTOR_BLOCKS
+    /**
+     * Number of blocks in which long vectors are split. The partition does not
+     * depend on the number of threads and partial sums are added in a fixed
+     * order, so reductions are reproducible.
+     */
+#define SCS_PARALLEL_VECTOR_BLOCKS 64
+#endif
+
     /**
      * \brief Computes the optimal workspace size for ::scs_svdls
      * 
@@ -309,6 +327,75 @@ extern "C" {
             const scs_float * RESTRICT a,
             const scs_float * RESTRICT b,
             scs_int l);
+
+    /**
+     * Computes \f$x \leftarrow u + \beta v\f$ and 
+     * \f$y \leftarrow w + \beta z\f$ in a single pass.
+     * 
+     * @param x vector <code>x</code>
+     * @param u vector <code>u</code>
+     * @param v vector <code>v</code>
+     * @param y vector <code>y</code>
+     * @param w vector <code>w</code>
+     * @param z vector <code>z</code>
+     * @param beta the scalar \f$\beta\f$
+     * @param l length of the vectors
+     */
+    void scs_axpy2(
+            scs_float * RESTRICT x,
+            const scs_float * RESTRICT u,
+            const scs_float * RESTRICT v,
+            scs_float * RESTRICT y,
+            const scs_float * RESTRICT w,
+            const scs_float * RESTRICT z,
+            scs_float beta,
+            scs_int l);
+
+    /**
+     * Computes \f$x \leftarrow a - b\f$ and returns the weighted squared norm
+     * \f$\rho \|x_{1:n}\|^2 + \|x_{n+1:l}\|^2\f$ in a single pass.
+     * 
+     * @param x vector <code>x</code>
+     * @param a vector <code>a</code>
+     * @param b vector <code>b</code>
+     * @param rho weight \f$\rho\f$ of the first \c n entries
+     * @param n number of weighted entries
+     * @param l length of the vectors
+     * @return weighted squared norm of <code>x</code>
+     */
+    scs_float scs_difference_weighted_norm_squared(
+            scs_float * RESTRICT x,
+            const scs_float * RESTRICT a,
+            const scs_float * RESTRICT b,
+            scs_float rho,
+            scs_int n,
+            scs_int l);
+
+    /**
+     * Computes \f$x \leftarrow D(a - b)\f$ and \f$y \leftarrow D(c - d)\f$
+     * in a single pass, where \f$D\f$ is the diagonal matrix whose first 
+     * \c n entries are \f$\gamma\f$ and the rest are equal to \c 1.
+     * 
+     * @param x vector <code>x</code>
+     * @param a vector <code>a</code>
+     * @param b vector <code>b</code>
+     * @param y vector <code>y</code>
+     * @param c vector <code>c</code>
+     * @param d vector <code>d</code>
+     * @param gamma scaling \f$\gamma\f$ of the first \c n entries
+     * @param n number of scaled entries
+     * @param l length of the vectors
+     */
+    void scs_scaled_difference2(
+            scs_float * RESTRICT x,
+            const scs_float * RESTRICT a,
+            const scs_float * RESTRICT b,
+            scs_float * RESTRICT y,
+            const scs_float * RESTRICT c,
+            const scs_float * RESTRICT d,
+            scs_float gamma,
+            scs_int n,
+            scs_int l);
     
     
 
@@ -62,13 +62,19 @@ extern "C" {
 
     /** 
      * initialize scs_linsys_priv_workspace structure and perform any necessary preprocessing 
+     * 
+     * @param A sparse matrix A
+     * @param P upper triangular part of the matrix of the quadratic cost, or 
+     * \c SCS_NULL (the solver may keep a reference to it)
+     * @param stgs user-specified settings
      */
     ScsPrivWorkspace *scs_init_priv(
             const ScsAMatrix *A,
+            const ScsAMatrix *P,
             const ScsSettings *stgs);
 
     /** 
-     * Solves <code>[d->RHO_X * I  A' ; A  -I] x = b</code> for <code>x</code>, 
+     * Solves <code>[d->RHO_X * I + P  A' ; A  -I] x = b</code> for <code>x</code>, 
      * stores result in <code>b</code>, <code>s</code> contains
      * warm-start, <code>iter</code> is current scs iteration count 
      * 
@@ -111,12 +117,40 @@ extern "C" {
             const scs_float *x,
             scs_float *y);
 
+    /**
+     * Performs <code>z += A*x</code> and <code>w += A'*y</code> in a single 
+     * pass over the (host) matrix <code>A</code>.
+     */
+    void scs_accum_by_a_and_a_trans(
+            const ScsAMatrix *A,
+            const scs_float *x,
+            const scs_float *y,
+            scs_float *z,
+            scs_float *w);
+
+    /**
+     * Performs <code>y += P*x</code>, where only the upper triangular part
+     * of the symmetric matrix <code>P</code> is stored.
+     */
+    void scs_accum_by_p(
+            const ScsAMatrix *P,
+            const scs_float *x,
+            scs_float *y);
+
     /** 
      * Returns negative num if input data is invalid 
      */
     scs_int scs_validate_linsys(
             const ScsAMatrix *A);
 
+    /**
+     * Returns negative num if the matrix \c P of the quadratic cost is not a 
+     * valid upper triangular \f$n\times n\f$ matrix.
+     */
+    scs_int scs_validate_quadratic_cost(
+            const ScsAMatrix *P,
+            scs_int n);
+
     /** 
      * Returns string describing method, can return null, if not null free will be
      * called on output 
@@ -157,6 +191,24 @@ extern "C" {
             const ScsSettings *stgs,
             const ScsScaling *scal);
 
+    /**
+     * normalizes the matrix \c P of the quadratic cost consistently with 
+     * \c A, that is <code>Pnew = factor * (E^-1)*P*(E^-1)</code>, where 
+     * \c factor accounts for the scaling of \c b and \c c.
+     */
+    void scs_normalize_p(
+            ScsAMatrix *P,
+            const ScsScaling *scal,
+            scs_float factor);
+
+    /**
+     * unnormalizes \c P, undoing ::scs_normalize_p.
+     */
+    void scs_unnormalize_p(
+            ScsAMatrix *P,
+            const ScsScaling *scal,
+            scs_float factor);
+
     /** 
      * Frees the memory allocated in ScsAMatrix.
      */
@@ -41,18 +41,46 @@ void scs_normalize_bc(ScsWork *w) {
     for (i = 0; i < w->m; ++i) {
         b[i] /= D[i];
     }
-    nm = scs_norm(b, w->m);
-    w->sc_b = w->scal->meanNormColA / MAX(nm, MIN_SCALE);
+    /* with a quadratic cost, sc_b and sc_c are fixed by scs_normalize_quadratic_cost */
+    if (w->P == SCS_NULL) {
+        nm = scs_norm(b, w->m);
+        w->sc_b = w->scal->meanNormColA / MAX(nm, MIN_SCALE);
+    }
     /* scale c */
     for (i = 0; i < w->n; ++i) {
         c[i] /= E[i];
     }
-    nm = scs_norm(c, w->n);
-    w->sc_c = w->scal->meanNormRowA / MAX(nm, MIN_SCALE);
+    if (w->P == SCS_NULL) {
+        nm = scs_norm(c, w->n);
+        w->sc_c = w->scal->meanNormRowA / MAX(nm, MIN_SCALE);
+    }
     scs_scale_array(b, w->sc_b * w->stgs->scale, w->m);
     scs_scale_array(c, w->sc_c * w->stgs->scale, w->n);
 }
 
+/* 
+ * The normalized P is scale * sc_c / sc_b * (E^-1)*P*(E^-1), so it is 
+ * factorized together with A only if sc_b and sc_c do not change; they are 
+ * computed here from the data passed to scs_init and kept for all solves.
+ */
+void scs_normalize_quadratic_cost(ScsWork *w, const ScsData *data) {
+    scs_int i;
+    scs_float nm, tmp, *D = w->scal->D, *E = w->scal->E;
+    nm = 0;
+    for (i = 0; i < w->m; ++i) {
+        tmp = data->b[i] / D[i];
+        nm += tmp * tmp;
+    }
+    w->sc_b = w->scal->meanNormColA / MAX(SQRTF(nm), MIN_SCALE);
+    nm = 0;
+    for (i = 0; i < w->n; ++i) {
+        tmp = data->c[i] / E[i];
+        nm += tmp * tmp;
+    }
+    w->sc_c = w->scal->meanNormRowA / MAX(SQRTF(nm), MIN_SCALE);
+    scs_normalize_p(w->P, w->scal, w->stgs->scale * w->sc_c / w->sc_b);
+}
+
 /* TENTATIVELY REMOVE THIS FUNCTION 
 void scs_calculate_scaled_residuals(ScsWork *w, struct scs_residuals *r) {
     scs_float *D = w->scal->D;
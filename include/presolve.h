@@ -0,0 +1,114 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 Pantelis Sopasakis (https://alphaville.github.io),
+ *                    Krina Menounou (https://www.linkedin.com/in/krinamenounou), 
+ *                    Panagiotis Patrinos (http://homes.esat.kuleuven.be/~ppatrino)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * 
+ */
+#ifndef SCS_PRESOLVE_H
+#define SCS_PRESOLVE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "scs.h"
+
+    /**
+     * \brief Canonical reordering of the cones of a problem.
+     *
+     * Second-order cones of dimension 1 and \f$1\times 1\f$ PSD cones are
+     * nonnegative orthants, so they are folded into the LP block, cones of
+     * dimension 0 are dropped and the remaining second-order cones are sorted
+     * by dimension. The rows of \f$A\f$ and \f$b\f$ are permuted accordingly;
+     * the dimensions of the problem do not change.
+     */
+    struct scs_presolve {
+        scs_int m; /**< \brief number of rows of the problem */
+        scs_int n; /**< \brief number of columns of the problem */
+        ScsData *data; /**< \brief presolved problem data (settings and \f$P\f$ are shared with the original) */
+        ScsCone *cone; /**< \brief canonical cone */
+        ScsSolution *sol; /**< \brief solution of the presolved problem */
+        scs_int *row_perm; /**< \brief row \c i of the presolved problem is row <code>row_perm[i]</code> of the original one */
+    };
+
+    /**
+     * Computes the canonical form of the cone of a given problem.
+     *
+     * @param data problem data
+     * @param cone problem cone
+     *
+     * @return the presolved problem, or \c SCS_NULL if the cone is already in
+     * canonical form (or if memory could not be allocated).
+     */
+    ScsPresolve *scs_presolve_init(
+            const ScsData * RESTRICT data,
+            const ScsCone * RESTRICT cone);
+
+    /**
+     * Copies the vectors \f$b\f$ and \f$c\f$ of the original problem into the
+     * presolved one.
+     *
+     * @param presolve presolved problem
+     * @param data original problem data
+     */
+    void scs_presolve_update_data(
+            ScsPresolve * RESTRICT presolve,
+            const ScsData * RESTRICT data);
+
+    /**
+     * Maps a solution of the original problem to a solution of the presolved
+     * one (e.g., to warm start the solver).
+     *
+     * @param presolve presolved problem
+     * @param sol solution of the original problem
+     */
+    void scs_presolve_lift_solution(
+            ScsPresolve * RESTRICT presolve,
+            const ScsSolution * RESTRICT sol);
+
+    /**
+     * Maps the solution of the presolved problem, \c presolve->sol, back to
+     * the original problem.
+     *
+     * @param presolve presolved problem
+     * @param sol solution of the original problem (arrays are allocated if
+     * they are \c SCS_NULL)
+     *
+     * @return status code (\c 0 on success)
+     */
+    scs_int scs_presolve_recover_solution(
+            const ScsPresolve * RESTRICT presolve,
+            ScsSolution * RESTRICT sol);
+
+    /**
+     * Frees the memory allocated for a presolved problem.
+     *
+     * @param presolve presolved problem
+     */
+    void scs_presolve_free(ScsPresolve * RESTRICT presolve);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SCS_PRESOLVE_H */
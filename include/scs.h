@@ -58,15 +58,23 @@ extern "C" {
      * 
      */
     struct scs_direction_cache {
-        scs_float *S; /**< \brief cached values of \f$s_i\f$ (s-memory) */
-        scs_float *U; /**< \brief cached values of \f$u_i = \frac{s_i - \tilde{s}_i}{\langle s_i, \tilde{s}_i\rangle}\f$, or cached values of \f$y_i\f$ */
-        scs_float *S_minus_Y; /**< \brief The difference \f$S-Y\f$ (for Anderson's acceleration) */
+        scs_cache_float *S; /**< \brief cached values of \f$s_i\f$ (s-memory) */
+        scs_cache_float *U; /**< \brief cached values of \f$u_i = \frac{s_i - \tilde{s}_i}{\langle s_i, \tilde{s}_i\rangle}\f$ (for the full Broyden method and Anderson's acceleration with ScsSettings#anderson_gram, the cached \f$y_i\f$) */
+        scs_cache_float *S_minus_Y; /**< \brief The difference \f$S-Y\f$ (for Anderson's acceleration) */
         scs_float *t; /**< \brief Solution of the linear system \f$Yt = R(x)\f$ */
-        scs_int ls_wspace_length; /**< \brief Length of workspace used to solve Anderson's linear system */
-        scs_float * ls_wspace; /**< \brief Workspace used to solve Anderson's linear system */
+        scs_float *Q; /**< \brief Orthonormal factor of the thin QR factorization of \f$Y\f$, oldest column first (for Anderson's acceleration) */
+        scs_float *R; /**< \brief Upper triangular factor of the thin QR factorization of \f$Y\f$ (column-packed, leading dimension \c mem) */
+        scs_float *G; /**< \brief Gram matrix \f$Y^{\top}Y\f$, indexed by the positions of the columns of \f$Y\f$ in the buffer (for ScsSettings#anderson_gram), or \f$S^{\top}S\f$ (for the full Broyden method) */
+        scs_float *StU; /**< \brief Inner products \f$\langle s_i, u_j\rangle\f$ for \f$j<i\f$ (strictly lower triangular, leading dimension \c mem; for the restarted Broyden method), or \f$S^{\top}Y\f$ indexed by buffer positions (for the full Broyden method) */
+        scs_float *ws; /**< \brief workspace of length \f$l\f$ (for the Broyden methods) */
         scs_int mem_cursor; /**< \brief current memory cursor [0..mem-1] */
         scs_int mem; /**< \brief (target/maximum/allocated) memory */
         scs_int current_mem; /**< \brief current memory length */
+        scs_int mem_active; /**< \brief active memory: maximum number of pairs used [1..mem] (see ScsSettings#adaptive_memory) */
+        scs_int stall_count; /**< \brief number of consecutive directions without a sufficient decrease of the FPR */
+        scs_float cond; /**< \brief estimated condition number of the system solved at the last direction update */
+        scs_float nrmR_prev; /**< \brief norm of the FPR when the previous direction was computed */
+        scs_float h0; /**< \brief initial inverse Jacobian estimate \f$H_0 = h_0 I\f$ (for the full Broyden method) */
     };
 
     /**
@@ -99,6 +107,11 @@ extern "C" {
         scs_float *RESTRICT u_t;
         /**
          * \brief Vector \f$u_{k-1}\f$ of the previous iteration.
+         * 
+         * In SuperSCS, #u and #u_prev (likewise, #R and #R_prev) are swapped 
+         * by pointer at every iteration and, after a K1 step, #u, #u_t, #u_b 
+         * and #R are swapped with #wu, #wu_t, #wu_b and #Rwu; these pointers 
+         * must not be cached across iterations.
          */
         scs_float *RESTRICT u_prev;
         /**
@@ -127,7 +140,7 @@ extern "C" {
          * \brief Dual residual vector
          * 
          * \f[
-         *  \text{dr} = A'y + c \tau,
+         *  \text{dr} = Px + A'y + c \tau,
          * \f]
          * and in SuperSCS, \f$y\f$ is \f$\bar{y}\f$ and \f$\tau\f$ is \f$\bar{\tau}\f$.
          */
@@ -152,12 +165,6 @@ extern "C" {
          * \brief Direction \f$d_k\f$
          */
         scs_float *RESTRICT dir;
-        /**
-         * \brief Hessian approximation used by the full Broyden method.
-         * 
-         * @see ::full_broyden
-         */
-        scs_float *RESTRICT H;
         /** 
          * \brief Direction corresponding to \f$\tilde{u}\f$.
          */
@@ -178,6 +185,58 @@ extern "C" {
          * \brief Vector \f$R(w_u)\f$ from line search.
          */
         scs_float *RESTRICT Rwu;
+        /**
+         * \brief Number of step sizes evaluated at once in the line search.
+         * 
+         * \sa ScsSettings#ls_parallel
+         */
+        scs_int ls_slots;
+        /**
+         * \brief Vectors \f$w_u\f$, \f$\tilde{w}_u\f$, \f$\bar{w}_u\f$ and 
+         * \f$R(w_u)\f$ (in this order) of the additional step sizes of the 
+         * line search; the first step size uses #wu, #wu_t, #wu_b and #Rwu.
+         */
+        scs_float *RESTRICT *ls_points;
+        /**
+         * \brief Cone workspaces of the additional step sizes of the line search.
+         */
+        ScsConeWork **ls_cone_work;
+        /**
+         * \brief Norms of the FPR at the step sizes of the line search.
+         */
+        scs_float *ls_nrmR;
+        /**
+         * \brief Warm-start state of the cone projections at the beginning 
+         * of the line search, from which all trial points are projected.
+         */
+        scs_float *ls_warm_start;
+        /**
+         * \brief Convergence monitor (allocated on first use).
+         * 
+         * \sa ScsSettings#async_monitor
+         */
+        ScsMonitor *monitor;
+        /**
+         * \brief Interrupt (ctrl-c) listener of the current solve.
+         * 
+         * \sa ScsSettings#handle_interrupts
+         */
+        ScsInterruptListener interrupt;
+        /**
+         * \brief Iteration at which the residuals are checked next.
+         * 
+         * \sa ScsSettings#max_check_interval
+         */
+        scs_int next_check;
+        /**
+         * \brief Iteration of the last convergence check (\c -1 if none).
+         */
+        scs_int last_check;
+        /**
+         * \brief Distance from convergence (relative to the tolerance) at the 
+         * last convergence check.
+         */
+        scs_float last_check_ratio;
         /** 
          * \brief \f$\|Ru_k\|\f$. 
          */
@@ -202,6 +261,11 @@ extern "C" {
          * \brief Auxiliary variable.
          */
         scs_float gTh;
+        /**
+         * \brief Auxiliary variable \f$g_x'Pg_x\f$ (used only with a quadratic
+         * cost).
+         */
+        scs_float gTPg;
         /**
          * \brief Scaling factor corresponding to \f$b\f$
          */
@@ -218,6 +282,18 @@ extern "C" {
          * \brief Norm of \f$c\f$
          */
         scs_float nm_c;
+        /**
+         * \brief Norm of \f$Db\f$ (of \f$b\f$ if there is no normalization), 
+         * where \f$b\f$ is the normalized vector (used in the certificates of
+         * infeasibility)
+         */
+        scs_float nm_Db;
+        /**
+         * \brief Norm of \f$Ec\f$ (of \f$c\f$ if there is no normalization), 
+         * where \f$c\f$ is the normalized vector (used in the certificates of
+         * unboundedness)
+         */
+        scs_float nm_Ec;
         /** 
          * \brief Variable for certificates of infeasibility/unboudedness 
          */
@@ -226,6 +302,16 @@ extern "C" {
          *  \brief The (possibly normalized) \c A matrix 
          */
         ScsAMatrix * A;
+        /**
+         *  \brief The (possibly normalized) \c P matrix of the quadratic cost 
+         * (or \c SCS_NULL)
+         */
+        ScsAMatrix * P;
+        /**
+         * \brief Workspace for products with \f$P\f$ (used only with a 
+         * quadratic cost).
+         */
+        scs_float *RESTRICT Px;
         /** 
          * \brief struct populated by linear system solver 
          */
@@ -246,6 +332,20 @@ extern "C" {
          * \brief A cache for the computation of Broyden or Anderson's acceleration.
          */
         ScsDirectionCache *RESTRICT direction_cache;
+        /**
+         * \brief Chordal decomposition of the PSD cones (or \c SCS_NULL if the
+         * problem is solved as given).
+         * 
+         * \sa \ref ScsSettings#chordal_decomposition "chordal_decomposition"
+         */
+        ScsChordal *RESTRICT chordal;
+        /**
+         * \brief Canonical reordering of the cones (or \c SCS_NULL if the cone
+         * is already in canonical form or the presolve is deactivated).
+         * 
+         * \sa \ref ScsSettings#presolve_cones "presolve_cones"
+         */
+        ScsPresolve *RESTRICT presolve;
     };
 
     /**
@@ -266,6 +366,14 @@ extern "C" {
          * linsys solver 
          */
         ScsAMatrix *A;
+        /**
+         * Optional sparse positive semidefinite matrix \f$P\f$ of the 
+         * quadratic cost \f$\tfrac{1}{2}x'Px + c'x\f$.
+         * 
+         * Only the upper triangular part of \f$P\f$ is given (in the same 
+         * format as \c A). Leave it to \c SCS_NULL if the cost is linear.
+         */
+        ScsAMatrix *P;
         /* these can change for multiple runs for the same call to scs_init */
 
         /* dense arrays for b (size m), c (size n) */
@@ -317,6 +425,37 @@ extern "C" {
          * Default: ::SCS_RHO_X_DEFAULT 1e-3 
          */
         scs_float rho_x; 
+        /**
+         * Boolean; whether to decompose the sparse positive semidefinite cones
+         * into smaller ones by means of a chordal extension of their aggregate
+         * sparsity pattern.
+         * 
+         * The decomposition is computed in ::scs_init and the solution of the
+         * decomposed problem is mapped back to the original problem. Entries
+         * of \f$b\f$ outside the sparsity pattern of a decomposed cone must 
+         * remain zero in subsequent calls to \c scs_solve, which otherwise 
+         * fails.
+         * 
+         * The sparsity pattern and the cliques are stored as lists, so the 
+         * memory needed by the analysis grows with the number of nonzeros
+         * of the chordal extension rather than with the square of the
+         * dimension of the cone.
+         * 
+         * Default: ::SCS_CHORDAL_DECOMPOSITION_DEFAULT 0
+         */
+        scs_int chordal_decomposition;
+        /**
+         * Boolean; whether to bring the cone into a canonical form before 
+         * solving the problem: second-order cones of dimension 1 and 
+         * \f$1\times 1\f$ PSD cones are folded into the LP block, empty cones 
+         * are dropped and the second-order cones are sorted by dimension.
+         * 
+         * The rows of \f$A\f$ and \f$b\f$ are permuted in ::scs_init and the
+         * permutation is undone when the solution is returned.
+         * 
+         * Default: ::SCS_PRESOLVE_CONES_DEFAULT 1
+         */
+        scs_int presolve_cones;
 
 
         /* -------------------------------------
@@ -346,6 +485,58 @@ extern "C" {
          * Used to avoid memory leaks when recording the progress of the algorithm.
          */
         scs_int previous_max_iters;
+        /**
+         * Maximum number of iterations between two convergence checks.
+         * 
+         * If this is larger than \c 1, the convergence checks (which cost
+         * two matrix-vector products with \f$A\f$) become adaptive: the 
+         * next check is scheduled at half the number of iterations after 
+         * which the residuals are predicted to cross #eps, extrapolating 
+         * from their rate of decrease between the last two checks, but no 
+         * later than \c max_check_interval iterations later. Convergence
+         * is therefore detected at most <code>max_check_interval - 1</code> 
+         * iterations late. The progress data (see #do_record_progress) are 
+         * recorded at the convergence checks, so they are then recorded at 
+         * non-uniform intervals (see ScsInfo#progress_iter).
+         * 
+         * Default: ::SCS_MAX_CHECK_INTERVAL_DEFAULT 1 (check at every iteration)
+         */
+        scs_int max_check_interval;
+        /**
+         * Whether the convergence checks of SuperSCS are carried out 
+         * asynchronously.
+         * 
+         * If set, whenever a convergence check is due (see 
+         * #max_check_interval), SuperSCS copies \f$(\bar{u}, \bar{s}, 
+         * \bar{\kappa})\f$ into a snapshot which is evaluated (residuals, 
+         * termination criteria and progress data) by a helper thread 
+         * while the iterations continue; a new snapshot is taken once the 
+         * previous one has been evaluated. When the helper thread certifies
+         * a snapshot, the solver stops and reports exactly that snapshot 
+         * (and its iteration), so convergence is detected a few iterations 
+         * late, but the reported solution satisfies the termination criteria.
+         * 
+         * On platforms without POSIX threads, the snapshots are evaluated 
+         * synchronously. This setting does not affect SCS 
+         * (ScsSettings#do_super_scs = 0).
+         * 
+         * Default: ::SCS_ASYNC_MONITOR_DEFAULT 0
+         */
+        scs_int async_monitor;
+        /**
+         * Whether the solver listens for interrupts (ctrl-c) during this 
+         * solve. If set, an interrupted solve stops with status 
+         * #SCS_SIGINT. The signal handler is process-wide; it is installed
+         * while at least one solve listens for interrupts and all such 
+         * solves are interrupted. If not set, the solver does not touch the
+         * signal handlers of the process, so that several solves can run 
+         * concurrently in the same process.
+         * 
+         * This setting has no effect unless compiled with \c CTRLC=1.
+         * 
+         * Default: ::SCS_HANDLE_INTERRUPTS_DEFAULT 0
+         */
+        scs_int handle_interrupts;
         /** 
          * Convergence tolerance.
          * 
@@ -365,6 +556,18 @@ extern "C" {
          *  
          */
         scs_float cg_rate;
+        /**
+         * Boolean; whether the iterative cone projections (exponential, 
+         * power and positive semidefinite cones) are computed inexactly, 
+         * with a tolerance that goes down like <code>(1/iter)^2</code>
+         * and is never larger than <code>1e-2</code>.
+         * 
+         * The projection errors are then summable, so convergence is
+         * preserved, while early iterations become cheaper.
+         * 
+         * Default: ::SCS_INEXACT_CONE_PROJECTIONS_DEFAULT 0
+         */
+        scs_int inexact_cone_projections;
         /** 
          * Level of verbosity.
          * 
@@ -429,6 +632,27 @@ extern "C" {
          * max line-search iterations 
          */
         scs_int ls;
+        /**
+         * Number of step sizes of the line search which are evaluated at once.
+         * 
+         * The trial points of the line search are affine in the step size, so
+         * the step sizes \f$\beta^{j}, \ldots, \beta^{j+p-1}\f$ can be 
+         * evaluated (projected onto the cone) concurrently, on separate 
+         * threads if SuperSCS is compiled with OpenMP; the first one which 
+         * is accepted (K1 before K2, in the order of the step sizes) is then
+         * used. Each additional step size needs four vectors of length 
+         * \f$l\f$ and its own cone workspace. The value \c 1 corresponds to 
+         * the standard (sequential) line search.
+         * 
+         * The projections of all trial points are warm-started from the 
+         * state at the beginning of the line search, so the iterates do not
+         * depend on this setting.
+         * 
+         * Default: ::SCS_LS_PARALLEL_DEFAULT 1
+         * 
+         * \sa #ls
+         */
+        scs_int ls_parallel;
         /**
          * Step size reduction coefficient. 
          * 
@@ -470,6 +694,32 @@ extern "C" {
          * \sa #direction 
          */
         scs_int memory;
+        /**
+         * Boolean; whether Anderson's acceleration solves its least squares
+         * problem using the (regularized) normal equations, whose Gram matrix
+         * \f$Y^{\top}Y\f$ is updated incrementally and factorized by Cholesky.
+         * When the Gram matrix is ill-conditioned, the QR factorization of
+         * \f$Y\f$ is used instead.
+         * 
+         * Default: ::SCS_ANDERSON_GRAM_DEFAULT 0
+         * 
+         * \sa #direction
+         */
+        scs_int anderson_gram;
+        /**
+         * Boolean; whether the memory length of the quasi-Newton directions 
+         * is adapted during the iterations. The number of cached pairs that
+         * are used grows (up to #memory) while the fixed-point residual 
+         * decreases slowly and shrinks when the system solved by the 
+         * direction becomes ill-conditioned; the memory is restarted if the 
+         * fixed-point residual stagnates.
+         * 
+         * Default: ::SCS_ADAPTIVE_MEMORY_DEFAULT 0
+         * 
+         * \sa #memory
+         * \sa ScsInfo#progress_mem
+         */
+        scs_int adaptive_memory;
         /**
          * Option for the Broyden direction.
          * 
@@ -552,6 +802,22 @@ extern "C" {
         scs_float setupTime; /**< \brief time taken for setup phase (milliseconds) */
         scs_float solveTime; /**< \brief time taken for solve phase (milliseconds) */
         scs_float linsys_total_solve_time_ms; /**< \brief total linsys (e.g., CG) solve time in ms */
+        scs_float cone_time_ms; /**< \brief total time spent on cone projections (milliseconds) */
+        scs_float cone_lp_time_ms; /**< \brief time spent projecting onto the positive orthant (ms) */
+        scs_float cone_box_time_ms; /**< \brief time spent projecting onto the box cone (ms) */
+        scs_float cone_soc_time_ms; /**< \brief time spent projecting onto second-order cones, rotated ones included (ms) */
+        scs_float cone_psd_time_ms; /**< \brief time spent projecting onto PSD cones (ms) */
+        scs_float cone_exp_time_ms; /**< \brief time spent projecting onto exponential cones (ms) */
+        scs_float cone_pow_time_ms; /**< \brief time spent projecting onto power cones (ms) */
+        scs_int cone_lp_projections; /**< \brief number of projections onto the positive orthant */
+        scs_int cone_box_projections; /**< \brief number of projections onto the box cone */
+        scs_int cone_soc_projections; /**< \brief number of projections onto second-order cones, rotated ones included */
+        scs_int cone_psd_projections; /**< \brief number of projections onto PSD cones */
+        scs_int cone_exp_projections; /**< \brief number of projections onto exponential cones */
+        scs_int cone_pow_projections; /**< \brief number of projections onto power cones */
+        scs_int cone_psd_eigenpairs; /**< \brief number of eigenpairs computed in PSD projections */
+        scs_float cone_exp_avg_iters; /**< \brief average number of iterations per iterative exp cone projection */
+        scs_float cone_pow_avg_iters; /**< \brief average number of Newton iterations per iterative power cone projection */
         scs_float *RESTRICT progress_relgap; /**< \brief relative gap history */
         scs_float *RESTRICT progress_respri; /**< \brief primal residual history */
         scs_float *RESTRICT progress_resdual; /**< \brief dual residual history */
@@ -562,6 +828,7 @@ extern "C" {
         scs_int *RESTRICT progress_iter; /**< \brief iterations when residulas are recorded */
         scs_int *RESTRICT progress_mode; /**< \brief Mode of SuperSCS at each iteration */
         scs_int *RESTRICT progress_ls; /**< \brief Number of line search iterations */
+        scs_int *RESTRICT progress_mem; /**< \brief Active memory of the direction at each iteration */
         unsigned long long allocated_memory; /**< \brief Memory, in bytes, that was allocated to run the algorithm */
     };
 
@@ -66,6 +66,18 @@ extern "C" {
 #define TEST_FAIL_FLAG "\x1B[31m<FAIL>\x1B[39m " /**< flag for FAIL */   
 #define TEST_MESSAGE_BUFF_SIZE 500
 #define TEST_ERROR_MESSAGE_SIZE 100
+
+    /**
+     * Tolerance for comparisons which involve the vectors of the direction
+     * cache; when CACHE_FLOAT is defined these are stored in single precision
+     * and the tolerance is raised to #CACHE_FLOAT_TOL.
+     */
+#ifdef CACHE_FLOAT
+#define CACHE_FLOAT_TOL 1e-5
+#define CACHE_TOL(tol) ((tol) > CACHE_FLOAT_TOL ? (tol) : CACHE_FLOAT_TOL)
+#else
+#define CACHE_TOL(tol) (tol)
+#endif
     /**
      * Fails with a given message.
      */
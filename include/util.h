@@ -130,6 +130,53 @@ extern "C" {
      */
     scs_float scs_toc_quiet(ScsTimer *timer);
 
+    /**
+     * \brief Low-overhead deadline based on a running timer
+     * 
+     * The clock is read only once every #stride calls of 
+     * #scs_deadline_passed; the stride is calibrated at every reading so 
+     * that the clock is read about every ::SCS_DEADLINE_READ_INTERVAL 
+     * milliseconds (and at least twice before the deadline).
+     */
+    typedef struct scs_deadline {
+        ScsTimer *timer; /**< \brief running timer */
+        scs_float budget; /**< \brief deadline (in ms since the timer was started) */
+        scs_float last; /**< \brief time of the last reading of the clock (in ms) */
+        scs_int stride; /**< \brief number of calls between two readings of the clock */
+        scs_int countdown; /**< \brief calls left until the next reading */
+    } ScsDeadline;
+
+    /**
+     * \brief Target time between two readings of the clock by 
+     * #scs_deadline_passed (in milliseconds).
+     */
+#define SCS_DEADLINE_READ_INTERVAL (0.1)
+    /**
+     * \brief Maximum number of calls of #scs_deadline_passed between two 
+     * readings of the clock.
+     */
+#define SCS_DEADLINE_MAX_STRIDE (1000)
+
+    /**
+     * \brief Starts a deadline
+     * 
+     * @param deadline deadline structure
+     * @param timer a timer which has been started with #scs_tic
+     * @param budget time budget in milliseconds (since the timer was started)
+     */
+    void scs_deadline_start(ScsDeadline *deadline, ScsTimer *timer, scs_float budget);
+
+    /**
+     * \brief Checks whether the time budget of a deadline has been exceeded
+     * 
+     * This is meant to be called once per iteration; the clock is read only
+     * every few calls.
+     * 
+     * @param deadline deadline structure
+     * @return \c 1 if the budget has been exceeded, \c 0 otherwise
+     */
+    scs_int scs_deadline_passed(ScsDeadline *deadline);
+
     /**
      * \brief Prints the content of a Cone object
      * @param cone pointer to cone
@@ -166,11 +213,17 @@ extern "C" {
      * <tr><td>\ref ScsSettings#normalize "normalize"<td>1<td>::SCS_NORMALIZE_DEFAULT
      * <tr><td>\ref ScsSettings#scale "scale"<td>1.0<td>::SCS_SCALE_DEFAULT
      * <tr><td>\ref ScsSettings#rho_x "rho_x"<td>0.001<td>::SCS_RHO_X_DEFAULT
+     * <tr><td>\ref ScsSettings#chordal_decomposition "chordal_decomposition"<td>0<td>::SCS_CHORDAL_DECOMPOSITION_DEFAULT
+     * <tr><td>\ref ScsSettings#presolve_cones "presolve_cones"<td>1<td>::SCS_PRESOLVE_CONES_DEFAULT
      * <tr><td>\ref ScsSettings#max_iters "max_iters"<td>10000<td>::SCS_MAX_ITERS_DEFAULT
      * <tr><td>\ref ScsSettings#max_time_milliseconds "max_time_milliseconds"<td>300000<td>::SCS_MAX_TIME_MILLISECONDS
+     * <tr><td>\ref ScsSettings#max_check_interval "max_check_interval"<td>1<td>::SCS_MAX_CHECK_INTERVAL_DEFAULT
+     * <tr><td>\ref ScsSettings#async_monitor "async_monitor"<td>0<td>::SCS_ASYNC_MONITOR_DEFAULT
+     * <tr><td>\ref ScsSettings#handle_interrupts "handle_interrupts"<td>0<td>::SCS_HANDLE_INTERRUPTS_DEFAULT
      * <tr><td>\ref ScsSettings#previous_max_iters "previous_max_iters"<td>-1<td>::SCS_PMAXITER_DEFAULT
      * <tr><td>\ref ScsSettings#eps "eps"<td>1e-3<td>::SCS_EPS_DEFAULT
      * <tr><td>\ref ScsSettings#alpha "alpha"<td>1.5<td>::SCS_ALPHA_DEFAULT
+     * <tr><td>\ref ScsSettings#inexact_cone_projections "inexact_cone_projections"<td>0<td>::SCS_INEXACT_CONE_PROJECTIONS_DEFAULT
      * <tr><td>\ref ScsSettings#verbose "verbose"<td>1<td>::SCS_VERBOSE_DEFAULT
      * <tr><td>\ref ScsSettings#warm_start "warm_start"<td>0<td>::SCS_WARM_START_DEFAULT
      * <tr><td>\ref ScsSettings#do_super_scs "do_super_scs"<td>1<td>::SCS_DO_SUPERSCS_DEFAULT
@@ -181,6 +234,7 @@ extern "C" {
      * <tr><td>\ref ScsSettings#c_bl "c1"<td>0.9999<td>::SCS_C1_DEFAULT
      * <tr><td>\ref ScsSettings#cg_rate "cg_rate"<td>2.0<td>::SCS_CG_RATE_DEFAULT
      * <tr><td>\ref ScsSettings#ls "ls"<td>10<td>::SCS_LS_DEFAULT
+     * <tr><td>\ref ScsSettings#ls_parallel "ls_parallel"<td>1<td>::SCS_LS_PARALLEL_DEFAULT
      * <tr><td>\ref ScsSettings#sse "sse"<td>0.999<td>::SCS_SSE_DEFAULT
      * <tr><td>\ref ScsSettings#beta "beta"<td>0.5<td>::SCS_BETA_DEFAULT
      * <tr><td>\ref ScsSettings#sigma "sigma"<td>0.01<td>::SCS_SIGMA_DEFAULT
@@ -188,6 +242,8 @@ extern "C" {
      *     <td>::SCS_DIRECTION_DEFAULT
      * <tr><td>\ref ScsSettings#thetabar "thetabar"<td>0.1<td>::SCS_THETABAR_DEFAULT
      * <tr><td>\ref ScsSettings#memory "memory"<td>5<td>::SCS_MEMORY_DEFAULT
+     * <tr><td>\ref ScsSettings#anderson_gram "anderson_gram"<td>0<td>::SCS_ANDERSON_GRAM_DEFAULT
+     * <tr><td>\ref ScsSettings#adaptive_memory "adaptive_memory"<td>0<td>::SCS_ADAPTIVE_MEMORY_DEFAULT
      * <tr><td>\ref ScsSettings#broyden_init_scaling "broyden_init_scaling"<td>1<td>::SCS_BROYDEN_ISCS_SCALE_DEFAULT
      * <tr><td>\ref ScsSettings#do_record_progress "do_record_progress"<td>0<td>::SCS_DO_RECORD_PROGRESS_DEFAULT
      * <tr><td>\ref ScsSettings#do_override_streams "do_override_streams"<td>0<td>::SCS_OVERRIDE_STREAMS_DEFAULT
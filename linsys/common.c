@@ -88,6 +88,32 @@ scs_int scs_validate_linsys(const ScsAMatrix *A) {
     return 0;
 }
 
+scs_int scs_validate_quadratic_cost(const ScsAMatrix *P, scs_int n) {
+    scs_int i, j;
+    if (P->x == SCS_NULL || P->i == SCS_NULL || P->p == SCS_NULL) {
+        scs_printf("P incompletely specified\n");
+        return -1;
+    }
+    if (P->m != n || P->n != n) {
+        scs_printf("P must be a square matrix of dimension n = %li\n", (long) n);
+        return -1;
+    }
+    for (j = 0; j < n; ++j) {
+        if (P->p[j] > P->p[j + 1]) {
+            scs_printf("ERROR: P->p (column pointers) decreasing\n");
+            return -1;
+        }
+        for (i = P->p[j]; i < P->p[j + 1]; ++i) {
+            if (P->i[i] < 0 || P->i[i] > j) {
+                scs_printf("P must be upper triangular (entry at row %li, column %li)\n",
+                        (long) P->i[i], (long) j);
+                return -1;
+            }
+        }
+    }
+    return 0;
+}
+
 void scs_free_a_matrix(ScsAMatrix *A) {
     scs_free(A->x);
     scs_free(A->i);
@@ -240,6 +266,68 @@ void scs_unnormalize_a(ScsAMatrix *A, const ScsSettings *stgs, const ScsScaling
     }
 }
 
+void scs_normalize_p(ScsAMatrix *P, const ScsScaling *scal, scs_float factor) {
+    scs_int i, j;
+    const scs_float *E = scal->E;
+    for (j = 0; j < P->n; ++j) {
+        for (i = P->p[j]; i < P->p[j + 1]; ++i) {
+            P->x[i] *= factor / (E[P->i[i]] * E[j]);
+        }
+    }
+}
+
+void scs_unnormalize_p(ScsAMatrix *P, const ScsScaling *scal, scs_float factor) {
+    scs_int i, j;
+    const scs_float *E = scal->E;
+    for (j = 0; j < P->n; ++j) {
+        for (i = P->p[j]; i < P->p[j + 1]; ++i) {
+            P->x[i] *= (E[P->i[i]] * E[j]) / factor;
+        }
+    }
+}
+
+void scs_accum_by_p(const ScsAMatrix *P, const scs_float *x, scs_float *y) {
+    /* y += P*x
+       only the upper triangular part of P is stored, so every off-diagonal 
+       entry contributes to both y[i] and y[j]
+     */
+    scs_int p, i, j;
+    scs_float xj, yj;
+    for (j = 0; j < P->n; j++) {
+        xj = x[j];
+        yj = 0;
+        for (p = P->p[j]; p < P->p[j + 1]; p++) {
+            i = P->i[p];
+            y[i] += P->x[p] * xj;
+            if (i != j) {
+                yj += P->x[p] * x[i];
+            }
+        }
+        y[j] += yj;
+    }
+}
+
+void scs_accum_by_a_and_a_trans(const ScsAMatrix *A, const scs_float *x,
+        const scs_float *y, scs_float *z, scs_float *w) {
+    /* z += A*x and w += A'*y
+       A in column compressed format; both products are computed in a
+       single pass over the entries of A
+     */
+    scs_int p, i, j;
+    scs_float xj, wj, a;
+    for (j = 0; j < A->n; j++) {
+        xj = x[j];
+        wj = 0;
+        for (p = A->p[j]; p < A->p[j + 1]; p++) {
+            i = A->i[p];
+            a = A->x[p];
+            z[i] += a * xj;
+            wj += a * y[i];
+        }
+        w[j] += wj;
+    }
+}
+
 void scs_accum_by_a_trans__(scs_int n, scs_float *Ax, scs_int *Ai, scs_int *Ap,
         const scs_float *x, scs_float *y) {
     /* y += A'*x
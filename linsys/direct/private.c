@@ -46,20 +46,30 @@ void scs_free_priv(ScsPrivWorkspace *p) {
     }
 }
 
-static scs_cs *formKKT(const ScsAMatrix *A, const ScsSettings *s) {
+static scs_cs *formKKT(const ScsAMatrix *A, const ScsAMatrix *P, const ScsSettings *s) {
     /* ONLY UPPER TRIANGULAR PART IS STUFFED
      * forms column compressed KKT matrix
      * assumes column compressed form A matrix
      *
-     * forms upper triangular part of [I A'; A -I]
+     * forms upper triangular part of [rho_x I + P, A'; A -I]
      */
     scs_int j, k, kk;
     scs_cs *K_cs;
-    /* I at top left */
+    /* rho_x I + P at top left */
     const scs_int Anz = A->p[A->n];
-    const scs_int Knzmax = A->n + A->m + Anz;
-    scs_cs *K = scs_cs_spalloc(A->m + A->n, A->m + A->n, Knzmax, 1, 1);
-
+    scs_int Pnz_offdiag = 0;
+    scs_int Knzmax;
+    scs_cs *K;
+
+    if (P != SCS_NULL) {
+        for (j = 0; j < P->n; j++) {
+            for (k = P->p[j]; k < P->p[j + 1]; k++) {
+                if (P->i[k] != j) Pnz_offdiag++;
+            }
+        }
+    }
+    Knzmax = A->n + A->m + Anz + Pnz_offdiag;
+    K = scs_cs_spalloc(A->m + A->n, A->m + A->n, Knzmax, 1, 1);
     if (!K) {
         return SCS_NULL;
     }
@@ -70,6 +80,21 @@ static scs_cs *formKKT(const ScsAMatrix *A, const ScsSettings *s) {
         K->x[kk] = s->rho_x;
         kk++;
     }
+    if (P != SCS_NULL) {
+        /* the diagonal of P is added to rho_x, the rest is stuffed as is */
+        for (j = 0; j < P->n; j++) {
+            for (k = P->p[j]; k < P->p[j + 1]; k++) {
+                if (P->i[k] == j) {
+                    K->x[j] += P->x[k];
+                } else {
+                    K->i[kk] = P->i[k];
+                    K->p[kk] = j;
+                    K->x[kk] = P->x[k];
+                    kk++;
+                }
+            }
+        }
+    }
     /* A^T at top right : CCS: */
     for (j = 0; j < A->n; j++) {
         for (k = A->p[j]; k < A->p[j + 1]; k++) {
@@ -164,10 +189,11 @@ void scs_accum_by_a(const ScsAMatrix *A, ScsPrivWorkspace *p, const scs_float *x
     scs_accum_by_a__(A->n, A->x, A->i, A->p, x, y);
 }
 
-static scs_int factorize(const ScsAMatrix *A, const ScsSettings *stgs, ScsPrivWorkspace *p) {
+static scs_int factorize(const ScsAMatrix *A, const ScsAMatrix *P, const ScsSettings *stgs,
+        ScsPrivWorkspace *p) {
     scs_float *info;
     scs_int *Pinv, amd_status, ldl_status;
-    scs_cs *C, *K = formKKT(A, stgs);
+    scs_cs *C, *K = formKKT(A, P, stgs);
     if (!K) {
         return -1;
     }
@@ -185,7 +211,7 @@ static scs_int factorize(const ScsAMatrix *A, const ScsSettings *stgs, ScsPrivWo
     return (ldl_status);
 }
 
-ScsPrivWorkspace *scs_init_priv(const ScsAMatrix *A, const ScsSettings *stgs) {
+ScsPrivWorkspace *scs_init_priv(const ScsAMatrix *A, const ScsAMatrix *P, const ScsSettings *stgs) {
     ScsPrivWorkspace *p = scs_calloc(1, sizeof (ScsPrivWorkspace));
     scs_int n_plus_m = A->n + A->m;
     p->P = scs_malloc(sizeof (scs_int) * n_plus_m);
@@ -195,7 +221,7 @@ ScsPrivWorkspace *scs_init_priv(const ScsAMatrix *A, const ScsSettings *stgs) {
     p->L->n = n_plus_m;
     p->L->nz = -1;
 
-    if (factorize(A, stgs, p) < 0) {
+    if (factorize(A, P, stgs, p) < 0) {
         scs_free_priv(p);
         return SCS_NULL;
     }
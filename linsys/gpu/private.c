@@ -191,9 +191,14 @@ scs_int scs_linsys_total_cg_iters(ScsPrivWorkspace *priv){
 
     }
 
-    ScsPrivWorkspace *scs_init_priv(const ScsAMatrix *A, const ScsSettings *stgs) {
+    ScsPrivWorkspace *scs_init_priv(const ScsAMatrix *A, const ScsAMatrix *P, const ScsSettings *stgs) {
         cudaError_t err;
-        ScsPrivWorkspace *p = (ScsPrivWorkspace *) scs_calloc(1, sizeof (ScsPrivWorkspace));
+        ScsPrivWorkspace *p;
+        if (P != SCS_NULL) {
+            scs_printf("quadratic costs are not supported by the GPU linear system solver\n");
+            return SCS_NULL;
+        }
+        p = (ScsPrivWorkspace *) scs_calloc(1, sizeof (ScsPrivWorkspace));
         p->Annz = A->p[A->n];
         p->cublasHandle = 0;
         p->cusparseHandle = 0;
@@ -31,13 +31,20 @@ char *scs_get_linsys_summary(ScsPrivWorkspace *p, const ScsInfo *info) {
     return str;
 }
 
-/* M = inv ( diag ( RHO_X * I + A'A ) ) */
+/* M = inv ( diag ( RHO_X * I + P + A'A ) ) */
 void getPreconditioner(const ScsAMatrix *A, const ScsSettings *stgs, ScsPrivWorkspace *p) {
-    scs_int i;
+    scs_int i, k;
     scs_float *M = p->M;
+    const ScsAMatrix *P = p->P;
 
     for (i = 0; i < A->n; ++i) {
-        M[i] = 1 / (stgs->rho_x +
+        scs_float Pii = 0;
+        if (P != SCS_NULL) {
+            for (k = P->p[i]; k < P->p[i + 1]; ++k) {
+                if (P->i[k] == i) Pii += P->x[k];
+            }
+        }
+        M[i] = 1 / (stgs->rho_x + Pii +
                 scs_norm_squared(&(A->x[A->p[i]]), A->p[i + 1] - A->p[i]));
         /* M[i] = 1; */
     }
@@ -95,7 +102,7 @@ void scs_free_priv(ScsPrivWorkspace *p) {
     }
 }
 
-/*y = (RHO_X * I + A'A)x */
+/*y = (RHO_X * I + P + A'A)x */
 static void matVec(const ScsAMatrix *A, const ScsSettings *s, ScsPrivWorkspace *p,
         const scs_float *x, scs_float *y) {
     scs_float *tmp = p->tmp;
@@ -104,6 +111,9 @@ static void matVec(const ScsAMatrix *A, const ScsSettings *s, ScsPrivWorkspace *
     memset(y, 0, A->n * sizeof (scs_float));
     scs_accum_by_a_trans(A, p, tmp, y);
     scs_add_scaled_array(y, x, A->n, s->rho_x);
+    if (p->P != SCS_NULL) {
+        scs_accum_by_p(p->P, x, y);
+    }
 }
 
 void scs_accum_by_a_trans(const ScsAMatrix *A, ScsPrivWorkspace *p, const scs_float *x,
@@ -125,8 +135,9 @@ static void applyPreConditioner(scs_float *M, scs_float *z, scs_float *r,
     }
 }
 
-ScsPrivWorkspace *scs_init_priv(const ScsAMatrix *A, const ScsSettings *stgs) {
+ScsPrivWorkspace *scs_init_priv(const ScsAMatrix *A, const ScsAMatrix *P, const ScsSettings *stgs) {
     ScsPrivWorkspace *p = scs_calloc(1, sizeof (ScsPrivWorkspace));
+    p->P = P;
     p->p = scs_malloc((A->n) * sizeof (scs_float));
     p->r = scs_malloc((A->n) * sizeof (scs_float));
     p->Gp = scs_malloc((A->n) * sizeof (scs_float));
@@ -156,7 +167,7 @@ ScsPrivWorkspace *scs_init_priv(const ScsAMatrix *A, const ScsSettings *stgs) {
     return p;
 }
 
-/* solves (I+A'A)x = b, s warm start, solution stored in b */
+/* solves (I+P+A'A)x = b, s warm start, solution stored in b */
 static scs_int pcg(const ScsAMatrix *A, const ScsSettings *stgs, ScsPrivWorkspace *pr,
         const scs_float *s, scs_float *b, scs_int max_its,
         scs_float tol) {
@@ -222,7 +233,7 @@ scs_int scs_solve_lin_sys(const ScsAMatrix *A, const ScsSettings *stgs, ScsPrivW
     /* solves Mx = b, for x but stores result in b */
     /* s contains warm-start (if available) */
     scs_accum_by_a_trans(A, p, &(b[A->n]), b);
-    /* solves (I+A'A)x = b, s warm start, solution stored in b */
+    /* solves (I+P+A'A)x = b, s warm start, solution stored in b */
     cgIts = pcg(A, stgs, p, s, b, A->n, MAX(cgTol, CG_BEST_TOL));
     scs_scale_array(&(b[A->n]), -1, A->m);
     scs_accum_by_a(A, p, b, &(b[A->n]));
@@ -14,6 +14,7 @@ struct scs_private_data {
     scs_float *Gp;
     scs_float *tmp;
     ScsAMatrix *At;
+    const ScsAMatrix *P; /* quadratic cost (not owned), or SCS_NULL */
     /* preconditioning */
     scs_float *z;
     scs_float *M;
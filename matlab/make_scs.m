@@ -43,9 +43,9 @@ temp_dir = fullfile(scs_root_dir, 'temp/');
 
 warning('off', 'MATLAB:mex:GccVersion_link');
 
-use_svd = true;
 gpu = false;   % compile the gpu version of SCS
 float = false; % using single precision (rather than double) floating points
+cache_float = false; % store the direction caches in single precision
 int = false;   % use 32 bit integers for indexing
 % WARNING: OPENMP WITH MATLAB CAN CAUSE ERRORS AND CRASH, USE WITH CAUTION:
 % openmp parallelizes the matrix multiply for the indirect solver (using CG):
@@ -53,11 +53,7 @@ flags.COMPILE_WITH_OPENMP = false;
 
 flags.BLASLIB = '-lmwblas -lmwlapack';
 % MATLAB_MEX_FILE env variable sets blasint to ptrdiff_t
-flags.LCFLAG = '';
-if use_svd,
-    flags.LCFLAG = '-DSVD_ACTIVATED';
-end
-flags.LCFLAG = strcat(flags.LCFLAG, ...
+flags.LCFLAG = strcat( ...
     ' -DSILENCE_AMATRIX_WARNING -DMATLAB_MEX_FILE', ...
     ' -DLAPACK_LIB_FOUND -DCTRLC=1 -DCOPYAMATRIX');
 flags.INCS = '';
@@ -71,6 +67,7 @@ common_scs = [source_dir 'linAlg.c ' ...
     source_dir 'scs.c ' ...
     source_dir 'ctrlc.c ' ...
     source_dir 'directions.c ' ...
+    source_dir 'chordal.c ' ...
     linsys_src_dir 'common.c ' ...
     source_dir 'scs_version.c ' ...
     scs_matlab_dir 'scs_mex.c'];
@@ -81,9 +78,9 @@ else
 end
 
 if ( isunix && ~ismac )
-    flags.link = '-lm -lut -lrt';
+    flags.link = '-lm -lut -lrt -lpthread';
 elseif  ( ismac )
-    flags.link = '-lm -lut';
+    flags.link = '-lm -lut -lpthread';
 else
     flags.link = '-lut';
     flags.LCFLAG = sprintf('-DNOBLASSUFFIX %s', flags.LCFLAG);
@@ -92,6 +89,9 @@ end
 if (float)
     flags.LCFLAG = sprintf('-DFLOAT %s', flags.LCFLAG);
 end
+if (cache_float)
+    flags.LCFLAG = sprintf('-DCACHE_FLOAT %s', flags.LCFLAG);
+end
 if (int)
     flags.INT = '';
 else
@@ -82,6 +82,51 @@ double *castToDoubleArr(scs_float *arr, scs_int len) {
 }
 #endif
 
+/* this memory must be freed; keeps only the upper triangular part of P */
+ScsAMatrix *parseQuadraticCost(const mxArray *P_mex, scs_int n) {
+    mwIndex *Pjc, *Pir;
+    double *Ppr;
+    scs_int j, l, nnz = 0;
+    ScsAMatrix *P;
+    if (P_mex == SCS_NULL || mxIsEmpty(P_mex)) {
+        return SCS_NULL;
+    }
+    if (!mxIsSparse(P_mex) || (scs_int) mxGetM(P_mex) != n
+            || (scs_int) mxGetN(P_mex) != n) {
+        mexErrMsgTxt("Input matrix P must be an n-by-n sparse matrix "
+                "(pass in sparse(P))");
+    }
+    Pjc = mxGetJc(P_mex);
+    Pir = mxGetIr(P_mex);
+    Ppr = mxGetPr(P_mex);
+    for (j = 0; j < n; ++j) {
+        for (l = (scs_int) Pjc[j]; l < (scs_int) Pjc[j + 1]; ++l) {
+            if ((scs_int) Pir[l] <= j) {
+                ++nnz;
+            }
+        }
+    }
+    P = scs_malloc(sizeof (ScsAMatrix));
+    P->m = n;
+    P->n = n;
+    P->p = scs_malloc(sizeof (scs_int) * (n + 1));
+    P->i = scs_malloc(sizeof (scs_int) * MAX(nnz, 1));
+    P->x = scs_malloc(sizeof (scs_float) * MAX(nnz, 1));
+    nnz = 0;
+    for (j = 0; j < n; ++j) {
+        P->p[j] = nnz;
+        for (l = (scs_int) Pjc[j]; l < (scs_int) Pjc[j + 1]; ++l) {
+            if ((scs_int) Pir[l] <= j) {
+                P->i[nnz] = (scs_int) Pir[l];
+                P->x[nnz] = (scs_float) Ppr[l];
+                ++nnz;
+            }
+        }
+    }
+    P->p[n] = nnz;
+    return P;
+}
+
 void setOutputField(mxArray **pout, scs_float *out, scs_int len) {
     *pout = mxCreateDoubleMatrix(0, 0, mxREAL);
 #if FLOAT > 0
@@ -111,19 +156,22 @@ void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[]) {
     const mxArray *kf;
     const mxArray *kl;
     const mxArray *kq;
+    const mxArray *krq;
     const mxArray *ks;
     const mxArray *kep;
     const mxArray *ked;
     const mxArray *kp;
+    const mxArray *kbl;
+    const mxArray *kbu;
     
     const mxArray *cone;
     const mxArray *settings;
     
     const mwSize one[1] = {1};
-    const int numInfoFields = 21;
+    const int numInfoFields = 23;
     const char *infoFields[] = {"iter", "status", "pobj", "dobj",
     "resPri", "resDual", "resInfeas", "resUnbdd",
-    "relGap", "setupTime", "solveTime",
+    "relGap", "setupTime", "solveTime", "coneTime",
     "progress_iter",
     "progress_relgap",
     "progress_respri",
@@ -133,6 +181,7 @@ void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[]) {
     "progress_time",
     "progress_mode",
     "progress_ls",
+    "progress_mem",
     "allocated_memory_bytes"};
     mxArray *tmp;
 #if EXTRAVERBOSE > 0
@@ -148,6 +197,7 @@ void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[]) {
         mexErrMsgTxt("scs returns up to 4 output arguments only.");
     }
     d = mxMalloc(sizeof (ScsData));
+    d->P = SCS_NULL;
     d->stgs = mxMalloc(sizeof (ScsSettings));
     k = mxMalloc(sizeof (ScsCone));
     data = prhs[0];
@@ -200,6 +250,7 @@ void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[]) {
     d->c = (scs_float *) mxGetPr(c_mex);
 #endif
     scs_set_default_settings(d);
+    d->stgs->handle_interrupts = 1; /* ctrl-c stops the solver in MATLAB */
     
     /* settings */
     tmp = mxGetField(settings, 0, "alpha");
@@ -214,6 +265,18 @@ void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[]) {
     if (tmp != SCS_NULL)
         d->stgs->max_iters = (scs_int) * mxGetPr(tmp);
     
+    tmp = mxGetField(settings, 0, "max_check_interval");
+    if (tmp != SCS_NULL)
+        d->stgs->max_check_interval = (scs_int) * mxGetPr(tmp);
+    
+    tmp = mxGetField(settings, 0, "async_monitor");
+    if (tmp != SCS_NULL)
+        d->stgs->async_monitor = (scs_int) * mxGetPr(tmp);
+    
+    tmp = mxGetField(settings, 0, "handle_interrupts");
+    if (tmp != SCS_NULL)
+        d->stgs->handle_interrupts = (scs_int) * mxGetPr(tmp);
+    
     tmp = mxGetField(settings, 0, "scale");
     if (tmp != SCS_NULL)
         d->stgs->scale = (scs_float) * mxGetPr(tmp);
@@ -237,6 +300,14 @@ void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[]) {
     if (tmp != SCS_NULL)
         d->stgs->cg_rate = (scs_float) * mxGetPr(tmp);
     
+    tmp = mxGetField(settings, 0, "presolve_cones");
+    if (tmp != SCS_NULL)
+        d->stgs->presolve_cones = (scs_int) * mxGetPr(tmp);
+    
+    tmp = mxGetField(settings, 0, "inexact_cone_projections");
+    if (tmp != SCS_NULL)
+        d->stgs->inexact_cone_projections = (scs_int) * mxGetPr(tmp);
+    
     tmp = mxGetField(settings, 0, "verbose");
     if (tmp != SCS_NULL)
         d->stgs->verbose = (scs_int) * mxGetPr(tmp);
@@ -266,6 +337,14 @@ void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[]) {
     if (tmp != SCS_NULL)
         d->stgs->memory = (scs_int) * mxGetPr(tmp);
     
+    tmp = mxGetField(settings, 0, "anderson_gram");
+    if (tmp != SCS_NULL)
+        d->stgs->anderson_gram = (scs_int) * mxGetPr(tmp);
+    
+    tmp = mxGetField(settings, 0, "adaptive_memory");
+    if (tmp != SCS_NULL)
+        d->stgs->adaptive_memory = (scs_int) * mxGetPr(tmp);
+    
     tmp = mxGetField(settings, 0, "sse");
     if (tmp != SCS_NULL)
         d->stgs->sse = (scs_float) * mxGetPr(tmp);
@@ -274,6 +353,10 @@ void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[]) {
     if (tmp != SCS_NULL)
         d->stgs->ls = (scs_int) * mxGetPr(tmp);
     
+    tmp = mxGetField(settings, 0, "ls_parallel");
+    if (tmp != SCS_NULL)
+        d->stgs->ls_parallel = (scs_int) * mxGetPr(tmp);
+    
     tmp = mxGetField(settings, 0, "beta");
     if (tmp != SCS_NULL)
         d->stgs->beta = (scs_float) * mxGetPr(tmp);
@@ -351,6 +434,26 @@ void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[]) {
         k->q = SCS_NULL;
     }
     
+    krq = mxGetField(cone, 0, "rq");
+    if (krq && !mxIsEmpty(krq)) {
+        const double *rq_mex;
+        const size_t *rq_dims;
+        rq_mex = mxGetPr(krq);
+        ns = (scs_int) mxGetNumberOfDimensions(krq);
+        rq_dims = mxGetDimensions(krq);
+        k->rqsize = (scs_int) rq_dims[0];
+        if (ns > 1 && rq_dims[0] == 1) {
+            k->rqsize = (scs_int) rq_dims[1];
+        }
+        k->rq = mxMalloc(sizeof (scs_int) * k->rqsize);
+        for (i = 0; i < k->rqsize; i++) {
+            k->rq[i] = (scs_int) rq_mex[i];
+        }
+    } else {
+        k->rqsize = 0;
+        k->rq = SCS_NULL;
+    }
+    
     ks = mxGetField(cone, 0, "s");
     if (ks && !mxIsEmpty(ks)) {
         const double *s_mex;
@@ -391,6 +494,27 @@ void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[]) {
         k->p = SCS_NULL;
     }
     
+    kbl = mxGetField(cone, 0, "bl");
+    kbu = mxGetField(cone, 0, "bu");
+    if (kbl && !mxIsEmpty(kbl) && kbu && !mxIsEmpty(kbu)) {
+        const double *bl_mex = mxGetPr(kbl);
+        const double *bu_mex = mxGetPr(kbu);
+        if (mxGetNumberOfElements(kbl) != mxGetNumberOfElements(kbu)) {
+            mexErrMsgTxt("K.bl and K.bu must have the same length");
+        }
+        k->bsize = (scs_int) mxGetNumberOfElements(kbl) + 1;
+        k->bl = mxMalloc(sizeof (scs_float) * (k->bsize - 1));
+        k->bu = mxMalloc(sizeof (scs_float) * (k->bsize - 1));
+        for (i = 0; i < k->bsize - 1; i++) {
+            k->bl[i] = (scs_float) bl_mex[i];
+            k->bu[i] = (scs_float) bu_mex[i];
+        }
+    } else {
+        k->bsize = 0;
+        k->bl = SCS_NULL;
+        k->bu = SCS_NULL;
+    }
+    
     A = scs_malloc(sizeof (ScsAMatrix));
     A->n = d->n;
     A->m = d->m;
@@ -415,6 +539,7 @@ void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[]) {
     A->x = (scs_float *) mxGetPr(A_mex);
 #endif
     d->A = A;
+    d->P = parseQuadraticCost((mxArray *) mxGetField(data, 0, "P"), d->n);
     /* warm-start inputs, allocates sol->x, ->y, ->s even if warm start not used
      */
     d->stgs->warm_start =
@@ -477,6 +602,11 @@ void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[]) {
     mxSetField(plhs[3], 0, "solveTime", tmp);
     *mxGetPr(tmp) = info->solveTime;
     
+    /*info.coneTime is millisecs */
+    tmp = mxCreateDoubleMatrix(1, 1, mxREAL);
+    mxSetField(plhs[3], 0, "coneTime", tmp);
+    *mxGetPr(tmp) = info->cone_time_ms;
+    
     if (d->stgs->do_record_progress) {
         scs_float * tmp_data;
         scs_int k;
@@ -542,6 +672,14 @@ void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[]) {
             tmp_data[k] = (double) (info->progress_ls[k]);
         }
         
+        /* info.progress_mem */
+        tmp = mxCreateDoubleMatrix(info->history_length, 1, mxREAL);
+        mxSetField(plhs[3], 0, "progress_mem", tmp);
+        tmp_data = mxGetPr(tmp);
+        for (k = 0; k < info->history_length; ++k) {
+            tmp_data[k] = (double) (info->progress_mem[k]);
+        }
+        
         /* info.progress_ls */
         tmp = mxCreateDoubleMatrix(1, 1, mxREAL);
         mxSetField(plhs[3], 0, "allocated_memory_bytes", tmp);
@@ -557,10 +695,16 @@ void freeMex(ScsData *d, ScsCone *k) {
     if (k) {
         if (k->q)
             scs_free(k->q);
+        if (k->rq)
+            scs_free(k->rq);
         if (k->s)
             scs_free(k->s);
         if (k->p)
             scs_free(k->p);
+        if (k->bl)
+            scs_free(k->bl);
+        if (k->bu)
+            scs_free(k->bu);
     }
     if (d) {
 #if FLOAT > 0
@@ -582,6 +726,12 @@ void freeMex(ScsData *d, ScsCone *k) {
 #endif
             scs_free(d->A);
         }
+        if (d->P) {
+            scs_free(d->P->p);
+            scs_free(d->P->i);
+            scs_free(d->P->x);
+            scs_free(d->P);
+        }
         if (d->stgs)
             scs_free(d->stgs);
         scs_free(d);
@@ -8,7 +8,11 @@ function scs_set_options(solver_ops)
 %Input arguments:
 %solver_ops  solver options is a structure with the
 %            following fields:
+%             adaptive_memory - whether the memory of the direction is
+%                         adapted during the iterations (up to memory)
 %             alpha - relaxation parameter
+%             anderson_gram - whether Anderson's acceleration uses the
+%                         normal equations instead of a QR factorization
 %             beta - step size reduction coefficient
 %             c1 - parameter to check condition at K1
 %             c_bl - parameter for blind updates
@@ -18,12 +22,18 @@ function scs_set_options(solver_ops)
 %             do_super_scs - whether SuperSCS should be activated (if not,
 %                           the legacy SCS code is executed).
 %             eps - the solver tolerance
+%             inexact_cone_projections - whether the exp/power/PSD cone 
+%                         projections become more accurate like (1/iter)^2
 %             k0 - activation of k0 steps
 %             k1 - activation of k1 steps
 %             k2 - activation of k2 steps
 %             ls - maximum number of linesearch steps
+%             ls_parallel - number of linesearch step sizes evaluated at 
+%                         once (in parallel with OpenMP)
 %             memor - memory of direction (Broyden/Anderson)
 %             normalize - heuristic data rescaling (on/off) 
+%             presolve_cones - whether to bring the cones into canonical
+%                         form (on/off)
 %             rho_x - scaling parameter rho_x
 %             scale - if normalized, rescales by this factor
 %             sigma - linesearch parameter
@@ -34,6 +44,12 @@ function scs_set_options(solver_ops)
 %                                  running SuperSCS (slows down execution).
 %             warm_start - warm start
 %             max_iters - maximum number of iterations
+%             max_check_interval - maximum number of iterations between
+%                                  two (adaptive) convergence checks
+%             async_monitor - whether to check convergence on a helper
+%                             thread (SuperSCS only)
+%             handle_interrupts - whether ctrl-c stops the solver
+%                                 (default: 1)
 %             max_time_milliseconds - SuperSCS can be instructed to stop
 %                                     after a certain time (in ms). The
 %                                     default value is 300000ms, that is 5
@@ -77,6 +77,25 @@
  * 
  * 
  * 
+ * \subsection cones-box Box cone
+ * 
+ * Given vectors \f$b_l, b_u\in\mathbb{R}^{n_{\mathrm{b}}-1}\f$ with 
+ * \f$b_l\leq b_u\f$ (whose entries may be \f$-\infty\f$ and \f$+\infty\f$ 
+ * respectively), the box cone is
+ * 
+ * \f{eqnarray*}{
+ * \mathcal{K}^{\mathrm{b}}_{n_{\mathrm{b}}} = 
+ * \{(t, s)\in\mathbb{R}\times\mathbb{R}^{n_{\mathrm{b}}-1}: 
+ *   t\geq 0, t b_l \leq s \leq t b_u\}.
+ * \f}
+ * 
+ * Fixing \f$t = 1\f$ with one row of \f$A\f$ and \f$b\f$, bounds 
+ * \f$b_l \leq s \leq b_u\f$ take one row per variable, whereas two rows of 
+ * the linear cone would be needed otherwise.
+ * 
+ * 
+ * 
+ * 
  * \subsection cone-soc SO cone
  * 
  * This is the Cartesian product of \f$N_{\mathrm{q}}\f$ cones with 
@@ -105,6 +124,29 @@
  * 
  * 
  * 
+ * \subsection cones-rsoc Rotated SO cone
+ * 
+ * The rotated second-order cone of dimension \f$n\geq 2\f$ is
+ * 
+ * \f{eqnarray*}{
+ * \mathcal{K}^{\mathrm{rq}}_{n} = \{x = (u, v, w): u, v\in\mathbb{R}, 
+ * w\in\mathbb{R}^{n-2}, \text{ so that }
+ * 2uv \geq \|w\|^2, u\geq 0, v \geq 0\}
+ * \f}
+ * 
+ * and, as for second-order cones, products 
+ * \f$\mathcal{K}^{\mathrm{rq}}_{n_{\mathrm{rq},1},\ldots, n_{\mathrm{rq},N_{\mathrm{rq}}}}\f$
+ * of such cones are supported. 
+ * 
+ * The orthogonal map \f$(u, v, w)\mapsto ((u+v)/\sqrt{2}, (u-v)/\sqrt{2}, w)\f$
+ * maps \f$\mathcal{K}^{\mathrm{rq}}_{n}\f$ onto \f$\mathcal{K}^{\mathrm{q}}_{n}\f$, 
+ * so the cone is self-dual and is projected upon in closed form. Constraints 
+ * such as \f$x^\top x \leq 2ts\f$ are then stated without the auxiliary 
+ * rows of an equivalent second-order cone formulation.
+ * 
+ * 
+ * 
+ * 
  * \subsection cones-psd PSD cone
  * Let us first give a few necessary definitions. Given a symmetric matrix 
  * \f$X\in\mathbb{R}^{k\times k}\f$ we define the vectorization operator as 
@@ -249,8 +291,12 @@
  *                  \times 
  *               \mathcal{K}^{\mathrm{l}}_{n_{\mathrm{l}}}
  *                  \times
+ *               \mathcal{K}^{\mathrm{b}}_{n_{\mathrm{b}}}
+ *                  \times
  *               \mathcal{K}^{\mathrm{q}}_{n_{\mathrm{q}_1},\ldots, n_{\mathrm{q},N_{\mathrm{q}}}}
  *                  \times
+ *               \mathcal{K}^{\mathrm{rq}}_{n_{\mathrm{rq}_1},\ldots, n_{\mathrm{rq},N_{\mathrm{rq}}}}
+ *                  \times
  *               \mathcal{K}^{\mathrm{s}}_{k_{1},\ldots, k_{N_{\mathrm{p}}}}
  *                  \times
  *              \mathcal{K}^{\mathrm{ep}}_{n_{\mathrm{ep}}}
@@ -281,6 +327,13 @@
  * K.p  = [0.1, -0.6, 0.9];
  * ~~~~~
  * 
+ * A box cone is specified by its bounds, e.g., <code>K.bl = [-1, 0]</code> and
+ * <code>K.bu = [1, Inf]</code> give \f$\mathcal{K}^{\mathrm{b}}_{3}\f$.
+ * 
+ * Rotated second-order cones are specified as <code>K.rq = [3, 4]</code>,
+ * which gives \f$\mathcal{K}^{\mathrm{rq}}_{3,4}\f$; their rows follow
+ * those of the second-order cones.
+ * 
  * This corresponds to the following Cartesian product of cones:
  * 
  * \f{eqnarray*}{
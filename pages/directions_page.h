@@ -58,7 +58,12 @@
  * In Anderson's acceleration, we update a cache of past values of vectors \f$y_i\f$ and \f$s_i\f$.
  * 
  * We need to solve a linear system whose LHS matrix is \f$l\times m\f$, where
- * \f$m\f$ is the memory length. We do so using the SVD decomposition. 
+ * \f$m\f$ is the memory length. We do so using a thin QR factorization of 
+ * \f$Y_k\f$ which is updated at every iteration: the newest column is appended
+ * by Gram-Schmidt orthogonalization and, once the memory is full, the oldest
+ * column is removed using Givens rotations. This way, every iteration costs 
+ * \f$O(lm)\f$ operations. If the new column is (numerically) linearly 
+ * dependent on the previous ones, the memory is restarted.
  * 
  * The direction is computed by
  * 
@@ -68,7 +73,7 @@
  * 
  * where \f$t_k\f$ is a solution of the linear system \f$Y_kt_k = Rx_k\f$, or, if the system
  * does not have a solution, a solution of the corresponding least-squares problem
- * (solved using SVD).
+ * (solved using the above QR factorization).
  * 
  * Matrices \f$Y_k\f$ and \f$S_k\f$ are buffers of past vectors \f$y_k\f$ and \f$s_k\f$
  * respectively, that is
@@ -88,7 +93,54 @@
  * #scs_direction_cache.
  * 
  * \section sec-full-broyden Full Broyden
- * Full Broyden method (for experimental purposes only, not recommended unless the 
- * problem is of very low dimension).
+ * 
+ * A limited-memory variant of Broyden's method with Powell's safeguard. The 
+ * inverse Jacobian estimate is given by the compact representation
+ * 
+ * \f{eqnarray*}{
+ *  H_k = h_0 I + (S_k - h_0 Y_k)(h_0 S_k^{\top} Y_k - L_k)^{-1} h_0 S_k^{\top},
+ * \f}
+ * 
+ * where \f$S_k\f$ and \f$Y_k\f$ contain the last \f$m\f$ pairs 
+ * \f$(s_i, y_i)\f$ (oldest first), \f$L_k\f$ is the strictly lower 
+ * triangular part of \f$S_k^{\top}S_k\f$ and \f$h_0 = \langle s, y\rangle/\|y\|^2\f$
+ * is computed from the first pair (if ScsSettings#broyden_init_scaling is set; 
+ * otherwise \f$h_0=1\f$). 
+ * 
+ * Powell's safeguard (see \ref sec-restarted-broyden "Restarted Broyden") is 
+ * applied by caching \f$\theta y + (1-\theta)H_k^{-1}s\f$ in place of 
+ * \f$y\f$. Unlike the restarted Broyden method, once the memory is full the
+ * oldest pair is discarded; the memory is restarted only if the middle matrix 
+ * becomes singular. Every iteration costs \f$O(lm)\f$ operations and 
+ * \f$O(lm)\f$ memory.
+ * 
+ * 
+ * \section sec-cache-precision Precision of the cached vectors
+ * 
+ * The vectors kept in the cache of the above methods (\f$s_i\f$, \f$u_i\f$ or 
+ * \f$y_i\f$, and \f$s_i-y_i\f$) dominate the memory footprint of SuperSCS on 
+ * large problems. If SuperSCS is compiled with <code>CACHE_FLOAT=1</code> 
+ * (e.g., <code>make CACHE_FLOAT=1</code>), these are stored in single 
+ * precision, which halves the memory they occupy, while all inner products and
+ * the small dense linear algebra are carried out in double precision. 
+ * The orthonormal factor \f$Q\f$ of Anderson's acceleration is always 
+ * stored in full precision.
+ * 
+ * 
+ * \section sec-adaptive-memory Adaptive memory
+ * 
+ * The best memory length depends on the problem. If 
+ * ScsSettings#adaptive_memory is set, ScsSettings#memory is the largest 
+ * number of pairs that are used and the active memory starts from half of it.
+ * After every direction, the active memory is decreased by one if the 
+ * (estimated) condition number of the system solved by the method exceeds 
+ * \f$10^6\f$; otherwise, it is increased by one if the norm of the fixed-point
+ * residual decreased by less than \f$10\%\f$ since the previous direction.
+ * For the restarted Broyden method, the system is considered ill-conditioned 
+ * when Powell's safeguard is activated. If the fixed-point residual stagnates
+ * for five consecutive directions, the memory is restarted. 
+ * 
+ * The active memory at every iteration is recorded in 
+ * ScsInfo#progress_mem (see \ref page_logging "logging").
  * 
  */
\ No newline at end of file
@@ -35,7 +35,10 @@
  * following information:
  * 
  * - <code>progress_iter</code> an array of the iterations when the progress data
- *   were recorded. It is possible that progress data are stored with a stride.
+ *   were recorded. The progress data are recorded at the convergence checks, 
+ *   which take place at every iteration unless 
+ *   \ref ScsSettings#max_check_interval "max_check_interval" is larger than 
+ *   \c 1, in which case they are recorded at non-uniform intervals.
  * - <code>progress_time</code> an array of timestamps (starting at \c 0) when
  *   the progress data were recorded
  * - <code>progress_norm_fpr</code> the values of the fixed-point residual at 
@@ -51,8 +54,13 @@
  * - <code>progress_mode</code> the type of step that was taken at every iteration;
  *   \c -1 corresponds to a nominal step, \c 0 is for a K0 step and \c 1 and \c 2
  *   are for K1 and K2 steps respectively.
+ * - <code>progress_mem</code> the active memory of the direction at each 
+ *   iteration; it is constant unless \ref ScsSettings#adaptive_memory "adaptive_memory"
+ *   is set.
  * 
- * Note that the above arrays have length equal to the number of iterations.
+ * Note that the above arrays have length equal to the number of convergence 
+ * checks, <code>history_length</code> (equal to the number of iterations 
+ * by default).
  * 
  * Example:
  * 
@@ -112,6 +120,7 @@
  *              progress_time: [32x1 double]
  *              progress_mode: [32x1 double]
  *                progress_ls: [32x1 double]
+ *               progress_mem: [32x1 double]
  *     allocated_memory_bytes: 14528
  * ~~~~~
  * 
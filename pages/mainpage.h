@@ -40,6 +40,11 @@
  * "(sparse) matrix", and \f$\mathcal{K}\f$ is a closed, convex, proper 
  * \ref page_cones "cone".
  * 
+ * The cost may also contain a convex quadratic term 
+ * \f$\tfrac{1}{2}x'Px\f$; the upper triangular part of the positive 
+ * semidefinite matrix \f$P\f$ is passed in <code>data->P</code> (this is 
+ * not supported by the GPU linear system solver).
+ * 
  * \f$\mathcal{K}\f$ can be the Cartesian product of the 
  * \ref cones-zero "zero cone", 
  * the \ref cone-linear "positive orthant", 
@@ -243,10 +243,16 @@ static void freePyData(ScsData *d, ScsCone *k, struct ScsPyData *ps) {
     if (k) {
         if (k->q)
             scs_free(k->q);
+        if (k->rq)
+            scs_free(k->rq);
         if (k->s)
             scs_free(k->s);
         if (k->p)
             scs_free(k->p);
+        if (k->bl)
+            scs_free(k->bl);
+        if (k->bu)
+            scs_free(k->bu);
         scs_free(k);
     }
     if (d) {
@@ -276,6 +282,7 @@ static PyObject *csolve(PyObject *self, PyObject *args, PyObject *kwargs) {
     PyObject *normalize = SCS_NULL;
     PyObject *do_record_progress = SCS_NULL;
     PyObject *do_super_scs = SCS_NULL;
+    scs_int bu_size = 0;
     /* get the typenum for the primitive scs_int and scs_float types */
     int scs_intType = getIntType();
     int scs_floatType = getFloatType();
@@ -302,18 +309,18 @@ static PyObject *csolve(PyObject *self, PyObject *args, PyObject *kwargs) {
 #ifdef DLONG
 #ifdef FLOAT
     char *argparse_string = "(ll)O!O!O!O!O!O!O!|O!O!O!llllffffffff";
-    char *outarg_string = "{s:l,s:l,s:f,s:f,s:f,s:f,s:f,s:f,s:f,s:f,s:f,s:s}";
+    char *outarg_string = "{s:l,s:l,s:f,s:f,s:f,s:f,s:f,s:f,s:f,s:f,s:f,s:f,s:s}";
 #else
     char *argparse_string = "(ll)O!O!O!O!O!O!O!|O!O!O!lllldddddddd";
-    char *outarg_string = "{s:l,s:l,s:d,s:d,s:d,s:d,s:d,s:d,s:d,s:d,s:d,s:s}";
+    char *outarg_string = "{s:l,s:l,s:d,s:d,s:d,s:d,s:d,s:d,s:d,s:d,s:d,s:d,s:s}";
 #endif
 #else
 #ifdef FLOAT
     char *argparse_string = "(ii)O!O!O!O!O!O!O!|O!O!O!iiiiffffffff";
-    char *outarg_string = "{s:i,s:i,s:f,s:f,s:f,s:f,s:f,s:f,s:f,s:f,s:f,s:s}";
+    char *outarg_string = "{s:i,s:i,s:f,s:f,s:f,s:f,s:f,s:f,s:f,s:f,s:f,s:f,s:s}";
 #else
     char *argparse_string = "(ii)O!O!O!O!O!O!O!|O!O!O!iiiidddddddd";
-    char *outarg_string = "{s:i,s:i,s:d,s:d,s:d,s:d,s:d,s:d,s:d,s:d,s:d,s:s}";
+    char *outarg_string = "{s:i,s:i,s:d,s:d,s:d,s:d,s:d,s:d,s:d,s:d,s:d,s:d,s:s}";
 #endif
 #endif
     npy_intp veclen[1];
@@ -323,6 +330,7 @@ static PyObject *csolve(PyObject *self, PyObject *args, PyObject *kwargs) {
 
     /* set defaults */
     scs_set_default_settings(d);
+    d->stgs->handle_interrupts = 1; /* ctrl-c stops the solver */
 
     if (!PyArg_ParseTupleAndKeywords(
             args, kwargs, argparse_string, kwlist,
@@ -406,12 +414,27 @@ static PyObject *csolve(PyObject *self, PyObject *args, PyObject *kwargs) {
     if (getConeArrDim("q", &(k->q), &(k->qsize), cone) < 0) {
         return finishWithErr(d, k, &ps, "failed to parse cone field q");
     }
+    if (getConeArrDim("rq", &(k->rq), &(k->rqsize), cone) < 0) {
+        return finishWithErr(d, k, &ps, "failed to parse cone field rq");
+    }
     if (getConeArrDim("s", &(k->s), &(k->ssize), cone) < 0) {
         return finishWithErr(d, k, &ps, "failed to parse cone field s");
     }
     if (getConeFloatArr("p", &(k->p), &(k->psize), cone) < 0) {
         return finishWithErr(d, k, &ps, "failed to parse cone field p");
     }
+    if (getConeFloatArr("bl", &(k->bl), &(k->bsize), cone) < 0) {
+        return finishWithErr(d, k, &ps, "failed to parse cone field bl");
+    }
+    if (getConeFloatArr("bu", &(k->bu), &bu_size, cone) < 0) {
+        return finishWithErr(d, k, &ps, "failed to parse cone field bu");
+    }
+    if (k->bsize != bu_size) {
+        return finishWithErr(d, k, &ps, "cone fields bl and bu must have the same length");
+    }
+    if (k->bsize > 0) {
+        k->bsize++; /* the box cone includes the variable t */
+    }
     if (getPosIntParam("ep", &(k->ep), 0, cone) < 0) {
         return finishWithErr(d, k, &ps, "failed to parse cone field ep");
     }
@@ -509,7 +532,8 @@ static PyObject *csolve(PyObject *self, PyObject *args, PyObject *kwargs) {
         (scs_float)info.resDual, "relGap", (scs_float)info.relGap, "resInfeas",
         (scs_float)info.resInfeas, "resUnbdd", (scs_float)info.resUnbdd,
         "solveTime", (scs_float)(info.solveTime), "setupTime",
-        (scs_float)(info.setupTime), "status", info.status);
+        (scs_float)(info.setupTime), "coneTime", (scs_float)(info.cone_time_ms),
+        "status", info.status);
 
     returnDict = Py_BuildValue("{s:O,s:O,s:O,s:O}", "x", x, "y", y, "s", s,
                                "info", infoDict);
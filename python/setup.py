@@ -47,6 +47,8 @@ parser.add_argument('--gpu', dest='gpu', action='store_true',
                     default=False, help='Also compile the GPU CUDA version of SCS')
 parser.add_argument('--float', dest='float32', action='store_true',
                     default=False, help='Use 32 bit (single precision) floats, default is 64 bit')
+parser.add_argument('--cache-float', dest='cache_float32', action='store_true',
+                    default=False, help='Store the direction caches in single precision')
 parser.add_argument('--extraverbose', dest='extraverbose', action='store_true',
                     default=False, help='Extra verbose SCS (for debugging)')
 parser.add_argument('--int', dest='int32', action='store_true',
@@ -189,12 +191,14 @@ def install_scs(**kwargs):
     extra_define_macros = []
     sources = ['scsmodule.c', ] + glob(os.path.join(root_dir, 'src/*.c')) + glob(os.path.join(root_dir, 'linsys/*.c'))
     include_dirs = [root_dir, os.path.join(root_dir, 'include'), get_include(), os.path.join(root_dir, 'linsys')]
-    define_macros = [('PYTHON', None), ('CTRLC', 1), ('COPYAMATRIX', None), ('USE_LAPACK', 1), ('LAPACK_LIB_FOUND', 1),('SVD_ACTIVATED', 1)]
+    define_macros = [('PYTHON', None), ('CTRLC', 1), ('COPYAMATRIX', None), ('USE_LAPACK', 1), ('LAPACK_LIB_FOUND', 1)]
 
     if system() == 'Linux':
-        libraries += ['rt']
+        libraries += ['rt', 'pthread']
     if args.float32:
         define_macros += [('FLOAT', 1)] # single precision floating point
+    if args.cache_float32:
+        define_macros += [('CACHE_FLOAT', 1)] # single precision direction caches
     if args.extraverbose:
         define_macros += [('EXTRAVERBOSE', 999)] # for debugging
     if args.blas64:
@@ -29,7 +29,7 @@ endif
 
 ifeq ($(UNAME), Darwin)
 # we're on apple, no need to link rt library
-LDFLAGS += -lm
+LDFLAGS += -lm -lpthread
 SHARED = dylib
 SONAME = -install_name
 CULDFLAGS = -L/usr/local/cuda/lib
@@ -42,7 +42,7 @@ SONAME = -soname
 CULDFLAGS = -L/usr/local/cuda/lib64 #TODO: probably doesn't work...
 else
 # we're on a linux system, use accurate timer provided by clock_gettime()
-LDFLAGS += -lm -lrt
+LDFLAGS += -lm -lrt -lpthread
 SHARED = so
 SONAME = -soname
 CULDFLAGS = -L/usr/local/cuda/lib64
@@ -135,14 +135,6 @@ endif
 # Other parameters
 # ------------------------------------------------------
 
-# Whether to activate SVD for the computation of AA directions
-ifeq (,$(SVD_ACTIVATED))
-SVD_ACTIVATED = 1
-endif
-ifneq ($(SVD_ACTIVATED), 0)
-OPT_FLAGS += -DSVD_ACTIVATED=$(SVD_ACTIVATED)
-endif
-
 ifeq (,$(DLONG))
 DLONG = 0
 endif
@@ -165,6 +157,13 @@ ifneq ($(FLOAT), 0)
 OPT_FLAGS += -DFLOAT=$(FLOAT) # use floats rather than doubles
 endif
 
+ifeq (,$(CACHE_FLOAT))
+CACHE_FLOAT = 0
+endif
+ifneq ($(CACHE_FLOAT), 0)
+OPT_FLAGS += -DCACHE_FLOAT=$(CACHE_FLOAT) # store direction caches in single precision
+endif
+
 ifeq (,$(NOVALIDATE))
 NOVALIDATE = 0
 endif
@@ -0,0 +1,1058 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 Pantelis Sopasakis (https://alphaville.github.io),
+ *                    Krina Menounou (https://www.linkedin.com/in/krinamenounou), 
+ *                    Panagiotis Patrinos (http://homes.esat.kuleuven.be/~ppatrino)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * 
+ */
+#include "chordal.h"
+#include "linsys/amatrix.h"
+
+/* smallest PSD cone which is considered for decomposition */
+#define SCS_CHORDAL_MIN_SIZE (3)
+/* a clique is merged with its parent if the two residuals are small... */
+#define SCS_CHORDAL_MERGE_SIZE (4)
+/* ...or if the fill-in caused by the merge is small */
+#define SCS_CHORDAL_MERGE_FILL (64)
+/* regularization used in the positive semidefinite completion */
+#define SCS_CHORDAL_COMPLETION_REG (1e-10)
+
+/* index of entry (i, j), i >= j, in the lower-triangular vectorization */
+static scs_int scs_chordal_tri_index(scs_int N, scs_int i, scs_int j) {
+    return j * N - (j * (j - 1)) / 2 + i - j;
+}
+
+static scs_int scs_chordal_tri_size(scs_int N) {
+    return (N * (N + 1)) / 2;
+}
+
+static void scs_chordal_free_block(ScsChordalBlock * RESTRICT block) {
+    scs_free(block->clique_ptr);
+    scs_free(block->clique_vertices);
+    scs_free(block->parent);
+    block->num_cliques = 0;
+}
+
+/* list of neighbours of a vertex, which grows with the fill-in */
+typedef struct scs_chordal_list {
+    scs_int *v;
+    scs_int len;
+    scs_int cap;
+} ScsChordalList;
+
+static int scs_chordal_compare_int(const void * a, const void * b) {
+    const scs_int ia = *(const scs_int *) a;
+    const scs_int ib = *(const scs_int *) b;
+    return ia < ib ? -1 : (ia > ib);
+}
+
+/*
+ * Appends u to a list; if the list is full, the vertices which have been
+ * eliminated (position >= 0) are dropped first, and it grows only if this
+ * does not make room. Returns -1 if memory could not be allocated.
+ */
+static scs_int scs_chordal_list_push(
+        ScsChordalList * RESTRICT list,
+        scs_int u,
+        const scs_int * RESTRICT position) {
+    scs_int i, len = 0;
+    if (list->len == list->cap) {
+        for (i = 0; i < list->len; ++i) {
+            if (position[list->v[i]] < 0) list->v[len++] = list->v[i];
+        }
+        list->len = len;
+    }
+    if (list->len == list->cap) {
+        scs_int * v = scs_malloc((2 * list->cap + 4) * sizeof (scs_int));
+        if (v == SCS_NULL) return -1; /* LCOV_EXCL_LINE */
+        if (list->len > 0) memcpy(v, list->v, list->len * sizeof (scs_int));
+        scs_free(list->v);
+        list->v = v;
+        list->cap = 2 * list->cap + 4;
+    }
+    list->v[list->len++] = u;
+    return 0;
+}
+
+/* vertices are ordered by degree, and ties are broken by index */
+static scs_int scs_chordal_heap_less(const scs_int * RESTRICT degree, scs_int a, scs_int b) {
+    return degree[a] < degree[b] || (degree[a] == degree[b] && a < b);
+}
+
+/* restores the heap property after the key of heap[k] has changed */
+static void scs_chordal_heap_sift(
+        scs_int * RESTRICT heap,
+        scs_int * RESTRICT where,
+        scs_int size,
+        const scs_int * RESTRICT degree,
+        scs_int k) {
+    const scs_int v = heap[k];
+    scs_int c;
+    while (k > 0 && scs_chordal_heap_less(degree, v, heap[(k - 1) / 2])) {
+        heap[k] = heap[(k - 1) / 2];
+        where[heap[k]] = k;
+        k = (k - 1) / 2;
+    }
+    while ((c = 2 * k + 1) < size) {
+        if (c + 1 < size && scs_chordal_heap_less(degree, heap[c + 1], heap[c])) c++;
+        if (!scs_chordal_heap_less(degree, heap[c], v)) break;
+        heap[k] = heap[c];
+        where[heap[k]] = k;
+        k = c;
+    }
+    heap[k] = v;
+    where[v] = k;
+}
+
+/*
+ * Computes a chordal extension of the graph with adjacency lists adj by a
+ * minimum degree elimination (the vertex of smallest index is eliminated 
+ * among the ones of minimum degree), using a heap of the vertices which are 
+ * not yet eliminated. On exit, order is a perfect elimination ordering and 
+ * the list of every vertex holds its higher neighbours in the extension.
+ * 
+ * Returns 0 on success, or -1 if memory could not be allocated.
+ */
+static scs_int scs_chordal_eliminate(
+        scs_int N,
+        ScsChordalList * RESTRICT adj,
+        scs_int * RESTRICT order,
+        scs_int * RESTRICT position,
+        scs_int * RESTRICT degree,
+        scs_int * RESTRICT heap,
+        scs_int * RESTRICT where,
+        scs_int * RESTRICT mark) {
+    scs_int i, j, t, v, nnb, size;
+
+    for (i = 0; i < N; ++i) {
+        degree[i] = adj[i].len;
+        position[i] = -1;
+        mark[i] = -1;
+        heap[i] = i;
+        scs_chordal_heap_sift(heap, where, i + 1, degree, i);
+    }
+    size = N;
+    for (t = 0; t < N; ++t) {
+        const scs_int * neighbours;
+        v = heap[0];
+        heap[0] = heap[--size];
+        if (size > 0) scs_chordal_heap_sift(heap, where, size, degree, 0);
+        order[t] = v;
+        position[v] = t;
+        /* the neighbours of v which are not yet eliminated */
+        nnb = 0;
+        for (i = 0; i < adj[v].len; ++i) {
+            if (position[adj[v].v[i]] < 0) adj[v].v[nnb++] = adj[v].v[i];
+        }
+        adj[v].len = nnb;
+        neighbours = adj[v].v;
+        /* the neighbours of v become a clique */
+        for (i = 0; i < nnb; ++i) {
+            scs_int a = neighbours[i];
+            for (j = 0; j < adj[a].len; ++j) {
+                mark[adj[a].v[j]] = a;
+            }
+            degree[a]--;
+            scs_chordal_heap_sift(heap, where, size, degree, where[a]);
+            for (j = i + 1; j < nnb; ++j) {
+                scs_int b = neighbours[j];
+                if (mark[b] != a) {
+                    if (scs_chordal_list_push(&adj[a], b, position) < 0
+                            || scs_chordal_list_push(&adj[b], a, position) < 0) {
+                        return -1; /* LCOV_EXCL_LINE */
+                    }
+                    /* one key at a time, so that the rest is always a heap */
+                    degree[a]++;
+                    scs_chordal_heap_sift(heap, where, size, degree, where[a]);
+                    degree[b]++;
+                    scs_chordal_heap_sift(heap, where, size, degree, where[b]);
+                }
+            }
+        }
+    }
+    return 0;
+}
+
+/*
+ * Detects the aggregate sparsity pattern of a PSD cone, computes the cliques
+ * of a chordal extension and its clique tree and merges small cliques.
+ * 
+ * The graph and the cliques are stored as (sorted) lists of vertices, so 
+ * that the memory is proportional to the number of nonzeros of the chordal 
+ * extension rather than to N^2.
+ * 
+ * Returns the number of cliques (if this is 1, the block is not worth
+ * decomposing and nothing is stored in block), or -1 on failure.
+ */
+static scs_int scs_chordal_analyse_block(
+        ScsChordalBlock * RESTRICT block,
+        const char * RESTRICT pattern) {
+    const scs_int N = block->size;
+    scs_int i, j, k, t, v, num_cliques, num_live = -1, nnz_cliques;
+    scs_int *iwork, *order, *position, *degree, *heap, *where, *mark, *parent_vertex;
+    scs_int *count, *claim, *supernode, *clique_of, *clique_parent, *merged_into;
+    scs_int *clique_size, *new_index;
+    ScsChordalList *adj;
+    scs_int **clique;
+
+    iwork = scs_malloc(14 * N * sizeof (scs_int));
+    adj = scs_calloc(N, sizeof (ScsChordalList));
+    clique = scs_calloc(N, sizeof (scs_int *));
+    if (iwork == SCS_NULL || adj == SCS_NULL || clique == SCS_NULL) {
+        /* LCOV_EXCL_START */
+        scs_free(iwork);
+        scs_free(adj);
+        scs_free(clique);
+        return -1;
+        /* LCOV_EXCL_STOP */
+    }
+    order = iwork;
+    position = order + N;
+    degree = position + N;
+    heap = degree + N;
+    where = heap + N;
+    mark = where + N;
+    parent_vertex = mark + N;
+    count = parent_vertex + N;
+    claim = count + N;
+    supernode = claim + N;
+    clique_of = supernode + N;
+    clique_parent = clique_of + N;
+    merged_into = clique_parent + N;
+    clique_size = merged_into + N;
+
+    /* aggregate sparsity pattern (off-diagonal entries) */
+    for (j = 0; j < N; ++j) {
+        for (i = j + 1; i < N; ++i) {
+            if (pattern[scs_chordal_tri_index(N, i, j)]) {
+                adj[i].cap++;
+                adj[j].cap++;
+            }
+        }
+    }
+    for (v = 0; v < N; ++v) {
+        adj[v].v = scs_malloc(adj[v].cap * sizeof (scs_int));
+        if (adj[v].cap > 0 && adj[v].v == SCS_NULL) goto out; /* LCOV_EXCL_LINE */
+    }
+    for (j = 0; j < N; ++j) {
+        for (i = j + 1; i < N; ++i) {
+            if (pattern[scs_chordal_tri_index(N, i, j)]) {
+                adj[i].v[adj[i].len++] = j;
+                adj[j].v[adj[j].len++] = i;
+            }
+        }
+    }
+
+    if (scs_chordal_eliminate(N, adj, order, position, degree, heap, where, mark) < 0) {
+        goto out; /* LCOV_EXCL_LINE */
+    }
+
+    /* elimination tree: parent of v is its first higher neighbour */
+    for (v = 0; v < N; ++v) {
+        parent_vertex[v] = -1;
+        count[v] = adj[v].len;
+        claim[v] = -1;
+        for (i = 0; i < adj[v].len; ++i) {
+            scs_int u = adj[v].v[i];
+            if (parent_vertex[v] < 0 || position[u] < position[parent_vertex[v]]) {
+                parent_vertex[v] = u;
+            }
+        }
+    }
+
+    /* fundamental supernodes: v is absorbed by a child u if col(v) is in col(u) */
+    for (t = 0; t < N; ++t) {
+        v = order[t];
+        if (parent_vertex[v] >= 0
+                && count[v] == count[parent_vertex[v]] + 1
+                && claim[parent_vertex[v]] < 0) {
+            claim[parent_vertex[v]] = v;
+        }
+    }
+    for (t = 0; t < N; ++t) {
+        v = order[t];
+        supernode[v] = claim[v] >= 0 ? supernode[claim[v]] : v;
+    }
+
+    /* 
+     * one clique per supernode, created at the last vertex of the supernode,
+     * so that every clique comes before its parent 
+     */
+    num_cliques = 0;
+    for (t = 0; t < N; ++t) {
+        scs_int rep;
+        v = order[t];
+        if (parent_vertex[v] >= 0 && claim[parent_vertex[v]] == v) continue;
+        rep = supernode[v];
+        clique_of[rep] = num_cliques;
+        clique_size[num_cliques] = count[rep] + 1;
+        merged_into[num_cliques] = -1;
+        clique[num_cliques] = scs_malloc(clique_size[num_cliques] * sizeof (scs_int));
+        if (clique[num_cliques] == SCS_NULL) goto out; /* LCOV_EXCL_LINE */
+        clique[num_cliques][0] = rep;
+        memcpy(clique[num_cliques] + 1, adj[rep].v, count[rep] * sizeof (scs_int));
+        qsort(clique[num_cliques], clique_size[num_cliques], sizeof (scs_int), scs_chordal_compare_int);
+        num_cliques++;
+    }
+    for (t = 0; t < N; ++t) {
+        v = order[t];
+        if (parent_vertex[v] >= 0 && claim[parent_vertex[v]] == v) continue;
+        clique_parent[clique_of[supernode[v]]] =
+                parent_vertex[v] >= 0 ? clique_of[supernode[parent_vertex[v]]] : -1;
+    }
+
+    /* merge cliques with their parents (children are visited first) */
+    num_live = num_cliques;
+    for (k = 0; k < num_cliques; ++k) {
+        scs_int par = clique_parent[k];
+        scs_int sep = 0, res_k, res_par, a, b;
+        while (par >= 0 && merged_into[par] >= 0) par = merged_into[par];
+        clique_parent[k] = par;
+        if (par < 0) continue;
+        for (a = 0, b = 0; a < clique_size[k] && b < clique_size[par];) {
+            if (clique[k][a] == clique[par][b]) sep++;
+            if (clique[k][a] <= clique[par][b]) a++;
+            else b++;
+        }
+        res_k = clique_size[k] - sep;
+        res_par = clique_size[par] - sep;
+        if (res_k * res_par <= SCS_CHORDAL_MERGE_FILL
+                || MAX(res_k, res_par) <= SCS_CHORDAL_MERGE_SIZE) {
+            /* sorted union of the two cliques */
+            scs_int * merged = scs_malloc((clique_size[par] + res_k) * sizeof (scs_int));
+            if (merged == SCS_NULL) {
+                /* LCOV_EXCL_START */
+                num_live = -1;
+                goto out;
+                /* LCOV_EXCL_STOP */
+            }
+            for (a = 0, b = 0, i = 0; a < clique_size[k] || b < clique_size[par];) {
+                if (b == clique_size[par] || (a < clique_size[k] && clique[k][a] < clique[par][b])) {
+                    merged[i++] = clique[k][a++];
+                } else {
+                    if (a < clique_size[k] && clique[k][a] == clique[par][b]) a++;
+                    merged[i++] = clique[par][b++];
+                }
+            }
+            scs_free(clique[par]);
+            scs_free(clique[k]);
+            clique[par] = merged;
+            clique[k] = SCS_NULL;
+            clique_size[par] += res_k;
+            merged_into[k] = par;
+            num_live--;
+        }
+    }
+
+    if (num_live > 1) {
+        new_index = heap; /* reuse workspace */
+        nnz_cliques = 0;
+        j = 0;
+        for (k = 0; k < num_cliques; ++k) {
+            new_index[k] = merged_into[k] < 0 ? j++ : -1;
+            if (merged_into[k] < 0) nnz_cliques += clique_size[k];
+        }
+        block->num_cliques = num_live;
+        block->clique_ptr = scs_malloc((num_live + 1) * sizeof (scs_int));
+        block->clique_vertices = scs_malloc(nnz_cliques * sizeof (scs_int));
+        block->parent = scs_malloc(num_live * sizeof (scs_int));
+        if (block->clique_ptr == SCS_NULL
+                || block->clique_vertices == SCS_NULL
+                || block->parent == SCS_NULL) {
+            /* LCOV_EXCL_START */
+            scs_chordal_free_block(block);
+            num_live = -1;
+            /* LCOV_EXCL_STOP */
+        } else {
+            block->clique_ptr[0] = 0;
+            for (k = 0; k < num_cliques; ++k) {
+                scs_int idx = new_index[k];
+                if (idx < 0) continue;
+                memcpy(block->clique_vertices + block->clique_ptr[idx], clique[k],
+                        clique_size[k] * sizeof (scs_int));
+                block->clique_ptr[idx + 1] = block->clique_ptr[idx] + clique_size[k];
+                block->parent[idx] = clique_parent[k] >= 0 ? new_index[clique_parent[k]] : -1;
+            }
+        }
+    }
+
+out:
+    for (v = 0; v < N; ++v) {
+        scs_free(adj[v].v);
+        scs_free(clique[v]);
+    }
+    scs_free(iwork);
+    scs_free(adj);
+    scs_free(clique);
+    return num_live;
+}
+
+/* sorts the row indices (and values) of a column */
+static void scs_chordal_sort_column(scs_int * RESTRICT rows, scs_float * RESTRICT vals, scs_int len) {
+    scs_int i, j;
+    for (i = 1; i < len; ++i) {
+        scs_int r = rows[i];
+        scs_float x = vals[i];
+        for (j = i; j > 0 && rows[j - 1] > r; --j) {
+            rows[j] = rows[j - 1];
+            vals[j] = vals[j - 1];
+        }
+        rows[j] = r;
+        vals[j] = x;
+    }
+}
+
+static scs_int scs_chordal_block_num_vars(const ScsChordalBlock * RESTRICT block) {
+    scs_int k, num_vars = 0;
+    for (k = 0; k < block->num_cliques; ++k) {
+        num_vars += scs_chordal_tri_size(block->clique_ptr[k + 1] - block->clique_ptr[k]);
+    }
+    return num_vars;
+}
+
+/* builds the row map, the decomposed cone and the decomposed matrix A */
+static scs_int scs_chordal_build_problem(
+        ScsChordal * RESTRICT chordal,
+        const ScsData * RESTRICT data,
+        const ScsCone * RESTRICT cone) {
+    const ScsAMatrix * A = data->A;
+    ScsAMatrix * Ac;
+    ScsCone * kc = chordal->cone;
+    scs_int i, j, k, a, b, row, col, ptr, block_idx, s_idx, num_extra_rows = 0, num_extra_vars = 0;
+    scs_int * row_map = chordal->row_map;
+    scs_int s_offset = cone->f + cone->l + cone->bsize;
+
+    for (i = 0; i < cone->qsize; ++i) {
+        s_offset += cone->q[i];
+    }
+    for (i = 0; i < cone->rqsize; ++i) {
+        s_offset += cone->rq[i];
+    }
+    for (i = 0; i < chordal->m; ++i) {
+        row_map[i] = 0; /* 0: keep in place, 1: keep as equality, -1: drop */
+    }
+    for (i = 0; i < chordal->num_blocks; ++i) {
+        ScsChordalBlock * block = &chordal->blocks[i];
+        const scs_int N = block->size;
+        scs_int * rows = row_map + block->row_offset;
+        for (j = 0; j < scs_chordal_tri_size(N); ++j) {
+            rows[j] = -1;
+        }
+        for (k = 0; k < block->num_cliques; ++k) {
+            const scs_int * C = block->clique_vertices + block->clique_ptr[k];
+            const scs_int c = block->clique_ptr[k + 1] - block->clique_ptr[k];
+            for (b = 0; b < c; ++b) {
+                for (a = b; a < c; ++a) {
+                    rows[scs_chordal_tri_index(N, C[a], C[b])] = 1;
+                }
+            }
+        }
+        for (j = 0; j < scs_chordal_tri_size(N); ++j) {
+            num_extra_rows += rows[j] == 1;
+        }
+        num_extra_vars += scs_chordal_block_num_vars(block);
+    }
+
+    /* cone */
+    kc->f = cone->f + num_extra_rows;
+    kc->l = cone->l;
+    kc->bsize = cone->bsize;
+    kc->qsize = cone->qsize;
+    kc->rqsize = cone->rqsize;
+    kc->ep = cone->ep;
+    kc->ed = cone->ed;
+    kc->psize = cone->psize;
+    kc->ssize = cone->ssize - chordal->num_blocks;
+    for (i = 0; i < chordal->num_blocks; ++i) {
+        kc->ssize += chordal->blocks[i].num_cliques;
+    }
+    kc->q = cone->qsize > 0 ? scs_malloc(cone->qsize * sizeof (scs_int)) : SCS_NULL;
+    kc->rq = cone->rqsize > 0 ? scs_malloc(cone->rqsize * sizeof (scs_int)) : SCS_NULL;
+    kc->s = scs_malloc(kc->ssize * sizeof (scs_int));
+    kc->p = cone->psize > 0 ? scs_malloc(cone->psize * sizeof (scs_float)) : SCS_NULL;
+    kc->bl = cone->bsize > 1 ? scs_malloc((cone->bsize - 1) * sizeof (scs_float)) : SCS_NULL;
+    kc->bu = cone->bsize > 1 ? scs_malloc((cone->bsize - 1) * sizeof (scs_float)) : SCS_NULL;
+    if ((cone->qsize > 0 && kc->q == SCS_NULL) || kc->s == SCS_NULL
+            || (cone->rqsize > 0 && kc->rq == SCS_NULL)
+            || (cone->psize > 0 && kc->p == SCS_NULL)
+            || (cone->bsize > 1 && (kc->bl == SCS_NULL || kc->bu == SCS_NULL))) {
+        return -1; /* LCOV_EXCL_LINE */
+    }
+    if (cone->qsize > 0) memcpy(kc->q, cone->q, cone->qsize * sizeof (scs_int));
+    if (cone->rqsize > 0) memcpy(kc->rq, cone->rq, cone->rqsize * sizeof (scs_int));
+    if (cone->psize > 0) memcpy(kc->p, cone->p, cone->psize * sizeof (scs_float));
+    if (cone->bsize > 1) {
+        memcpy(kc->bl, cone->bl, (cone->bsize - 1) * sizeof (scs_float));
+        memcpy(kc->bu, cone->bu, (cone->bsize - 1) * sizeof (scs_float));
+    }
+
+    /* rows: zero cone, new equalities, LP and SOC rows, PSD cones, the rest */
+    row = 0;
+    for (i = 0; i < cone->f; ++i) {
+        row_map[i] = row++;
+    }
+    for (i = 0; i < chordal->num_blocks; ++i) {
+        ScsChordalBlock * block = &chordal->blocks[i];
+        scs_int * rows = row_map + block->row_offset;
+        for (j = 0; j < scs_chordal_tri_size(block->size); ++j) {
+            if (rows[j] == 1) rows[j] = row++;
+        }
+    }
+    for (i = cone->f; i < s_offset; ++i) {
+        row_map[i] = row++;
+    }
+    i = s_offset;
+    block_idx = 0;
+    s_idx = 0;
+    col = chordal->n;
+    for (j = 0; j < cone->ssize; ++j) {
+        const scs_int tri_size = scs_chordal_tri_size(cone->s[j]);
+        if (block_idx < chordal->num_blocks && chordal->blocks[block_idx].row_offset == i) {
+            ScsChordalBlock * block = &chordal->blocks[block_idx++];
+            const scs_int num_vars = scs_chordal_block_num_vars(block);
+            block->clique_row_offset = row;
+            block->col_offset = col;
+            for (k = 0; k < block->num_cliques; ++k) {
+                kc->s[s_idx++] = block->clique_ptr[k + 1] - block->clique_ptr[k];
+            }
+            row += num_vars;
+            col += num_vars;
+        } else {
+            for (k = 0; k < tri_size; ++k) {
+                row_map[i + k] = row++;
+            }
+            kc->s[s_idx++] = cone->s[j];
+        }
+        i += tri_size;
+    }
+    for (; i < chordal->m; ++i) {
+        row_map[i] = row++;
+    }
+
+    /* matrix A = [A_E H; 0 -I] (up to a permutation of rows) */
+    Ac = scs_calloc(1, sizeof (ScsAMatrix));
+    if (Ac == SCS_NULL) return -1; /* LCOV_EXCL_LINE */
+    chordal->data->A = Ac;
+    Ac->m = row;
+    Ac->n = col;
+    Ac->p = scs_malloc((Ac->n + 1) * sizeof (scs_int));
+    Ac->i = scs_malloc((A->p[A->n] + 2 * num_extra_vars) * sizeof (scs_int));
+    Ac->x = scs_malloc((A->p[A->n] + 2 * num_extra_vars) * sizeof (scs_float));
+    if (Ac->p == SCS_NULL || Ac->i == SCS_NULL || Ac->x == SCS_NULL) {
+        return -1; /* LCOV_EXCL_LINE */
+    }
+    ptr = 0;
+    for (j = 0; j < A->n; ++j) {
+        Ac->p[j] = ptr;
+        for (k = A->p[j]; k < A->p[j + 1]; ++k) {
+            if (row_map[A->i[k]] < 0) continue;
+            Ac->i[ptr] = row_map[A->i[k]];
+            Ac->x[ptr] = A->x[k];
+            ptr++;
+        }
+        scs_chordal_sort_column(Ac->i + Ac->p[j], Ac->x + Ac->p[j], ptr - Ac->p[j]);
+    }
+    col = A->n;
+    for (i = 0; i < chordal->num_blocks; ++i) {
+        ScsChordalBlock * block = &chordal->blocks[i];
+        const scs_int N = block->size;
+        scs_int offset = 0;
+        for (k = 0; k < block->num_cliques; ++k) {
+            const scs_int * C = block->clique_vertices + block->clique_ptr[k];
+            const scs_int c = block->clique_ptr[k + 1] - block->clique_ptr[k];
+            for (b = 0; b < c; ++b) {
+                for (a = b; a < c; ++a) {
+                    Ac->p[col++] = ptr;
+                    Ac->i[ptr] = row_map[block->row_offset + scs_chordal_tri_index(N, C[a], C[b])];
+                    Ac->x[ptr++] = 1.0;
+                    Ac->i[ptr] = block->clique_row_offset + offset + scs_chordal_tri_index(c, a, b);
+                    Ac->x[ptr++] = -1.0;
+                }
+            }
+            offset += scs_chordal_tri_size(c);
+        }
+    }
+    Ac->p[col] = ptr;
+
+    chordal->data->m = Ac->m;
+    chordal->data->n = Ac->n;
+    return 0;
+}
+
+/* the quadratic cost does not involve the new variables, so P is padded with zeros */
+static scs_int scs_chordal_build_quadratic_cost(
+        ScsChordal * RESTRICT chordal,
+        const ScsAMatrix * RESTRICT P) {
+    scs_int j;
+    const scs_int n = chordal->data->n;
+    const scs_int nnz = P->p[P->n];
+    ScsAMatrix * Pc = scs_calloc(1, sizeof (ScsAMatrix));
+    if (Pc == SCS_NULL) {
+        return -1; /* LCOV_EXCL_LINE */
+    }
+    chordal->data->P = Pc;
+    Pc->m = n;
+    Pc->n = n;
+    Pc->p = scs_malloc((n + 1) * sizeof (scs_int));
+    Pc->i = scs_malloc(nnz * sizeof (scs_int));
+    Pc->x = scs_malloc(nnz * sizeof (scs_float));
+    if (Pc->p == SCS_NULL || (nnz > 0 && (Pc->i == SCS_NULL || Pc->x == SCS_NULL))) {
+        return -1; /* LCOV_EXCL_LINE */
+    }
+    memcpy(Pc->p, P->p, (P->n + 1) * sizeof (scs_int));
+    for (j = P->n + 1; j <= n; ++j) {
+        Pc->p[j] = nnz;
+    }
+    if (nnz > 0) {
+        memcpy(Pc->i, P->i, nnz * sizeof (scs_int));
+        memcpy(Pc->x, P->x, nnz * sizeof (scs_float));
+    }
+    return 0;
+}
+
+ScsChordal *scs_chordal_init(
+        const ScsData * RESTRICT data,
+        const ScsCone * RESTRICT cone) {
+    ScsChordal * chordal;
+    char * pattern;
+    scs_int i, k, row, status;
+    const scs_int m = data->m;
+    const scs_int n = data->n;
+    const ScsAMatrix * A = data->A;
+
+    if (cone->ssize == 0 || cone->s == SCS_NULL) {
+        return SCS_NULL;
+    }
+
+    pattern = scs_calloc(m, sizeof (char));
+    chordal = scs_calloc(1, sizeof (*chordal));
+    if (pattern == SCS_NULL || chordal == SCS_NULL) {
+        /* LCOV_EXCL_START */
+        scs_free(pattern);
+        scs_free(chordal);
+        return SCS_NULL;
+        /* LCOV_EXCL_STOP */
+    }
+    chordal->m = m;
+    chordal->n = n;
+    chordal->blocks = scs_calloc(cone->ssize, sizeof (ScsChordalBlock));
+    if (chordal->blocks == SCS_NULL) {
+        /* LCOV_EXCL_START */
+        scs_free(pattern);
+        scs_chordal_free(chordal);
+        return SCS_NULL;
+        /* LCOV_EXCL_STOP */
+    }
+
+    /* aggregate sparsity pattern of A and b */
+    for (k = 0; k < A->p[n]; ++k) {
+        pattern[A->i[k]] = 1;
+    }
+    for (i = 0; i < m; ++i) {
+        if (data->b[i] != 0.0) pattern[i] = 1;
+    }
+
+    row = cone->f + cone->l + cone->bsize;
+    for (i = 0; i < cone->qsize; ++i) {
+        row += cone->q[i];
+    }
+    for (i = 0; i < cone->rqsize; ++i) {
+        row += cone->rq[i];
+    }
+    for (i = 0; i < cone->ssize; ++i) {
+        ScsChordalBlock * block = &chordal->blocks[chordal->num_blocks];
+        if (cone->s[i] >= SCS_CHORDAL_MIN_SIZE) {
+            block->size = cone->s[i];
+            block->row_offset = row;
+            status = scs_chordal_analyse_block(block, pattern + row);
+            if (status < 0) {
+                /* LCOV_EXCL_START */
+                scs_free(pattern);
+                scs_chordal_free(chordal);
+                return SCS_NULL;
+                /* LCOV_EXCL_STOP */
+            }
+            if (status > 1) chordal->num_blocks++;
+        }
+        row += scs_chordal_tri_size(cone->s[i]);
+    }
+    scs_free(pattern);
+
+    if (chordal->num_blocks == 0) {
+        scs_chordal_free(chordal);
+        return SCS_NULL;
+    }
+
+    chordal->row_map = scs_malloc(m * sizeof (scs_int));
+    chordal->data = scs_calloc(1, sizeof (ScsData));
+    chordal->cone = scs_calloc(1, sizeof (ScsCone));
+    chordal->sol = scs_calloc(1, sizeof (ScsSolution));
+    if (chordal->row_map == SCS_NULL || chordal->data == SCS_NULL
+            || chordal->cone == SCS_NULL || chordal->sol == SCS_NULL
+            || scs_chordal_build_problem(chordal, data, cone) < 0) {
+        /* LCOV_EXCL_START */
+        scs_chordal_free(chordal);
+        return SCS_NULL;
+        /* LCOV_EXCL_STOP */
+    }
+    chordal->data->stgs = data->stgs;
+    if (data->P != SCS_NULL && scs_chordal_build_quadratic_cost(chordal, data->P) < 0) {
+        /* LCOV_EXCL_START */
+        scs_chordal_free(chordal);
+        return SCS_NULL;
+        /* LCOV_EXCL_STOP */
+    }
+    chordal->data->b = scs_calloc(chordal->data->m, sizeof (scs_float));
+    chordal->data->c = scs_calloc(chordal->data->n, sizeof (scs_float));
+    chordal->sol->x = scs_calloc(chordal->data->n, sizeof (scs_float));
+    chordal->sol->y = scs_calloc(chordal->data->m, sizeof (scs_float));
+    chordal->sol->s = scs_calloc(chordal->data->m, sizeof (scs_float));
+    if (chordal->data->b == SCS_NULL || chordal->data->c == SCS_NULL
+            || chordal->sol->x == SCS_NULL || chordal->sol->y == SCS_NULL
+            || chordal->sol->s == SCS_NULL) {
+        /* LCOV_EXCL_START */
+        scs_chordal_free(chordal);
+        return SCS_NULL;
+        /* LCOV_EXCL_STOP */
+    }
+    scs_chordal_update_data(chordal, data);
+    return chordal;
+}
+
+scs_int scs_chordal_update_data(
+        ScsChordal * RESTRICT chordal,
+        const ScsData * RESTRICT data) {
+    scs_int i;
+    ScsData * dc = chordal->data;
+    memset(dc->b, 0, dc->m * sizeof (scs_float));
+    for (i = 0; i < chordal->m; ++i) {
+        if (chordal->row_map[i] >= 0) {
+            dc->b[chordal->row_map[i]] = data->b[i];
+        } else if (data->b[i] != 0.0) {
+            /* the row was dropped: b_i is outside the sparsity pattern */
+            return -1;
+        }
+    }
+    memcpy(dc->c, data->c, chordal->n * sizeof (scs_float));
+    memset(dc->c + chordal->n, 0, (dc->n - chordal->n) * sizeof (scs_float));
+    return 0;
+}
+
+void scs_chordal_lift_solution(
+        ScsChordal * RESTRICT chordal,
+        const ScsSolution * RESTRICT sol) {
+    scs_int i, k, a, b, max_size = 0;
+    ScsSolution * sc = chordal->sol;
+    char * assigned;
+
+    if (sol->x == SCS_NULL || sol->y == SCS_NULL || sol->s == SCS_NULL) {
+        return;
+    }
+    for (i = 0; i < chordal->num_blocks; ++i) {
+        max_size = MAX(max_size, chordal->blocks[i].size);
+    }
+    assigned = scs_malloc(scs_chordal_tri_size(max_size) * sizeof (char));
+    if (assigned == SCS_NULL) {
+        return; /* LCOV_EXCL_LINE */
+    }
+    memset(sc->x, 0, chordal->data->n * sizeof (scs_float));
+    memcpy(sc->x, sol->x, chordal->n * sizeof (scs_float));
+    for (i = 0; i < chordal->m; ++i) {
+        if (chordal->row_map[i] >= 0) {
+            sc->y[chordal->row_map[i]] = sol->y[i];
+            sc->s[chordal->row_map[i]] = sol->s[i];
+        }
+    }
+    /* every entry of s is assigned to the first clique which contains it */
+    for (i = 0; i < chordal->num_blocks; ++i) {
+        const ScsChordalBlock * block = &chordal->blocks[i];
+        const scs_int N = block->size;
+        const scs_int * rows = chordal->row_map + block->row_offset;
+        scs_int offset = 0;
+        memset(assigned, 0, scs_chordal_tri_size(N) * sizeof (char));
+        for (k = 0; k < block->num_cliques; ++k) {
+            const scs_int * C = block->clique_vertices + block->clique_ptr[k];
+            const scs_int c = block->clique_ptr[k + 1] - block->clique_ptr[k];
+            for (b = 0; b < c; ++b) {
+                for (a = b; a < c; ++a) {
+                    const scs_int g = scs_chordal_tri_index(N, C[a], C[b]);
+                    const scs_int idx = offset + scs_chordal_tri_index(c, a, b);
+                    const scs_float s_g = assigned[g] ? 0.0 : sol->s[block->row_offset + g];
+                    assigned[g] = 1;
+                    sc->x[block->col_offset + idx] = s_g;
+                    sc->s[block->clique_row_offset + idx] = s_g;
+                    sc->y[block->clique_row_offset + idx] = sol->y[block->row_offset + g];
+                    sc->s[rows[g]] = 0.0;
+                }
+            }
+            offset += scs_chordal_tri_size(c);
+        }
+    }
+    scs_free(assigned);
+}
+
+/* in-place Cholesky factorization of the (regularized) n-by-n matrix L */
+static void scs_chordal_cholesky(scs_float * RESTRICT L, scs_int n, scs_float reg) {
+    scs_int i, j, k;
+    for (j = 0; j < n; ++j) {
+        scs_float d = L[j * n + j] + reg;
+        for (k = 0; k < j; ++k) {
+            d -= L[j * n + k] * L[j * n + k];
+        }
+        L[j * n + j] = SQRTF(MAX(d, reg));
+        for (i = j + 1; i < n; ++i) {
+            scs_float x = L[i * n + j];
+            for (k = 0; k < j; ++k) {
+                x -= L[i * n + k] * L[j * n + k];
+            }
+            L[i * n + j] = x / L[j * n + j];
+        }
+    }
+}
+
+/* solves (L L') z = z */
+static void scs_chordal_cholesky_solve(const scs_float * RESTRICT L, scs_float * RESTRICT z, scs_int n) {
+    scs_int i, k;
+    for (i = 0; i < n; ++i) {
+        for (k = 0; k < i; ++k) {
+            z[i] -= L[i * n + k] * z[k];
+        }
+        z[i] /= L[i * n + i];
+    }
+    for (i = n - 1; i >= 0; --i) {
+        for (k = i + 1; k < n; ++k) {
+            z[i] -= L[k * n + i] * z[k];
+        }
+        z[i] /= L[i * n + i];
+    }
+}
+
+/*
+ * Positive semidefinite completion of the partial matrix Y, which is specified
+ * on the cliques of the block. Cliques are visited from the roots of the clique
+ * tree to the leaves; the residual vertices nu of every clique are connected
+ * to all previously visited vertices alpha through its separator eta:
+ * 
+ *  Y(nu, alpha) = Y(nu, eta) Y(eta, eta)^{-1} Y(eta, alpha).
+ */
+static void scs_chordal_complete(
+        const ScsChordalBlock * RESTRICT block,
+        scs_float * RESTRICT Y,
+        scs_float * RESTRICT L,
+        scs_float * RESTRICT z,
+        scs_int * RESTRICT iwork) {
+    const scs_int N = block->size;
+    scs_int * visited = iwork;
+    scs_int * eta = visited + N;
+    scs_int * nu = eta + N;
+    scs_int * alpha = nu + N;
+    scs_int * status = alpha + N; /* 0: not visited, 1: visited, 2: in clique */
+    scs_int i, j, k, num_visited = 0, num_eta, num_nu, num_alpha;
+    scs_float reg = 1.0;
+
+    for (i = 0; i < N; ++i) {
+        status[i] = 0;
+        reg = MAX(reg, ABS(Y[i * N + i]));
+    }
+    reg *= SCS_CHORDAL_COMPLETION_REG;
+
+    for (k = block->num_cliques - 1; k >= 0; --k) {
+        const scs_int * C = block->clique_vertices + block->clique_ptr[k];
+        const scs_int c = block->clique_ptr[k + 1] - block->clique_ptr[k];
+        num_eta = 0;
+        num_nu = 0;
+        num_alpha = 0;
+        for (i = 0; i < c; ++i) {
+            if (status[C[i]] == 1) {
+                eta[num_eta++] = C[i];
+                status[C[i]] = 2;
+            } else {
+                nu[num_nu++] = C[i];
+            }
+        }
+        for (i = 0; i < num_visited; ++i) {
+            if (status[visited[i]] == 1) alpha[num_alpha++] = visited[i];
+        }
+        if (num_eta > 0 && num_alpha > 0) {
+            for (i = 0; i < num_eta; ++i) {
+                for (j = 0; j < num_eta; ++j) {
+                    L[i * num_eta + j] = Y[eta[i] * N + eta[j]];
+                }
+            }
+            scs_chordal_cholesky(L, num_eta, reg);
+            for (j = 0; j < num_alpha; ++j) {
+                const scs_int a = alpha[j];
+                for (i = 0; i < num_eta; ++i) {
+                    z[i] = Y[eta[i] * N + a];
+                }
+                scs_chordal_cholesky_solve(L, z, num_eta);
+                for (i = 0; i < num_nu; ++i) {
+                    scs_int e;
+                    scs_float y_va = 0.0;
+                    for (e = 0; e < num_eta; ++e) {
+                        y_va += Y[nu[i] * N + eta[e]] * z[e];
+                    }
+                    Y[nu[i] * N + a] = y_va;
+                    Y[a * N + nu[i]] = y_va;
+                }
+            }
+        }
+        for (i = 0; i < num_eta; ++i) {
+            status[eta[i]] = 1;
+        }
+        for (i = 0; i < num_nu; ++i) {
+            status[nu[i]] = 1;
+            visited[num_visited++] = nu[i];
+        }
+    }
+}
+
+scs_int scs_chordal_recover_solution(
+        const ScsChordal * RESTRICT chordal,
+        ScsSolution * RESTRICT sol) {
+    const ScsSolution * sc = chordal->sol;
+    const scs_float sqrt2 = SQRTF(2.0);
+    scs_int i, j, k, a, b, max_size = 0;
+    scs_float *Y, *L, *z;
+    scs_int *iwork;
+
+    if (sol->x == SCS_NULL) sol->x = scs_malloc(chordal->n * sizeof (scs_float));
+    if (sol->y == SCS_NULL) sol->y = scs_malloc(chordal->m * sizeof (scs_float));
+    if (sol->s == SCS_NULL) sol->s = scs_malloc(chordal->m * sizeof (scs_float));
+    for (i = 0; i < chordal->num_blocks; ++i) {
+        max_size = MAX(max_size, chordal->blocks[i].size);
+    }
+    Y = scs_malloc((2 * max_size * max_size + max_size) * sizeof (scs_float));
+    iwork = scs_malloc(5 * max_size * sizeof (scs_int));
+    if (sol->x == SCS_NULL || sol->y == SCS_NULL || sol->s == SCS_NULL
+            || Y == SCS_NULL || iwork == SCS_NULL) {
+        /* LCOV_EXCL_START */
+        scs_free(Y);
+        scs_free(iwork);
+        return -1;
+        /* LCOV_EXCL_STOP */
+    }
+    L = Y + max_size * max_size;
+    z = L + max_size * max_size;
+
+    memcpy(sol->x, sc->x, chordal->n * sizeof (scs_float));
+    for (i = 0; i < chordal->m; ++i) {
+        if (chordal->row_map[i] >= 0) {
+            sol->y[i] = sc->y[chordal->row_map[i]];
+            sol->s[i] = sc->s[chordal->row_map[i]];
+        }
+    }
+
+    for (i = 0; i < chordal->num_blocks; ++i) {
+        const ScsChordalBlock * block = &chordal->blocks[i];
+        const scs_int N = block->size;
+        const scs_int * rows = chordal->row_map + block->row_offset;
+        scs_float * s_block = sol->s + block->row_offset;
+        scs_float * y_block = sol->y + block->row_offset;
+        scs_int offset = 0;
+
+        /* s = sum of the clique slacks */
+        memset(s_block, 0, scs_chordal_tri_size(N) * sizeof (scs_float));
+        for (k = 0; k < block->num_cliques; ++k) {
+            const scs_int * C = block->clique_vertices + block->clique_ptr[k];
+            const scs_int c = block->clique_ptr[k + 1] - block->clique_ptr[k];
+            for (b = 0; b < c; ++b) {
+                for (a = b; a < c; ++a) {
+                    s_block[scs_chordal_tri_index(N, C[a], C[b])] +=
+                            sc->s[block->clique_row_offset + offset + scs_chordal_tri_index(c, a, b)];
+                }
+            }
+            offset += scs_chordal_tri_size(c);
+        }
+
+        /* y is a PSD completion of the dual variables of the equalities */
+        memset(Y, 0, N * N * sizeof (scs_float));
+        for (b = 0; b < N; ++b) {
+            for (a = b; a < N; ++a) {
+                const scs_int g = scs_chordal_tri_index(N, a, b);
+                if (rows[g] >= 0) {
+                    const scs_float y_ab = a == b ? sc->y[rows[g]] : sc->y[rows[g]] / sqrt2;
+                    Y[a * N + b] = y_ab;
+                    Y[b * N + a] = y_ab;
+                }
+            }
+        }
+        scs_chordal_complete(block, Y, L, z, iwork);
+        for (b = 0; b < N; ++b) {
+            for (a = b; a < N; ++a) {
+                j = scs_chordal_tri_index(N, a, b);
+                y_block[j] = a == b ? Y[a * N + b] : Y[a * N + b] * sqrt2;
+            }
+        }
+    }
+
+    scs_free(Y);
+    scs_free(iwork);
+    return 0;
+}
+
+void scs_chordal_free(ScsChordal * RESTRICT chordal) {
+    scs_int i;
+    if (chordal == SCS_NULL) {
+        return;
+    }
+    if (chordal->blocks != SCS_NULL) {
+        for (i = 0; i < chordal->num_blocks; ++i) {
+            scs_chordal_free_block(&chordal->blocks[i]);
+        }
+        scs_free(chordal->blocks);
+    }
+    if (chordal->data != SCS_NULL) {
+        if (chordal->data->A != SCS_NULL) {
+            scs_free(chordal->data->A->x);
+            scs_free(chordal->data->A->i);
+            scs_free(chordal->data->A->p);
+            scs_free(chordal->data->A);
+        }
+        if (chordal->data->P != SCS_NULL) {
+            scs_free(chordal->data->P->x);
+            scs_free(chordal->data->P->i);
+            scs_free(chordal->data->P->p);
+            scs_free(chordal->data->P);
+        }
+        scs_free(chordal->data->b);
+        scs_free(chordal->data->c);
+        scs_free(chordal->data);
+    }
+    if (chordal->cone != SCS_NULL) {
+        scs_free(chordal->cone->q);
+        scs_free(chordal->cone->rq);
+        scs_free(chordal->cone->s);
+        scs_free(chordal->cone->p);
+        scs_free(chordal->cone->bl);
+        scs_free(chordal->cone->bu);
+        scs_free(chordal->cone);
+    }
+    if (chordal->sol != SCS_NULL) {
+        scs_free(chordal->sol->x);
+        scs_free(chordal->sol->y);
+        scs_free(chordal->sol->s);
+        scs_free(chordal->sol);
+    }
+    scs_free(chordal->row_map);
+    scs_free(chordal);
+}
@@ -30,9 +30,11 @@
 
 #define CONE_RATE (2)
 #define CONE_TOL (1e-8)
+#define CONE_TOL_MAX (1e-2)
 #define CONE_THRESH (1e-6)
 #define EXP_CONE_MAX_ITERS (100)
 #define POW_CONE_MAX_ITERS (20)
+#define BOX_CONE_MAX_ITERS (100)
 
 #ifdef LAPACK_LIB_FOUND
 extern void BLAS(syevr)(const char *jobz, const char *range, const char *uplo,
@@ -49,6 +51,28 @@ extern void BLAS(scal)(const blasint *n, const scs_float *sa, scs_float *sx,
 extern scs_float BLAS(nrm2)(const blasint *n, scs_float *x, const blasint *incx);
 #endif
 
+/*
+ * tolerance of the iterative cone projections at iteration iter, which
+ * decreases like (1/iter)^CONE_RATE, so the errors are summable, and is
+ * at most CONE_TOL_MAX, so that the first iterations are not projected
+ * arbitrarily coarsely; iter < 0 means exact projection
+ */
+static scs_float getConeTol(scs_int iter) {
+    return iter < 0 ? CONE_TOL
+            : MIN(CONE_TOL_MAX, MAX(CONE_TOL, 1 / POWF((iter + 1), CONE_RATE)));
+}
+
+/*
+ * time (in ms) elapsed since the previous lap (whose timestamp is last),
+ * used to split the time of a projection among the different types of cones
+ */
+static scs_float coneTimerLap(ScsTimer * RESTRICT timer, scs_float * RESTRICT last) {
+    scs_float now = scs_toc_quiet(timer);
+    scs_float lap = now - *last;
+    *last = now;
+    return lap;
+}
+
 static scs_int getSdConeSize(scs_int s) {
     return (s * (s + 1)) / 2;
 }
@@ -64,14 +88,22 @@ scs_int scs_get_cone_boundaries(
         const ScsCone * RESTRICT k,
         scs_int * * RESTRICT boundaries) {
     scs_int i, count = 0;
-    scs_int len = 1 + k->qsize + k->ssize + k->ed + k->ep + k->psize;
+    scs_int len = 1 + (k->bsize > 0) + k->qsize + k->rqsize + k->ssize + k->ed + k->ep + k->psize;
     scs_int *RESTRICT b = scs_malloc(sizeof (scs_int) * len);
     b[count] = k->f + k->l;
     count += 1;
+    if (k->bsize > 0) {
+        b[count] = k->bsize;
+        count += 1;
+    }
     if (k->qsize > 0) {
         memcpy(&b[count], k->q, k->qsize * sizeof (scs_int));
     }
     count += k->qsize;
+    if (k->rqsize > 0) {
+        memcpy(&b[count], k->rq, k->rqsize * sizeof (scs_int));
+    }
+    count += k->rqsize;
     for (i = 0; i < k->ssize; ++i) {
         b[count + i] = getSdConeSize(k->s[i]);
     }
@@ -94,11 +126,18 @@ static scs_int getFullConeDims(const ScsCone *RESTRICT k) {
         c += k->f;
     if (k->l)
         c += k->l;
+    if (k->bsize)
+        c += k->bsize;
     if (k->qsize && k->q) {
         for (i = 0; i < k->qsize; ++i) {
             c += k->q[i];
         }
     }
+    if (k->rqsize && k->rq) {
+        for (i = 0; i < k->rqsize; ++i) {
+            c += k->rq[i];
+        }
+    }
     if (k->ssize && k->s) {
         for (i = 0; i < k->ssize; ++i) {
             c += getSdConeSize(k->s[i]);
@@ -128,6 +167,18 @@ scs_int scs_validate_cones(const ScsData * RESTRICT d, const ScsCone * RESTRICT
         scs_printf("lp cone error\n");
         return -1;
     }
+    if (k->bsize) {
+        if (k->bsize < 0 || (k->bsize > 1 && (k->bl == SCS_NULL || k->bu == SCS_NULL))) {
+            scs_printf("box cone error\n");
+            return -1;
+        }
+        for (i = 0; i < k->bsize - 1; ++i) {
+            if (!(k->bl[i] <= k->bu[i])) {
+                scs_printf("box cone error, lower bound exceeds upper bound\n");
+                return -1;
+            }
+        }
+    }
     if (k->qsize && k->q) {
         if (k->qsize < 0) {
             scs_printf("soc cone error\n");
@@ -140,6 +191,18 @@ scs_int scs_validate_cones(const ScsData * RESTRICT d, const ScsCone * RESTRICT
             }
         }
     }
+    if (k->rqsize) {
+        if (k->rqsize < 0 || k->rq == SCS_NULL) {
+            scs_printf("rotated soc cone error\n");
+            return -1;
+        }
+        for (i = 0; i < k->rqsize; ++i) {
+            if (k->rq[i] < 2) {
+                scs_printf("rotated soc cone error, dimensions must be at least 2\n");
+                return -1;
+            }
+        }
+    }
     if (k->ssize && k->s) {
         if (k->ssize < 0) {
             scs_printf("sd cone error\n");
@@ -176,13 +239,145 @@ scs_int scs_validate_cones(const ScsData * RESTRICT d, const ScsCone * RESTRICT
 }
 
 char *scs_get_cone_summary(const ScsInfo * RESTRICT info, ScsConeWork * RESTRICT c) {
-    char *str = scs_malloc(sizeof (char) * 64);
+    char *str = scs_malloc(sizeof (char) * 1024);
     sprintf(str, "\tCones: avg projection time: %1.2es\n",
-            c->total_cone_time / (info->iter + 1) / 1e3);
-    c->total_cone_time = 0.0;
+            info->cone_time_ms / (info->iter + 1) / 1e3);
+    if (info->cone_lp_projections > 0) {
+        sprintf(str + strlen(str), "\tLP cones: time: %1.2es, projections: %li\n",
+                info->cone_lp_time_ms / 1e3, (long) info->cone_lp_projections);
+    }
+    if (info->cone_box_projections > 0) {
+        sprintf(str + strlen(str), "\tBox cones: time: %1.2es, projections: %li\n",
+                info->cone_box_time_ms / 1e3, (long) info->cone_box_projections);
+    }
+    if (info->cone_soc_projections > 0) {
+        sprintf(str + strlen(str), "\tSOC cones: time: %1.2es, projections: %li\n",
+                info->cone_soc_time_ms / 1e3, (long) info->cone_soc_projections);
+    }
+    if (info->cone_psd_projections > 0) {
+        sprintf(str + strlen(str), "\tPSD cones: time: %1.2es, projections: %li, "
+                "eigenpairs: %li\n", info->cone_psd_time_ms / 1e3,
+                (long) info->cone_psd_projections, (long) info->cone_psd_eigenpairs);
+    }
+    if (info->cone_exp_projections > 0) {
+        sprintf(str + strlen(str), "\tExp cones: time: %1.2es, projections: %li, "
+                "avg iterations: %2.2f\n", info->cone_exp_time_ms / 1e3,
+                (long) info->cone_exp_projections, info->cone_exp_avg_iters);
+    }
+    if (info->cone_pow_projections > 0) {
+        sprintf(str + strlen(str), "\tPower cones: time: %1.2es, projections: %li, "
+                "avg Newton iterations: %2.2f\n", info->cone_pow_time_ms / 1e3,
+                (long) info->cone_pow_projections, info->cone_pow_avg_iters);
+    }
     return str;
 }
 
+void scs_reset_cone_stats(ScsConeWork * RESTRICT c) {
+    c->total_cone_time = 0.0;
+    c->lp_time = 0.0;
+    c->box_time = 0.0;
+    c->soc_time = 0.0;
+    c->psd_time = 0.0;
+    c->exp_time = 0.0;
+    c->pow_time = 0.0;
+    c->lp_projections = 0;
+    c->box_projections = 0;
+    c->soc_projections = 0;
+    c->psd_projections = 0;
+    c->exp_projections = 0;
+    c->pow_projections = 0;
+    c->exp_iterative = 0;
+    c->exp_iters = 0;
+    c->pow_iterative = 0;
+    c->pow_newton_iters = 0;
+    c->psd_eigenpairs = 0;
+}
+
+void scs_set_cone_stats(const ScsConeWork * RESTRICT c, ScsInfo * RESTRICT info) {
+    info->cone_time_ms = c->total_cone_time;
+    info->cone_lp_time_ms = c->lp_time;
+    info->cone_box_time_ms = c->box_time;
+    info->cone_soc_time_ms = c->soc_time;
+    info->cone_psd_time_ms = c->psd_time;
+    info->cone_exp_time_ms = c->exp_time;
+    info->cone_pow_time_ms = c->pow_time;
+    info->cone_lp_projections = c->lp_projections;
+    info->cone_box_projections = c->box_projections;
+    info->cone_soc_projections = c->soc_projections;
+    info->cone_psd_projections = c->psd_projections;
+    info->cone_exp_projections = c->exp_projections;
+    info->cone_pow_projections = c->pow_projections;
+    info->cone_psd_eigenpairs = c->psd_eigenpairs;
+    info->cone_exp_avg_iters = c->exp_iterative > 0
+            ? (scs_float) c->exp_iters / c->exp_iterative : 0.0;
+    info->cone_pow_avg_iters = c->pow_iterative > 0
+            ? (scs_float) c->pow_newton_iters / c->pow_iterative : 0.0;
+}
+
+void scs_add_cone_stats(ScsConeWork * RESTRICT c, const ScsConeWork * RESTRICT other) {
+    c->total_cone_time += other->total_cone_time;
+    c->lp_time += other->lp_time;
+    c->box_time += other->box_time;
+    c->soc_time += other->soc_time;
+    c->psd_time += other->psd_time;
+    c->exp_time += other->exp_time;
+    c->pow_time += other->pow_time;
+    c->lp_projections += other->lp_projections;
+    c->box_projections += other->box_projections;
+    c->soc_projections += other->soc_projections;
+    c->psd_projections += other->psd_projections;
+    c->exp_projections += other->exp_projections;
+    c->pow_projections += other->pow_projections;
+    c->exp_iterative += other->exp_iterative;
+    c->exp_iters += other->exp_iters;
+    c->pow_iterative += other->pow_iterative;
+    c->pow_newton_iters += other->pow_newton_iters;
+    c->psd_eigenpairs += other->psd_eigenpairs;
+}
+
+scs_int scs_cone_warm_start_size(const ScsCone * RESTRICT k) {
+    return k->ep + k->ed + k->psize + 1;
+}
+
+void scs_get_cone_warm_start(
+        const ScsConeWork * RESTRICT c,
+        const ScsCone * RESTRICT k,
+        scs_float * RESTRICT ws) {
+    if (c->exp_rho != SCS_NULL) {
+        memcpy(ws, c->exp_rho, (k->ep + k->ed) * sizeof (scs_float));
+    }
+    if (c->pow_r != SCS_NULL) {
+        memcpy(ws + k->ep + k->ed, c->pow_r, k->psize * sizeof (scs_float));
+    }
+    ws[k->ep + k->ed + k->psize] = c->box_t;
+}
+
+void scs_set_cone_warm_start(
+        ScsConeWork * RESTRICT c,
+        const ScsCone * RESTRICT k,
+        const scs_float * RESTRICT ws) {
+    if (c->exp_rho != SCS_NULL) {
+        memcpy(c->exp_rho, ws, (k->ep + k->ed) * sizeof (scs_float));
+    }
+    if (c->pow_r != SCS_NULL) {
+        memcpy(c->pow_r, ws + k->ep + k->ed, k->psize * sizeof (scs_float));
+    }
+    c->box_t = ws[k->ep + k->ed + k->psize];
+}
+
+void scs_copy_cone_warm_start(
+        ScsConeWork * RESTRICT c,
+        const ScsConeWork * RESTRICT other,
+        const ScsCone * RESTRICT k) {
+    if (c->exp_rho != SCS_NULL) {
+        memcpy(c->exp_rho, other->exp_rho, (k->ep + k->ed) * sizeof (scs_float));
+    }
+    if (c->pow_r != SCS_NULL) {
+        memcpy(c->pow_r, other->pow_r, k->psize * sizeof (scs_float));
+    }
+    c->box_t = other->box_t;
+}
+
 void scs_finish_cone(ScsConeWork * RESTRICT c) {
 #ifdef LAPACK_LIB_FOUND
     scs_free(c->Xs);
@@ -191,6 +386,14 @@ void scs_finish_cone(ScsConeWork * RESTRICT c) {
     scs_free(c->work);
     scs_free(c->iwork);
 #endif
+    scs_free(c->exp_rho);
+    scs_free(c->exp_v);
+    scs_free(c->exp_idx);
+    scs_free(c->pow_v);
+    scs_free(c->pow_proj);
+    scs_free(c->pow_r);
+    scs_free(c->pow_idx);
+    scs_free(c->box_v);
     scs_free(c);
 }
 
@@ -205,6 +408,9 @@ char *scs_get_cone_header(const ScsCone * RESTRICT k) {
     if (k->l) {
         sprintf(tmp + strlen(tmp), "\tlinear vars: %li\n", (long) k->l);
     }
+    if (k->bsize) {
+        sprintf(tmp + strlen(tmp), "\tbox cone vars: %li\n", (long) k->bsize);
+    }
     socVars = 0;
     socBlks = 0;
     if (k->qsize && k->q) {
@@ -215,6 +421,14 @@ char *scs_get_cone_header(const ScsCone * RESTRICT k) {
         sprintf(tmp + strlen(tmp), "\tsoc vars: %li, soc blks: %li\n",
                 (long) socVars, (long) socBlks);
     }
+    if (k->rqsize && k->rq) {
+        socVars = 0;
+        for (i = 0; i < k->rqsize; i++) {
+            socVars += k->rq[i];
+        }
+        sprintf(tmp + strlen(tmp), "\trotated soc vars: %li, rotated soc blks: %li\n",
+                (long) socVars, (long) k->rqsize);
+    }
     sdVars = 0;
     sdBlks = 0;
     if (k->ssize && k->s) {
@@ -281,61 +495,128 @@ static scs_float expCalcGrad(scs_float * RESTRICT v, scs_float * RESTRICT x, scs
     return x[0] + x[1] * log(x[1] / x[2]);
 }
 
-static void expGetRhoUb(scs_float * RESTRICT v, scs_float * RESTRICT x, scs_float * RESTRICT ub, scs_float *lb) {
-    *lb = 0;
-    *ub = 0.125;
-    while (expCalcGrad(v, x, *ub) > 0) {
-        *lb = *ub;
-        (*ub) *= 2;
+/*
+ * brackets the root of the gradient wrt the dual variable, which is decreasing
+ * in rho, starting from the guess rho > 0; on exit g(lb) > 0 >= g(ub), unless
+ * lb = 0, in which case g_lb is set to INFINITY (g is not defined at 0)
+ */
+static void expBracketRho(scs_float * RESTRICT v, scs_float * RESTRICT x,
+        scs_float rho, scs_float * RESTRICT lb, scs_float * RESTRICT ub,
+        scs_float * RESTRICT g_lb, scs_float * RESTRICT g_ub) {
+    scs_float g = expCalcGrad(v, x, rho);
+    if (g > 0) {
+        *lb = rho;
+        *g_lb = g;
+        *ub = 2 * rho;
+        while ((g = expCalcGrad(v, x, *ub)) > 0) {
+            *lb = *ub;
+            *g_lb = g;
+            (*ub) *= 2;
+        }
+        *g_ub = g;
+    } else {
+        *ub = rho;
+        *g_ub = g;
+        *lb = rho / 2;
+        while ((g = expCalcGrad(v, x, *lb)) <= 0) {
+            *ub = *lb;
+            *g_ub = g;
+            (*lb) /= 2;
+            if (*lb < CONE_TOL) {
+                *lb = 0;
+                *g_lb = INFINITY;
+                return;
+            }
+        }
+        *g_lb = g;
     }
 }
 
-/* project onto the exponential cone, v has dimension *exactly* 3 */
-static scs_int projExpCone(scs_float * RESTRICT v, scs_int iter) {
-    scs_int i;
-    scs_float ub, lb, rho, g, x[3];
-    scs_float r = v[0], s = v[1], t = v[2];
-    scs_float tol = CONE_TOL; /* iter < 0 ? CONE_TOL : MAX(CONE_TOL, 1 /
-                                 POWF((iter + 1), CONE_RATE)); */
-
+/*
+ * projects (r, s, t) onto the exponential cone if the projection is available
+ * in closed form and returns 0, otherwise returns 1 and leaves (r, s, t) intact
+ */
+static scs_int expProjectClosedForm(scs_float * RESTRICT r, scs_float * RESTRICT s,
+        scs_float * RESTRICT t) {
     /* v in cl(Kexp) */
-    if ((s > 0 && s * exp(r / s) - t <= CONE_THRESH) ||
-            (r <= 0 && s == 0 && t >= 0)) {
+    if ((*s > 0 && *s * exp(*r / *s) - *t <= CONE_THRESH) ||
+            (*r <= 0 && *s == 0 && *t >= 0)) {
         return 0;
     }
 
     /* -v in Kexp^* */
-    if ((-r < 0 && r * exp(s / r) + exp(1) * t <= CONE_THRESH) ||
-            (-r == 0 && -s >= 0 && -t >= 0)) {
-        memset(v, 0, 3 * sizeof (scs_float));
+    if ((-*r < 0 && *r * exp(*s / *r) + exp(1) * *t <= CONE_THRESH) ||
+            (-*r == 0 && -*s >= 0 && -*t >= 0)) {
+        *r = *s = *t = 0;
         return 0;
     }
 
     /* special case with analytical solution */
-    if (r < 0 && s < 0) {
-        v[1] = 0.0;
-        v[2] = MAX(v[2], 0);
+    if (*r < 0 && *s < 0) {
+        *s = 0.0;
+        *t = MAX(*t, 0);
         return 0;
     }
+    return 1;
+}
 
-    /* iterative procedure to find projection, bisects on dual variable: */
-    expGetRhoUb(v, x, &ub, &lb); /* get starting upper and lower bounds */
-    for (i = 0; i < EXP_CONE_MAX_ITERS; ++i) {
-        rho = (ub + lb) / 2; /* halfway between upper and lower bounds */
+/*
+ * project onto the exponential cone, v has dimension *exactly* 3 and its
+ * projection is not available in closed form (see expProjectClosedForm);
+ * rho_ws is the dual variable of the previous projection of this cone (or 0
+ * if there is none), it is used as a starting point and it is updated on exit
+ */
+static scs_int projExpCone(scs_float * RESTRICT v, scs_float * RESTRICT rho_ws,
+        scs_int iter) {
+    scs_int i, side = 0;
+    scs_float ub, lb, g_ub, g_lb, rho, g, x[3];
+    scs_float tol = getConeTol(iter);
+
+    /*
+     * iterative procedure to find projection, finds the root of the gradient
+     * wrt the dual variable using regula falsi (Illinois variant) safeguarded
+     * by bisection, warm-started from the previous dual variable
+     */
+    expBracketRho(v, x, *rho_ws > 0 ? *rho_ws : 0.125, &lb, &ub, &g_lb, &g_ub);
+    rho = ub;
+    if (ub - lb < tol) {
+        /* x was last computed at either end of the bracket; make it x(ub) */
+        expCalcGrad(v, x, rho);
+    }
+    for (i = 0; i < EXP_CONE_MAX_ITERS && ub - lb >= tol; ++i) {
+        if (g_lb < INFINITY) {
+            rho = (lb * g_ub - ub * g_lb) / (g_ub - g_lb);
+            if (!(rho > lb && rho < ub)) {
+                rho = (ub + lb) / 2;
+            }
+        } else {
+            rho = (ub + lb) / 2;
+        }
         g = expCalcGrad(v, x, rho); /* calculates gradient wrt dual var */
+        if (ABS(g) < tol) {
+            break;
+        }
         if (g > 0) {
             lb = rho;
+            g_lb = g;
+            if (side > 0) {
+                g_ub /= 2;
+            }
+            side = 1;
         } else {
             ub = rho;
-        }
-        if (ub - lb < tol) {
-            break;
+            g_ub = g;
+            if (side < 0) {
+                g_lb /= 2;
+            }
+            side = -1;
         }
     }
+    *rho_ws = rho;
     v[0] = x[0];
     v[1] = x[1];
     v[2] = x[2];
-    return 0;
+    return i;
 }
 
 static scs_int setUpSdScsConeWorkSpace(ScsConeWork * RESTRICT c, const ScsCone * RESTRICT k) {
@@ -387,7 +668,35 @@ static scs_int setUpSdScsConeWorkSpace(ScsConeWork * RESTRICT c, const ScsCone *
 
 ScsConeWork *scs_init_conework(const ScsCone * RESTRICT k) {
     ScsConeWork * RESTRICT coneWork = scs_calloc(1, sizeof (ScsConeWork));
-    coneWork->total_cone_time = 0.0;
+    scs_reset_cone_stats(coneWork);
+    if (k->ep + k->ed > 0) {
+        coneWork->exp_rho = scs_calloc(k->ep + k->ed, sizeof (scs_float));
+        coneWork->exp_v = scs_malloc(3 * (k->ep + k->ed) * sizeof (scs_float));
+        coneWork->exp_idx = scs_malloc((k->ep + k->ed) * sizeof (scs_int));
+        if (coneWork->exp_rho == SCS_NULL || coneWork->exp_v == SCS_NULL
+                || coneWork->exp_idx == SCS_NULL) {
+            scs_finish_cone(coneWork); /* LCOV_EXCL_LINE */
+            return SCS_NULL; /* LCOV_EXCL_LINE */
+        }
+    }
+    if (k->bsize > 0) {
+        coneWork->box_v = scs_malloc(k->bsize * sizeof (scs_float));
+        if (coneWork->box_v == SCS_NULL) {
+            scs_finish_cone(coneWork); /* LCOV_EXCL_LINE */
+            return SCS_NULL; /* LCOV_EXCL_LINE */
+        }
+    }
+    if (k->psize > 0 && k->p) {
+        coneWork->pow_v = scs_malloc(3 * k->psize * sizeof (scs_float));
+        coneWork->pow_proj = scs_malloc(3 * k->psize * sizeof (scs_float));
+        coneWork->pow_r = scs_calloc(k->psize, sizeof (scs_float));
+        coneWork->pow_idx = scs_malloc(k->psize * sizeof (scs_int));
+        if (coneWork->pow_v == SCS_NULL || coneWork->pow_proj == SCS_NULL
+                || coneWork->pow_r == SCS_NULL || coneWork->pow_idx == SCS_NULL) {
+            scs_finish_cone(coneWork); /* LCOV_EXCL_LINE */
+            return SCS_NULL; /* LCOV_EXCL_LINE */
+        }
+    }
     if (k->ssize && k->s) {
         if (isSimpleSemiDefiniteCone(k->s, k->ssize) == 0 &&
                 setUpSdScsConeWorkSpace(coneWork, k) < 0) {
@@ -463,8 +772,7 @@ static scs_int projSemiDefiniteCone(
     blasint lwork = c->lwork;
     blasint liwork = c->liwork;
 
-    scs_float eigTol = CONE_TOL; /* iter < 0 ? CONE_TOL : MAX(CONE_TOL, 1 /
-                                    POWF(iter + 1, CONE_RATE)); */
+    scs_float eigTol = getConeTol(iter);
     scs_float zero = 0.0;
     blasint info;
     scs_float vupper;
@@ -507,6 +815,7 @@ static scs_int projSemiDefiniteCone(
 
     if (info < 0)
         return -1;
+    c->psd_eigenpairs += m;
 
     memset(Xs, 0, n * n * sizeof (scs_float));
     for (i = 0; i < m; ++i) {
@@ -541,53 +850,296 @@ static scs_float powCalcdxdr(scs_float x, scs_float xh, scs_float rh, scs_float
     return a * (rh - 2 * r) / (2 * x - xh);
 }
 
-static scs_float powCalcF(scs_float x, scs_float y, scs_float r, scs_float a) {
-    return POWF(x, a) * POWF(y, (1 - a)) - r;
+static scs_float powCalcXY(scs_float x, scs_float y, scs_float a) {
+    return POWF(x, a) * POWF(y, (1 - a));
 }
 
-static scs_float powCalcFp(scs_float x, scs_float y, scs_float dxdr, scs_float dydr,
-        scs_float a) {
-    return POWF(x, a) * POWF(y, (1 - a)) * (a * dxdr / x + (1 - a) * dydr / y) -
-            1;
-}
-
-static void projPowerCone(scs_float *RESTRICT v, scs_float a) {
-    scs_float xh = v[0], yh = v[1], rh = ABS(v[2]);
-    scs_float x, y, r;
-    scs_int i;
+/*
+ * projects (xh, yh, rh) onto the power cone K_a if the projection is available
+ * in closed form and returns 0, otherwise returns 1 and leaves it intact
+ */
+static scs_int powProjectClosedForm(scs_float * RESTRICT xh, scs_float * RESTRICT yh,
+        scs_float * RESTRICT rh, scs_float a) {
     /* v in K_a */
-    if (xh >= 0 && yh >= 0 &&
-            CONE_THRESH + POWF(xh, a) * POWF(yh, (1 - a)) >= rh)
-        return;
+    if (*xh >= 0 && *yh >= 0 &&
+            CONE_THRESH + powCalcXY(*xh, *yh, a) >= ABS(*rh))
+        return 0;
 
     /* -v in K_a^* */
-    if (xh <= 0 && yh <= 0 &&
-            CONE_THRESH + POWF(-xh, a) * POWF(-yh, 1 - a) >=
-            rh * POWF(a, a) * POWF(1 - a, 1 - a)) {
-        v[0] = v[1] = v[2] = 0;
-        return;
+    if (*xh <= 0 && *yh <= 0 &&
+            CONE_THRESH + powCalcXY(-*xh, -*yh, a) >=
+            ABS(*rh) * powCalcXY(a, 1 - a, a)) {
+        *xh = *yh = *rh = 0;
+        return 0;
+    }
+    return 1;
+}
+
+/*
+ * projects all exponential cones; the triplets are copied into separate
+ * buffers for each coordinate, the points whose projection is known in closed
+ * form are projected in one pass and only the rest (whose indices are kept in
+ * c->exp_idx) are projected iteratively, one cone at a time;
+ * the primal cones are projected onto via Moreau, since the exponential cone
+ * is not self dual: if s \in K then y \in K^*, here we project onto K^*
+ * \Pi_C^*(y) = y + \Pi_C(-y)
+ */
+static void projExpCones(scs_float * RESTRICT x, const ScsCone * RESTRICT k,
+        ScsConeWork * RESTRICT c, scs_int iter) {
+    const scs_int ne = k->ep + k->ed;
+    scs_float * RESTRICT vr = c->exp_v;
+    scs_float * RESTRICT vs = c->exp_v + ne;
+    scs_float * RESTRICT vt = c->exp_v + 2 * ne;
+    scs_int i, l, n_iter = 0, n_inner = 0;
+
+    for (i = 0; i < k->ep; ++i) {
+        vr[i] = -x[3 * i];
+        vs[i] = -x[3 * i + 1];
+        vt[i] = -x[3 * i + 2];
+    }
+    for (i = k->ep; i < ne; ++i) {
+        vr[i] = x[3 * i];
+        vs[i] = x[3 * i + 1];
+        vt[i] = x[3 * i + 2];
     }
 
-    r = rh / 2;
-    for (i = 0; i < POW_CONE_MAX_ITERS; ++i) {
-        scs_float f, fp, dxdr, dydr;
-        x = powCalcX(r, xh, rh, a);
-        y = powCalcX(r, yh, rh, 1 - a);
+    for (i = 0; i < ne; ++i) {
+        if (expProjectClosedForm(&vr[i], &vs[i], &vt[i])) {
+            c->exp_idx[n_iter++] = i;
+        }
+    }
 
-        f = powCalcF(x, y, r, a);
-        if (ABS(f) < CONE_TOL)
-            break;
+#ifdef _OPENMP
+#pragma omp parallel for private(i) reduction(+:n_inner)
+#endif
+    for (l = 0; l < n_iter; ++l) {
+        scs_float v[3];
+        i = c->exp_idx[l];
+        v[0] = vr[i];
+        v[1] = vs[i];
+        v[2] = vt[i];
+        n_inner += projExpCone(v, &(c->exp_rho[i]), iter);
+        vr[i] = v[0];
+        vs[i] = v[1];
+        vt[i] = v[2];
+    }
+
+    c->exp_projections += ne;
+    c->exp_iterative += n_iter;
+    c->exp_iters += n_inner;
+
+    for (i = 0; i < k->ep; ++i) {
+        x[3 * i] += vr[i];
+        x[3 * i + 1] += vs[i];
+        x[3 * i + 2] += vt[i];
+    }
+    for (i = k->ep; i < ne; ++i) {
+        x[3 * i] = vr[i];
+        x[3 * i + 1] = vs[i];
+        x[3 * i + 2] = vt[i];
+    }
+}
+
+/*
+ * projects all power cones; the triplets are copied into separate buffers for
+ * each coordinate and every pass over the list of active cones (those whose
+ * projection is not known in closed form) performs one Newton step on r for
+ * each of them; the cones that converge are dropped from the list after every
+ * pass; every cone starts from the value of r at its previous projection;
+ * for the primal cones we use Moreau, the dual ones are projected onto directly
+ */
+static void projPowerCones(scs_float * RESTRICT x, const ScsCone * RESTRICT k,
+        ScsConeWork * RESTRICT c, scs_int iter) {
+    const scs_int np = k->psize;
+    const scs_float tol = getConeTol(iter);
+    scs_float * RESTRICT vx = c->pow_v;
+    scs_float * RESTRICT vy = c->pow_v + np;
+    scs_float * RESTRICT vr = c->pow_v + 2 * np;
+    scs_float * RESTRICT px = c->pow_proj;
+    scs_float * RESTRICT py = c->pow_proj + np;
+    scs_float * RESTRICT pr = c->pow_proj + 2 * np;
+    scs_float * RESTRICT r = c->pow_r;
+    scs_int * RESTRICT active = c->pow_idx;
+    scs_int i, j, l, it, n_active = 0;
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for (i = 0; i < np; ++i) {
+        scs_float sgn = k->p[i] <= 0 ? 1 : -1;
+        vx[i] = sgn * x[3 * i];
+        vy[i] = sgn * x[3 * i + 1];
+        vr[i] = sgn * x[3 * i + 2];
+        px[i] = vx[i];
+        py[i] = vy[i];
+        pr[i] = vr[i];
+    }
+
+    for (i = 0; i < np; ++i) {
+        if (powProjectClosedForm(&px[i], &py[i], &pr[i], ABS(k->p[i]))) {
+            scs_float rh = ABS(vr[i]);
+            r[i] = (r[i] > 0 && r[i] < rh) ? r[i] : rh / 2;
+            active[n_active++] = i;
+        }
+    }
+    c->pow_projections += np;
+    c->pow_iterative += n_active;
+
+    for (it = 0; it < POW_CONE_MAX_ITERS && n_active > 0; ++it) {
+        c->pow_newton_iters += n_active;
+#ifdef _OPENMP
+#pragma omp parallel for private(i)
+#endif
+        for (l = 0; l < n_active; ++l) {
+            scs_float a, rh, xy, f, fp, dxdr, dydr;
+            i = active[l];
+            a = ABS(k->p[i]);
+            rh = ABS(vr[i]);
+            px[i] = powCalcX(r[i], vx[i], rh, a);
+            py[i] = powCalcX(r[i], vy[i], rh, 1 - a);
+            pr[i] = (vr[i] < 0) ? -r[i] : r[i];
+
+            xy = powCalcXY(px[i], py[i], a);
+            f = xy - r[i];
+            if (ABS(f) < tol) {
+                active[l] = -1; /* converged */
+                continue;
+            }
+
+            dxdr = powCalcdxdr(px[i], vx[i], rh, r[i], a);
+            dydr = powCalcdxdr(py[i], vy[i], rh, r[i], (1 - a));
+            fp = xy * (a * dxdr / px[i] + (1 - a) * dydr / py[i]) - 1;
+
+            r[i] = MAX(r[i] - f / fp, 0);
+            r[i] = MIN(r[i], rh);
+        }
+        for (l = 0, j = 0; l < n_active; ++l) {
+            if (active[l] >= 0) {
+                active[j++] = active[l];
+            }
+        }
+        n_active = j;
+    }
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for (i = 0; i < np; ++i) {
+        if (k->p[i] <= 0) {
+            x[3 * i] = px[i];
+            x[3 * i + 1] = py[i];
+            x[3 * i + 2] = pr[i];
+        } else {
+            x[3 * i] += px[i];
+            x[3 * i + 1] += py[i];
+            x[3 * i + 2] += pr[i];
+        }
+    }
+}
+
+/*
+ * projection onto the rotated second-order cone {(u, v, w): 2uv >= |w|^2, 
+ * u, v >= 0}; the symmetric orthogonal map (u, v) -> ((u + v), (u - v))/sqrt(2)
+ * takes it to the second-order cone, where the projection is in closed form
+ */
+static void projRotatedSoc(scs_float * RESTRICT x, scs_int n) {
+    const scs_float sqrt2Inv = 1.0 / SQRTF(2.0);
+    scs_float t = (x[0] + x[1]) * sqrt2Inv;
+    scs_float r = (x[0] - x[1]) * sqrt2Inv;
+    scs_float nw = scs_norm(&(x[2]), n - 2);
+    scs_float s = SQRTF(r * r + nw * nw);
+    scs_float alpha;
+
+    if (s <= t) {
+        return;
+    }
+    if (s <= -t) {
+        memset(x, 0, n * sizeof (scs_float));
+        return;
+    }
+    alpha = (s + t) / 2.0;
+    t = alpha;
+    r *= alpha / s;
+    scs_scale_array(&(x[2]), alpha / s, n - 2);
+    x[0] = (t + r) * sqrt2Inv;
+    x[1] = (t - r) * sqrt2Inv;
+}
 
-        dxdr = powCalcdxdr(x, xh, rh, r, a);
-        dydr = powCalcdxdr(y, yh, rh, r, (1 - a));
-        fp = powCalcFp(x, y, dxdr, dydr, a);
+/*
+ * derivative (up to a factor 2) of the squared distance of v = (t0, s0) from
+ * the box cone as a function of t, when s is the clipping of s0 to
+ * [t bl, t bu]; it is nondecreasing and piecewise linear in t, its slope is
+ * returned in dg
+ */
+static scs_float boxCalcGrad(const scs_float * RESTRICT v, const scs_float * RESTRICT bl,
+        const scs_float * RESTRICT bu, scs_int nb, scs_float t, scs_float * RESTRICT dg) {
+    scs_int i;
+    scs_float g = t - v[0];
+    *dg = 1;
+    for (i = 0; i < nb; ++i) {
+        scs_float s = v[i + 1];
+        if (bl[i] > -INFINITY && s < t * bl[i]) {
+            g += bl[i] * (t * bl[i] - s);
+            *dg += bl[i] * bl[i];
+        } else if (bu[i] < INFINITY && s > t * bu[i]) {
+            g += bu[i] * (t * bu[i] - s);
+            *dg += bu[i] * bu[i];
+        }
+    }
+    return g;
+}
 
-        r = MAX(r - f / fp, 0);
-        r = MIN(r, rh);
+/*
+ * project onto the box cone {(t, s): t >= 0, t bl <= s <= t bu}; v has
+ * dimension nb + 1; for fixed t the projection of s is a clipping, so t is
+ * found by Newton's method on the derivative of the distance wrt t,
+ * safeguarded by bisection and warm-started from the previous value of t
+ */
+static void projBoxCone(scs_float * RESTRICT v, const scs_float * RESTRICT bl,
+        const scs_float * RESTRICT bu, scs_int nb, scs_float * RESTRICT t_ws,
+        scs_float tol) {
+    scs_int i;
+    scs_float t = 0, lb = 0, ub, g, dg;
+
+    g = boxCalcGrad(v, bl, bu, nb, 0, &dg);
+    if (g < 0) {
+        /* the root lies in (0, ub): beyond ub no bound pulls t backwards */
+        ub = MAX(v[0], 0);
+        for (i = 0; i < nb; ++i) {
+            if (bl[i] < 0 && bl[i] > -INFINITY)
+                ub = MAX(ub, v[i + 1] / bl[i]);
+            if (bu[i] > 0 && bu[i] < INFINITY)
+                ub = MAX(ub, v[i + 1] / bu[i]);
+        }
+        ub += 1;
+        t = (*t_ws > lb && *t_ws < ub) ? *t_ws : (lb + ub) / 2;
+        for (i = 0; i < BOX_CONE_MAX_ITERS; ++i) {
+            g = boxCalcGrad(v, bl, bu, nb, t, &dg);
+            if (ABS(g) < tol)
+                break;
+            if (g > 0) {
+                ub = t;
+            } else {
+                lb = t;
+            }
+            if (ub - lb < tol)
+                break;
+            t -= g / dg;
+            if (!(t > lb && t < ub)) {
+                t = (lb + ub) / 2;
+            }
+        }
     }
-    v[0] = x;
-    v[1] = y;
-    v[2] = (v[2] < 0) ? -(r) : (r);
+
+    v[0] = t;
+    for (i = 0; i < nb; ++i) {
+        if (bl[i] > -INFINITY && v[i + 1] < t * bl[i]) {
+            v[i + 1] = t * bl[i];
+        } else if (bu[i] < INFINITY && v[i + 1] > t * bu[i]) {
+            v[i + 1] = t * bu[i];
+        }
+    }
+    *t_ws = t;
 }
 
 /* outward facing cone projection routine, iter is outer algorithm iteration, if
@@ -601,7 +1153,13 @@ scs_int scs_project_dual_cone(
         scs_int iter) {
     scs_int i;
     scs_int count = (k->f ? k->f : 0);
+    scs_float t_lap = 0.0;
     ScsTimer coneTimer;
+
+    if (c == SCS_NULL) {
+        scs_printf("ERROR: scs_project_dual_cone requires a cone workspace\n");
+        return -1;
+    }
     scs_tic(&coneTimer);
 
     if (k->l) {
@@ -612,6 +1170,23 @@ scs_int scs_project_dual_cone(
             /* x[i] = (x[i] < 0.0) ? 0.0 : x[i]; */
         }
         count += k->l;
+        c->lp_projections++;
+        c->lp_time += coneTimerLap(&coneTimer, &t_lap);
+    }
+
+    if (k->bsize) {
+        /*
+         * the box cone is not self dual, project onto K^* via Moreau
+         * \Pi_C^*(y) = y + \Pi_C(-y)
+         */
+        for (i = 0; i < k->bsize; ++i) {
+            c->box_v[i] = -x[count + i];
+        }
+        projBoxCone(c->box_v, k->bl, k->bu, k->bsize - 1, &(c->box_t), getConeTol(iter));
+        scs_add_scaled_array(&(x[count]), c->box_v, k->bsize, 1.0);
+        count += k->bsize;
+        c->box_projections++;
+        c->box_time += coneTimerLap(&coneTimer, &t_lap);
     }
 
     if (k->qsize && k->q) {
@@ -637,7 +1212,19 @@ scs_int scs_project_dual_cone(
                 }
             }
             count += k->q[i];
+            c->soc_projections++;
         }
+        c->soc_time += coneTimerLap(&coneTimer, &t_lap);
+    }
+
+    if (k->rqsize && k->rq) {
+        /* project onto rotated SOC (self dual) */
+        for (i = 0; i < k->rqsize; ++i) {
+            projRotatedSoc(&(x[count]), k->rq[i]);
+            count += k->rq[i];
+        }
+        c->soc_projections += k->rqsize;
+        c->soc_time += coneTimerLap(&coneTimer, &t_lap);
     }
 
     if (k->ssize && k->s) {
@@ -649,79 +1236,24 @@ scs_int scs_project_dual_cone(
             if (projSemiDefiniteCone(&(x[count]), k->s[i], c, iter) < 0)
                 return -1;
             count += getSdConeSize(k->s[i]);
+            c->psd_projections++;
         }
+        c->psd_time += coneTimerLap(&coneTimer, &t_lap);
     }
 
-    if (k->ep) {
-        scs_float r, s, t;
-        scs_int idx;
-        /*
-         * exponential cone is not self dual, if s \in K
-         * then y \in K^* and so if K is the primal cone
-         * here we project onto K^*, via Moreau
-         * \Pi_C^*(y) = y + \Pi_C(-y)
-         */
-        scs_scale_array(&(x[count]), -1, 3 * k->ep); /* x = -x; */
-#ifdef _OPENMP
-#pragma omp parallel for private(r, s, t, idx)
-#endif
-        for (i = 0; i < k->ep; ++i) {
-            idx = count + 3 * i;
-            r = x[idx];
-            s = x[idx + 1];
-            t = x[idx + 2];
-
-            projExpCone(&(x[idx]), iter);
-
-            x[idx] -= r;
-            x[idx + 1] -= s;
-            x[idx + 2] -= t;
-        }
-        count += 3 * k->ep;
-    }
-
-    if (k->ed) {
-        /* exponential cone: */
-#ifdef _OPENMP
-#pragma omp parallel for
-#endif
-        for (i = 0; i < k->ed; ++i) {
-            projExpCone(&(x[count + 3 * i]), iter);
-        }
-        count += 3 * k->ed;
+    if (k->ep || k->ed) {
+        projExpCones(&(x[count]), k, c, iter);
+        count += 3 * (k->ep + k->ed);
+        c->exp_time += coneTimerLap(&coneTimer, &t_lap);
     }
 
     if (k->psize && k->p) {
-        scs_float v[3];
-        scs_int idx;
-        /* don't use openmp for power cone
-        ifdef _OPENMP
-        pragma omp parallel for private(v, idx)
-        endif
-         */
-        for (i = 0; i < k->psize; ++i) {
-            idx = count + 3 * i;
-            if (k->p[i] <= 0) {
-                /* dual power cone */
-                projPowerCone(&(x[idx]), -k->p[i]);
-            } else {
-                /* primal power cone, using Moreau */
-                v[0] = -x[idx];
-                v[1] = -x[idx + 1];
-                v[2] = -x[idx + 2];
-
-                projPowerCone(v, k->p[i]);
-
-                x[idx] += v[0];
-                x[idx + 1] += v[1];
-                x[idx + 2] += v[2];
-            }
-        }
+        projPowerCones(&(x[count]), k, c, iter);
         /* count += 3 * k->psize; */
+        c->pow_time += coneTimerLap(&coneTimer, &t_lap);
     }
     /* project onto OTHER cones */
-    if (c) {
-        c->total_cone_time += scs_toc_quiet(&coneTimer);
-    }
+    /* the last lap is the total time (no additional reading of the clock) */
+    c->total_cone_time += t_lap;
     return 0;
 }
@@ -33,6 +33,12 @@
  * Under Unix systems, we use sigaction.
  * For Mex files, we use utSetInterruptEnabled/utIsInterruptPending.
  *
+ * Interrupts are counted process-wide; a listener records the count when it 
+ * is started and is interrupted once the count changes, so that several 
+ * solves can listen at the same time. On Unix systems, the signal handler is 
+ * installed by the first active listener and the previous one is restored 
+ * by the last.
+ *
  */
 
 #include "ctrlc.h"
@@ -41,67 +47,115 @@
 
 #ifdef MATLAB_MEX_FILE
 
-static int istate;
-void startInterruptListener(void) {
-    istate = utSetInterruptEnabled(1);
+void startInterruptListener(ScsInterruptListener *listener, int enabled) {
+    listener->active = 0;
+    if (!enabled) return;
+    listener->istate = utSetInterruptEnabled(1);
+    listener->active = 1;
 }
 
-void endInterruptListener(void) {
-    utSetInterruptEnabled(istate);
+void endInterruptListener(ScsInterruptListener *listener) {
+    if (!listener->active) return;
+    utSetInterruptEnabled(listener->istate);
+    listener->active = 0;
 }
 
-int isInterrupted(void) {
-    return utIsInterruptPending();
+int isInterrupted(const ScsInterruptListener *listener) {
+    return listener->active && utIsInterruptPending();
 }
 
 #elif defined _WIN32 || defined _WIN64
 
-static int int_detected = 0;
-BOOL WINAPI handle_ctrlc(DWORD dwCtrlType) {
+static volatile LONG int_count = 0;
+static BOOL WINAPI handle_ctrlc(DWORD dwCtrlType) {
     if (dwCtrlType != CTRL_C_EVENT)
         return FALSE;
-    int_detected = 1;
+    InterlockedIncrement(&int_count);
     return TRUE;
 }
 
-void startInterruptListener(void) {
-    int_detected = 0;
-    SetConsoleCtrlHandler(handle_ctrlc, TRUE);
+static LONG num_listeners = 0;
+/* spin lock built on Interlocked* so that it needs no run-time initialisation */
+static volatile LONG listeners_lock = 0;
+
+static void lock_listeners(void) {
+    while (InterlockedCompareExchange(&listeners_lock, 1, 0) != 0)
+        Sleep(0);
+}
+
+static void unlock_listeners(void) {
+    InterlockedExchange(&listeners_lock, 0);
+}
+
+void startInterruptListener(ScsInterruptListener *listener, int enabled) {
+    listener->active = 0;
+    if (!enabled) return;
+    lock_listeners();
+    if (num_listeners++ == 0) {
+        SetConsoleCtrlHandler(handle_ctrlc, TRUE);
+    }
+    listener->mark = (int) int_count;
+    unlock_listeners();
+    listener->active = 1;
 }
 
-void endInterruptListener(void) {
-    SetConsoleCtrlHandler(handle_ctrlc, FALSE);
+void endInterruptListener(ScsInterruptListener *listener) {
+    if (!listener->active) return;
+    lock_listeners();
+    if (--num_listeners == 0) {
+        SetConsoleCtrlHandler(handle_ctrlc, FALSE);
+    }
+    unlock_listeners();
+    listener->active = 0;
 }
 
-int isInterrupted(void) {
-    return int_detected;
+int isInterrupted(const ScsInterruptListener *listener) {
+    return listener->active && (int) int_count != listener->mark;
 }
 
 #else /* Unix */
 
 #include <signal.h>
-static int int_detected;
-struct sigaction oact;
-void handle_ctrlc(int dummy) {
-    int_detected = dummy ? dummy : -1;
+#include <pthread.h>
+static volatile sig_atomic_t int_count = 0;
+static int num_listeners = 0;
+static struct sigaction oact;
+static pthread_mutex_t listeners_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static void handle_ctrlc(int dummy) {
+    (void) dummy;
+    int_count = int_count + 1;
 }
 
-void startInterruptListener(void) {
-    struct sigaction act;
-    int_detected = 0;
-    act.sa_flags = 0;
-    sigemptyset(&act.sa_mask);
-    act.sa_handler = handle_ctrlc;
-    sigaction(SIGINT, &act, &oact);
+void startInterruptListener(ScsInterruptListener *listener, int enabled) {
+    listener->active = 0;
+    if (!enabled) return;
+    pthread_mutex_lock(&listeners_lock);
+    if (num_listeners++ == 0) {
+        struct sigaction act;
+        act.sa_flags = 0;
+        sigemptyset(&act.sa_mask);
+        act.sa_handler = handle_ctrlc;
+        sigaction(SIGINT, &act, &oact);
+    }
+    listener->mark = (int) int_count;
+    pthread_mutex_unlock(&listeners_lock);
+    listener->active = 1;
 }
 
-void endInterruptListener(void) {
-    struct sigaction act;
-    sigaction(SIGINT, &oact, &act);
+void endInterruptListener(ScsInterruptListener *listener) {
+    if (!listener->active) return;
+    pthread_mutex_lock(&listeners_lock);
+    if (--num_listeners == 0) {
+        struct sigaction act;
+        sigaction(SIGINT, &oact, &act);
+    }
+    pthread_mutex_unlock(&listeners_lock);
+    listener->active = 0;
 }
 
-int isInterrupted(void) {
-    return int_detected;
+int isInterrupted(const ScsInterruptListener *listener) {
+    return listener->active && (int) int_count != listener->mark;
 }
 
 #endif /* END IF MATLAB_MEX_FILE / WIN32 */
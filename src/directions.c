@@ -27,201 +27,915 @@
 #include "directions.h"
 
 
-/*TODO Allocate this variable within work */
-static scs_float * HY; /* Vector H*Y of length l */
-
 scs_int scs_reset_direction_cache(ScsDirectionCache * cache) {
     cache->mem_cursor = 0; /* set active memory to 0 */
     cache->current_mem = 0;
     return SCS_DIRECTION_CACHE_RESET;
 }
 
+/*
+ * Parameters of the adaptive memory (see scs_adapt_memory): the active memory
+ * shrinks when the estimated condition number of the system solved by the
+ * direction exceeds scs_memory_max_cond and grows when the FPR is reduced by
+ * less than the factor scs_memory_slow_progress between two directions; the
+ * memory is restarted after scs_memory_max_stall consecutive directions which
+ * do not reduce the FPR by the factor scs_memory_stall_progress.
+ */
+static const scs_float scs_memory_max_cond = 1e6;
+static const scs_float scs_memory_slow_progress = 0.9;
+static const scs_float scs_memory_stall_progress = 0.999;
+static const scs_int scs_memory_max_stall = 5;
+
+void scs_reset_adaptive_memory(ScsDirectionCache * cache, scs_int adaptive) {
+    cache->mem_active = adaptive ? MAX(1, cache->mem / 2) : cache->mem;
+    cache->stall_count = 0;
+    cache->cond = 1.0;
+    cache->nrmR_prev = 0.0;
+}
+
+/*
+ * Updates the active memory after a direction has been computed, using the
+ * condition number estimated by the direction and the reduction of the FPR
+ * since the previous direction.
+ */
+static void scs_adapt_memory(ScsWork * RESTRICT work) {
+    ScsDirectionCache * RESTRICT cache = work->direction_cache;
+    const scs_float nrmR = work->nrmR_con;
+    scs_float ratio;
+
+    if (cache->nrmR_prev > 0) {
+        ratio = nrmR / cache->nrmR_prev;
+        if (cache->cond > scs_memory_max_cond) {
+            cache->mem_active = MAX(1, cache->mem_active - 1);
+        } else if (ratio > scs_memory_slow_progress) {
+            cache->mem_active = MIN(cache->mem, cache->mem_active + 1);
+        }
+        cache->stall_count = ratio > scs_memory_stall_progress
+                ? cache->stall_count + 1 : 0;
+        if (cache->stall_count >= scs_memory_max_stall) {
+            scs_reset_direction_cache(cache);
+            cache->stall_count = 0;
+        }
+    }
+    cache->nrmR_prev = nrmR;
+}
+
+/*
+ * Kernels on the vectors of the direction cache, whose entries are of type
+ * scs_cache_float; all computations are carried out in scs_float. Unless
+ * CACHE_FLOAT is defined, these map to the usual (BLAS) routines.
+ */
+
+/* x_c <- x */
+static void scs_cache_copy(
+        scs_cache_float * RESTRICT x_c,
+        const scs_float * RESTRICT x,
+        scs_int l) {
+#ifdef CACHE_FLOAT
+    scs_int i;
+    for (i = 0; i < l; ++i) {
+        x_c[i] = (scs_cache_float) x[i];
+    }
+#else
+    memcpy(x_c, x, l * sizeof (scs_float));
+#endif
+}
+
+/* x_c <- a * x + b * y */
+static void scs_cache_store(
+        scs_cache_float * RESTRICT x_c,
+        const scs_float * RESTRICT x,
+        const scs_float * RESTRICT y,
+        scs_float a,
+        scs_float b,
+        scs_int l) {
+#ifdef CACHE_FLOAT
+    scs_int i;
+    for (i = 0; i < l; ++i) {
+        x_c[i] = (scs_cache_float) (a * x[i] + b * y[i]);
+    }
+#else
+    scs_axpy(x_c, x, y, a, b, l);
+#endif
+}
+
+/* x_c'y_c and x_c'y in a single pass over x_c */
+static void scs_cache_dot2(
+        const scs_cache_float * RESTRICT x_c,
+        const scs_cache_float * RESTRICT y_c,
+        const scs_float * RESTRICT y,
+        scs_int l,
+        scs_float * RESTRICT out_x,
+        scs_float * RESTRICT out_y) {
+    scs_int i;
+    scs_float sx = 0, sy = 0;
+    for (i = 0; i < l; ++i) {
+        sx += (scs_float) x_c[i] * y_c[i];
+        sy += x_c[i] * y[i];
+    }
+    *out_x = sx;
+    *out_y = sy;
+}
+
+/* x <- x_c */
+static void scs_cache_load(
+        scs_float * RESTRICT x,
+        const scs_cache_float * RESTRICT x_c,
+        scs_int l) {
+#ifdef CACHE_FLOAT
+    scs_int i;
+    for (i = 0; i < l; ++i) {
+        x[i] = x_c[i];
+    }
+#else
+    memcpy(x, x_c, l * sizeof (scs_float));
+#endif
+}
+
+/* out <- X' x, where X is l-by-k */
+static void scs_cache_transpose_multiply(
+        scs_int k,
+        scs_int l,
+        const scs_cache_float * RESTRICT X,
+        const scs_float * RESTRICT x,
+        scs_float * RESTRICT out) {
+    if (k == 0) return;
+    memset(out, 0, k * sizeof (scs_float));
+#ifdef CACHE_FLOAT
+    {
+        scs_int i, j;
+        for (j = 0; j < k; ++j) {
+            const scs_cache_float * RESTRICT x_j = X + j * l;
+            scs_float ip = 0;
+            for (i = 0; i < l; ++i) {
+                ip += x_j[i] * x[i];
+            }
+            out[j] = ip;
+        }
+    }
+#else
+    scs_matrix_transpose_multiply(k, 1, l, 1.0, X, 0.0, x, out);
+#endif
+}
+
+/* x <- x + alpha X z, where X is l-by-k */
+static void scs_cache_multiply(
+        scs_int l,
+        scs_int k,
+        scs_float alpha,
+        const scs_cache_float * RESTRICT X,
+        const scs_float * RESTRICT z,
+        scs_float * RESTRICT x) {
+    if (k == 0) return;
+#ifdef CACHE_FLOAT
+    {
+        scs_int i, j;
+        scs_float acc;
+        for (i = 0; i < l; ++i) {
+            acc = 0;
+            for (j = 0; j < k; ++j) {
+                acc += X[i + j * l] * z[j];
+            }
+            x[i] += alpha * acc;
+        }
+    }
+#else
+    scs_matrix_multiply(l, 1, k, alpha, X, 1.0, z, x);
+#endif
+}
+
+/*
+ * A new column of Y is rejected (and the memory is restarted) if its component
+ * which is orthogonal to the columns already in the cache is smaller than this
+ * tolerance relative to the largest norm of the columns of Y (which are the
+ * norms of the columns of R).
+ */
+static const scs_float scs_anderson_dependence_tol = 1e-8;
+
+/*
+ * Regularization of the Gram matrix, relative to its largest diagonal entry,
+ * and largest (estimated) condition number of the regularized Gram matrix
+ * beyond which the QR factorization is used instead.
+ */
+static const scs_float scs_anderson_gram_reg = 1e-12;
+static const scs_float scs_anderson_gram_max_cond = 1e8;
+
+/* [x y] <- [x y] * [c -s; s c] */
+static void scs_apply_givens(
+        scs_float * RESTRICT x,
+        scs_float * RESTRICT y,
+        scs_float c,
+        scs_float s,
+        scs_int len) {
+    scs_int i;
+    scs_float xi;
+    for (i = 0; i < len; ++i) {
+        xi = x[i];
+        x[i] = c * xi + s * y[i];
+        y[i] = c * y[i] - s * xi;
+    }
+}
+
+/*
+ * Removes the first (oldest) of the k columns of Y from its QR factorization.
+ * The remaining columns of R form an upper Hessenberg matrix, which is brought
+ * back to triangular form with Givens rotations; these are also applied to
+ * the columns of Q.
+ */
+static void scs_anderson_qr_delete(
+        ScsDirectionCache * RESTRICT cache,
+        scs_int k,
+        scs_int l) {
+    const scs_int ld = cache->mem;
+    scs_float * RESTRICT R = cache->R;
+    scs_int i, j;
+    scs_float a, b, r, c, s, tmp;
+
+    for (j = 0; j < k - 1; ++j) {
+        memcpy(R + j * ld, R + (j + 1) * ld, (j + 2) * sizeof (scs_float));
+    }
+    for (j = 0; j < k - 1; ++j) {
+        a = R[j + j * ld];
+        b = R[j + 1 + j * ld];
+        r = SQRTF(a * a + b * b);
+        if (r == 0) continue;
+        c = a / r;
+        s = b / r;
+        R[j + j * ld] = r;
+        R[j + 1 + j * ld] = 0.0;
+        for (i = j + 1; i < k - 1; ++i) {
+            tmp = R[j + i * ld];
+            R[j + i * ld] = c * tmp + s * R[j + 1 + i * ld];
+            R[j + 1 + i * ld] = c * R[j + 1 + i * ld] - s * tmp;
+        }
+        scs_apply_givens(cache->Q + j * l, cache->Q + (j + 1) * l, c, s, l);
+    }
+}
+
+/*
+ * Appends y as column k (the newest one) of Y to its QR factorization using
+ * classical Gram-Schmidt with one step of reorthogonalization; on entry, y is
+ * stored in column k of Q. Returns 0 if y is (numerically) in the span of the
+ * first k columns, in which case these are left unchanged.
+ */
+static scs_int scs_anderson_qr_append(
+        ScsDirectionCache * RESTRICT cache,
+        scs_int k,
+        scs_int l) {
+    scs_float * RESTRICT q = cache->Q + k * l;
+    scs_float * RESTRICT r = cache->R + k * cache->mem;
+    scs_float y_scale, rho;
+    scs_int i;
+
+    y_scale = scs_norm(q, l);
+    for (i = 0; i < k; ++i) {
+        y_scale = MAX(y_scale, scs_norm(cache->R + i * cache->mem, i + 1));
+    }
+    if (k > 0) {
+        memset(r, 0, k * sizeof (scs_float));
+        scs_matrix_transpose_multiply(k, 1, l, 1.0, cache->Q, 0.0, q, r);
+        scs_matrix_multiply(l, 1, k, -1.0, cache->Q, 1.0, r, q);
+        memset(cache->t, 0, k * sizeof (scs_float));
+        scs_matrix_transpose_multiply(k, 1, l, 1.0, cache->Q, 0.0, q, cache->t);
+        scs_matrix_multiply(l, 1, k, -1.0, cache->Q, 1.0, cache->t, q);
+        for (i = 0; i < k; ++i) {
+            r[i] += cache->t[i];
+        }
+    }
+    rho = scs_norm(q, l);
+    if (y_scale == 0 || rho <= scs_anderson_dependence_tol * y_scale) {
+        return 0;
+    }
+    scs_scale_array(q, 1.0 / rho, l);
+    r[k] = rho;
+    return 1;
+}
+
+/* t <- R^{-1} t, where R is the k-by-k upper triangular factor in the cache */
+static void scs_anderson_back_substitution(ScsDirectionCache * RESTRICT cache, scs_int k) {
+    const scs_int ld = cache->mem;
+    const scs_float * RESTRICT R = cache->R;
+    scs_float * RESTRICT t = cache->t;
+    scs_int i, j;
+    for (i = k - 1; i >= 0; --i) {
+        for (j = i + 1; j < k; ++j) {
+            t[i] -= R[i + j * ld] * t[j];
+        }
+        t[i] /= R[i + i * ld];
+    }
+}
+
+/* Estimate of the condition number of the k-by-k factor R */
+static scs_float scs_anderson_qr_cond(const ScsDirectionCache * RESTRICT cache, scs_int k) {
+    scs_float r_min = INFINITY, r_max = 0;
+    scs_int i;
+    for (i = 0; i < k; ++i) {
+        r_min = MIN(r_min, ABS(cache->R[i + i * cache->mem]));
+        r_max = MAX(r_max, ABS(cache->R[i + i * cache->mem]));
+    }
+    return k > 0 ? r_max / r_min : 1.0;
+}
+
+/*
+ * dir = dir - S_minus_Y * t, where the columns of S_minus_Y are stored in a
+ * circular buffer and the k most recent ones (the newest is at the cursor) are
+ * used.
+ */
+static void scs_anderson_update_direction(ScsWork * RESTRICT work, scs_int k) {
+    ScsDirectionCache * RESTRICT cache = work->direction_cache;
+    const scs_int l = work->l;
+    const scs_int first = (cache->mem_cursor - k + 1 + cache->mem) % cache->mem;
+    const scs_int cols_first = MIN(k, cache->mem - first);
+
+    scs_cache_multiply(l, cols_first, -1.0,
+            cache->S_minus_Y + first * l, cache->t, work->dir);
+    if (cols_first < k) {
+        scs_cache_multiply(l, k - cols_first, -1.0,
+                cache->S_minus_Y, cache->t + cols_first, work->dir);
+    }
+}
+
 scs_int scs_compute_dir_anderson(ScsWork *work) {
     /* --- DECLARATIONS --- */
     ScsDirectionCache * cache; /* the SU cache (pointer) */
     const scs_int l = work->l; /* size of vectors */
-    scs_float * s_current;
-    scs_float * y_current;
-    scs_float * s_minus_y_current;
-    scs_int colsY;
-
-#ifdef SVD_ACTIVATED
-    scs_float rcond = 1e-8;
-    scs_int rank;
-    scs_float * singular_values;
-#endif
-    
-    scs_float * copy_cache_Y;
-    
+
     cache = work->direction_cache;
 
-#ifdef SVD_ACTIVATED    
-    singular_values = cache->ls_wspace + cache->ls_wspace_length;
-    copy_cache_Y = singular_values + cache->mem;
-#else
-    copy_cache_Y = cache->ls_wspace + cache->ls_wspace_length;
-#endif
+    /* d [work->dir] = -R [work->R] */
+    scs_set_as_scaled_array(work->dir, work->R, -1.0, l);
+
+    /* Store s - y at the position of the cursor */
+    scs_cache_store(cache->S_minus_Y + (cache->mem_cursor * l),
+            work->Sk, work->Yk, 1.0, -1.0, l);
+
+    /* Update the QR factorization of Y: drop the oldest column if the buffer
+     * is full and append y; if y is linearly dependent on the cached columns,
+     * the memory is restarted. */
+    while (cache->current_mem >= cache->mem_active) {
+        scs_anderson_qr_delete(cache, cache->current_mem, l);
+        cache->current_mem--;
+    }
+    memcpy(cache->Q + cache->current_mem * l, work->Yk, l * sizeof (scs_float));
+    if (!scs_anderson_qr_append(cache, cache->current_mem, l)) {
+        cache->current_mem = 0;
+        memcpy(cache->Q, work->Yk, l * sizeof (scs_float));
+        if (scs_anderson_qr_append(cache, 0, l)) cache->current_mem = 1;
+    } else {
+        cache->current_mem++;
+    }
+
+    if (cache->current_mem > 0) {
+        /* Solve the least squares problem min ||Yt - R||: t = R^{-1} Q' R */
+        memset(cache->t, 0, cache->current_mem * sizeof (scs_float));
+        scs_matrix_transpose_multiply(cache->current_mem, 1, l, 1.0, cache->Q, 0.0, work->R, cache->t);
+        scs_anderson_back_substitution(cache, cache->current_mem);
+        scs_anderson_update_direction(work, cache->current_mem);
+    }
+    cache->cond = scs_anderson_qr_cond(cache, cache->current_mem);
+
+    cache->mem_cursor++; /* move the cursor */
+    if (cache->mem_cursor >= cache->mem)
+        cache->mem_cursor = 0;
+
+    return SCS_DIRECTION_SUCCESS;
+}
 
+/* a'x and a'y in a single pass over a */
+static void scs_dot2(
+        const scs_float * RESTRICT a,
+        const scs_float * RESTRICT x,
+        const scs_float * RESTRICT y,
+        scs_int len,
+        scs_float * RESTRICT ax,
+        scs_float * RESTRICT ay) {
+    scs_int i;
+    scs_float sx = 0, sy = 0;
+    for (i = 0; i < len; ++i) {
+        sx += a[i] * x[i];
+        sy += a[i] * y[i];
+    }
+    *ax = sx;
+    *ay = sy;
+}
 
+/*
+ * Cholesky factorization R'R of the regularized Gram matrix of the k columns
+ * of Y starting at slot `first` (circularly); R is stored in cache->R. Returns
+ * 0 if the matrix is not (numerically) positive definite or its estimated
+ * condition number exceeds scs_anderson_gram_max_cond.
+ */
+static scs_int scs_anderson_gram_cholesky(
+        ScsDirectionCache * RESTRICT cache,
+        scs_int first,
+        scs_int k) {
+    const scs_int mem = cache->mem;
+    const scs_float * RESTRICT G = cache->G;
+    scs_float * RESTRICT R = cache->R;
+    scs_float reg = 0, d, d_min, d_max = 0;
+    scs_int i, j, p, si, sj;
+
+    for (i = 0; i < k; ++i) {
+        si = (first + i) % mem;
+        reg = MAX(reg, G[si + si * mem]);
+    }
+    reg *= scs_anderson_gram_reg;
+    d_min = INFINITY;
+    for (j = 0; j < k; ++j) {
+        sj = (first + j) % mem;
+        for (i = 0; i < j; ++i) {
+            si = (first + i) % mem;
+            d = G[si + sj * mem];
+            for (p = 0; p < i; ++p) {
+                d -= R[p + i * mem] * R[p + j * mem];
+            }
+            R[i + j * mem] = d / R[i + i * mem];
+        }
+        d = G[sj + sj * mem] + reg;
+        for (p = 0; p < j; ++p) {
+            d -= R[p + j * mem] * R[p + j * mem];
+        }
+        if (!(d > 0)) {
+            return 0;
+        }
+        R[j + j * mem] = SQRTF(d);
+        d_min = MIN(d_min, R[j + j * mem]);
+        d_max = MAX(d_max, R[j + j * mem]);
+    }
+    cache->cond = (d_max / d_min) * (d_max / d_min);
+    return cache->cond <= scs_anderson_gram_max_cond;
+}
+
+/*
+ * Falls back to the QR factorization of the k columns of Y starting at slot
+ * `first`, which is computed from scratch. If a column is linearly dependent
+ * on the older ones, those are dropped. Returns the number of columns kept
+ * (the most recent ones) and leaves the solution of the least squares problem
+ * in cache->t.
+ */
+static scs_int scs_anderson_gram_fallback(
+        ScsWork * RESTRICT work,
+        scs_int first,
+        scs_int k) {
+    ScsDirectionCache * RESTRICT cache = work->direction_cache;
+    const scs_int l = work->l;
+    const scs_cache_float * y_i;
+    scs_int i, cols = 0;
+
+    for (i = 0; i < k; ++i) {
+        y_i = cache->U + ((first + i) % cache->mem) * l;
+        scs_cache_load(cache->Q + cols * l, y_i, l);
+        if (scs_anderson_qr_append(cache, cols, l)) {
+            cols++;
+        } else {
+            scs_cache_load(cache->Q, y_i, l);
+            cols = scs_anderson_qr_append(cache, 0, l);
+        }
+    }
+    if (cols > 0) {
+        memset(cache->t, 0, cols * sizeof (scs_float));
+        scs_matrix_transpose_multiply(cols, 1, l, 1.0, cache->Q, 0.0, work->R, cache->t);
+        scs_anderson_back_substitution(cache, cols);
+    }
+    return cols;
+}
+
+scs_int scs_compute_dir_anderson_gram(ScsWork *work) {
+    ScsDirectionCache * cache = work->direction_cache;
+    const scs_int l = work->l;
+    const scs_int mem = cache->mem;
+    const scs_int cursor = cache->mem_cursor;
+    scs_float * t = cache->t;
+    scs_float * G = cache->G;
+    scs_int k, first, i, j, slot;
 
     /* d [work->dir] = -R [work->R] */
     scs_set_as_scaled_array(work->dir, work->R, -1.0, l);
 
-    s_current = cache->S + (cache->mem_cursor * l);
-    y_current = cache->U + (cache->mem_cursor * l);
-    s_minus_y_current = cache->S_minus_Y + (cache->mem_cursor * l);
-
-    memcpy(s_current, work->Sk, l * sizeof (scs_float));
-    memcpy(y_current, work->Yk, l * sizeof (scs_float));
-
-    cache->current_mem++; /* increment the current memory */
-    if (cache->current_mem > cache->mem)
-        cache->current_mem = cache->mem;
-
-    colsY = cache->current_mem;
-
-    /* Construct matrix S-Y by subtracting one pair of vecs at a time */
-    scs_axpy(s_minus_y_current, s_current, y_current, 1.0, -1.0, l);
-
-    /* Solve Yt = R with SVD (we need to copy Y into a different memory positions
-     * because svdls modifies it (see the documentation of svdls). */
-    memcpy(cache->t, work->R, l * sizeof (scs_float));
-    memcpy(copy_cache_Y, cache->U, l * colsY * sizeof (scs_float));
-
-#ifdef SVD_ACTIVATED
-    /* Solve LS with SVD */
-    scs_svdls(l, colsY,
-            copy_cache_Y,
-            cache->t,
-            cache->ls_wspace,
-            cache->ls_wspace_length,
-            rcond,
-            singular_values,
-            &rank);
-#else   
-    /* Solve LS with QR */
-    scs_qrls(l, colsY,
-            copy_cache_Y,
-            cache->t,
-            cache->ls_wspace,
-            cache->ls_wspace_length);
-#endif
+    /* Store s - y and y at the position of the cursor */
+    scs_cache_store(cache->S_minus_Y + cursor * l, work->Sk, work->Yk, 1.0, -1.0, l);
+    scs_cache_copy(cache->U + cursor * l, work->Yk, l);
+
+    k = MIN(cache->current_mem + 1, cache->mem_active);
+    first = (cursor - k + 1 + mem) % mem;
+
+    /*
+     * New row and column of Y'Y and the right-hand side Y'R in one pass. The
+     * products are taken with the cached y (not work->Yk) so that G is the
+     * Gram matrix of the vectors actually stored, which differ from the y_i
+     * when CACHE_FLOAT is defined; otherwise G may be indefinite.
+     */
+    for (i = 0; i < k; ++i) {
+        slot = (first + i) % mem;
+        scs_cache_dot2(cache->U + slot * l, cache->U + cursor * l, work->R, l,
+                G + slot + cursor * mem, t + i);
+        G[cursor + slot * mem] = G[slot + cursor * mem];
+    }
 
-    /* dir = dir - S_minus_Y * t */
-    scs_matrix_multiply(l, 1, colsY, -1.0,
-            cache->S_minus_Y, 1.0, cache->t, work->dir);
+    /* Solve (Y'Y + reg I) t = Y'R, i.e., R'R t = Y'R */
+    if (scs_anderson_gram_cholesky(cache, first, k)) {
+        for (i = 0; i < k; ++i) {
+            for (j = 0; j < i; ++j) {
+                t[i] -= cache->R[j + i * mem] * t[j];
+            }
+            t[i] /= cache->R[i + i * mem];
+        }
+        scs_anderson_back_substitution(cache, k);
+    } else {
+        k = scs_anderson_gram_fallback(work, first, k);
+        cache->cond = scs_anderson_qr_cond(cache, k);
+    }
+    cache->current_mem = k;
+
+    if (k > 0) {
+        scs_anderson_update_direction(work, k);
+    }
 
     cache->mem_cursor++; /* move the cursor */
-    if (cache->mem_cursor >= cache->mem)
+    if (cache->mem_cursor >= mem)
         cache->mem_cursor = 0;
 
     return SCS_DIRECTION_SUCCESS;
 }
 
+/*
+ * Applies the k cached rank-one updates to x and z, that is,
+ *
+ *   x <- (I + u_{k-1} s_{k-1}') ... (I + u_0 s_0') x,
+ *
+ * and likewise for z. Writing x_{i+1} = x_i + a_i u_i with a_i = <s_i, x_i>,
+ * the coefficients solve the unit lower triangular system
+ *
+ *   a_i - sum_{j<i} <s_i, u_j> a_j = <s_i, x_0>,
+ *
+ * whose matrix is kept in cache->StU, so that x is updated with one pass over
+ * S and one over U (and the same for z). The coefficients are stored in
+ * cache->t (for x) and cache->t + mem (for z).
+ */
+static void scs_broyden_apply_updates(
+        ScsDirectionCache * RESTRICT cache,
+        scs_float * RESTRICT x,
+        scs_float * RESTRICT z,
+        scs_int k,
+        scs_int l) {
+    const scs_int ld = cache->mem;
+    const scs_float * RESTRICT StU = cache->StU;
+    scs_float * RESTRICT a = cache->t;
+    scs_float * RESTRICT b = cache->t + ld;
+    scs_int i, j;
+
+    if (k == 0) return;
+
+    scs_cache_transpose_multiply(k, l, cache->S, x, a);
+    scs_cache_transpose_multiply(k, l, cache->S, z, b);
+    for (i = 1; i < k; ++i) {
+        for (j = 0; j < i; ++j) {
+            a[i] += StU[i + j * ld] * a[j];
+            b[i] += StU[i + j * ld] * b[j];
+        }
+    }
+    scs_cache_multiply(l, k, 1.0, cache->U, a, x);
+    scs_cache_multiply(l, k, 1.0, cache->U, b, z);
+}
+
 scs_int scs_compute_dir_restarted_broyden(ScsWork *work) {
     /* --- DECLARATIONS --- */
     ScsDirectionCache * cache; /* the SU cache (pointer) */
     scs_int i; /* index */
+    scs_int k; /* number of cached pairs */
     scs_float * s_tilde_current; /* s_tilde (which is updated) */
-    scs_float * u_new; /* new value of u */
+    scs_cache_float * u_new; /* new value of u */
     scs_float ip; /* temporary float to store inner products */
     scs_float s_norm_sq; /* scalar gamma as in (6.5e) */
     scs_float theta = 0; /* theta */
     const scs_int l = work->l; /* size of vectors */
     const scs_float theta_bar = work->stgs->thetabar; /* parameter in Powell's trick */
+    const scs_float one = 1.0;
 
     cache = work->direction_cache; /* cache of Sk and Uk */
+    k = cache->mem_cursor;
 
     /* d [work->dir] = -R [work->R] */
     scs_set_as_scaled_array(work->dir, work->R, -1.0, l);
 
-    /* s_tilde_current = y [work->Yk]                                           */
-    /* use the end of the cache to store s_tilde_current                        */
-    /* later we use the same position of the S-buffer to store the current Sk   */
-    s_tilde_current = cache->S + (cache->mem_cursor * l);
+    /* s_tilde_current = y [work->Yk] (stored in the workspace of the cache) */
+    s_tilde_current = cache->ws;
     memcpy(s_tilde_current, work->Yk, l * sizeof (scs_float));
 
     /* update s and d */
-    for (i = 0; i < cache->mem_cursor; ++i) {
-        scs_float * s_i; /* pointer to the current value of s_i */
-        scs_float * u_i; /* pointer to the current value of u_i */
-        s_i = cache->S + i * l; /* retrieve s_i from the cache */
-        u_i = cache->U + i * l; /* retrieve u_i from the cache */
-        ip = scs_inner_product(s_i, s_tilde_current, l);
-        scs_add_scaled_array(s_tilde_current, u_i, l, ip); /* update s_tilde */
-        ip = scs_inner_product(s_i, work->dir, l);
-        scs_add_scaled_array(work->dir, u_i, l, ip); /* update direction */
-    }
+    scs_broyden_apply_updates(cache, s_tilde_current, work->dir, k, l);
 
     /* compute theta */
-    ip = scs_inner_product(s_tilde_current, work->Sk, l);
-    s_norm_sq = scs_norm_squared(work->Sk, l);
+    scs_dot2(work->Sk, s_tilde_current, work->Sk, l, &ip, &s_norm_sq);
 
     if (ABS(ip) >= theta_bar * s_norm_sq) {
         theta = 1;
+        cache->cond = 1.0;
     } else {
+        /* the update is (nearly) singular and has to be safeguarded */
+        cache->cond = INFINITY;
         theta = s_norm_sq * (1 - SGN(ip) * theta_bar) / (s_norm_sq - ip);
         /* s_tilde_current = (1-theta)*s + theta*s_tilde_current */
-        scs_axpy(s_tilde_current, s_tilde_current, work->Sk, theta, 1 - theta, l);
+        scs_scale_array(s_tilde_current, theta, l);
+        scs_add_scaled_array(s_tilde_current, work->Sk, l, 1 - theta);
     }
 
     /* FINALISE */
 
     /* update u_new (at the end of the buffer) */
-    u_new = cache->U + (cache->mem_cursor * l);
+    u_new = cache->U + (k * l);
     ip = (1 - theta) * s_norm_sq + theta * ip;
-    for (i = 0; i < l; ++i) {
-        u_new[i] = (work->Sk[i] - s_tilde_current[i]) / ip;
-    }
+    scs_cache_store(u_new, work->Sk, s_tilde_current, 1 / ip, -1 / ip, l);
     /* update direction */
     ip = scs_inner_product(work->Sk, work->dir, l); /* s'd */
-    scs_add_scaled_array(work->dir, u_new, l, ip);
+    scs_cache_multiply(l, 1, ip, u_new, &one, work->dir);
 
     /* push s into the buffer */
-    memcpy(s_tilde_current, work->Sk, l * sizeof (scs_float));
+    scs_cache_copy(cache->S + (k * l), work->Sk, l);
 
     cache->mem_cursor++; /* move the cursor */
 
     /* if the cursor has exceeded the last position, reset the cache */
-    if (cache->mem_cursor >= cache->mem) {
+    if (cache->mem_cursor >= cache->mem_active) {
         return scs_reset_direction_cache(cache); /* returns SCS_DIRECTION_CACHE_RESET */
     }
 
+    /* new row of StU: <s_k, u_j> for j < k */
+    if (k > 0) {
+        scs_float * RESTRICT StU_row = cache->t;
+        scs_cache_transpose_multiply(k, l, cache->U, work->Sk, StU_row);
+        for (i = 0; i < k; ++i) {
+            cache->StU[k + i * cache->mem] = StU_row[i];
+        }
+    }
+
     return SCS_DIRECTION_CACHE_INCREMENT;
 }
 
-/* LCOV_EXCL_START */
-scs_int scs_compute_dir_full_broyden(ScsWork *work, scs_int i) {
-    scs_float ip = 0;
-    scs_float tmp = 0;
-
-    if (i == 0 || HY == SCS_NULL) {
-        /* HY is allocated the first time this function is called (that is, for i==0) */
-        HY = malloc(work->l * sizeof (*HY));
-        if (HY == SCS_NULL) {
-            scs_printf("ERROR: allocating `HY` in `scs_compute_dir_full_broyden` failure\n");
-            return SCS_DIRECTION_ERROR;
+/*
+ * The middle matrix of the compact representation of the full Broyden method
+ * (see scs_compute_dir_full_broyden) is considered singular if one of its
+ * pivots is smaller than this tolerance times its largest entry.
+ */
+static const scs_float scs_broyden_singularity_tol = 1e-10;
+
+/* s_a's, s_a'y, s_a'r and y_a's in a single pass */
+static void scs_broyden_dot4(
+        const scs_cache_float * RESTRICT s_a,
+        const scs_cache_float * RESTRICT y_a,
+        const scs_float * RESTRICT s,
+        const scs_float * RESTRICT y,
+        const scs_float * RESTRICT r,
+        scs_int len,
+        scs_float * RESTRICT out) {
+    scs_int i;
+    scs_float ss = 0, sy = 0, sr = 0, ys = 0;
+    for (i = 0; i < len; ++i) {
+        ss += s_a[i] * s[i];
+        sy += s_a[i] * y[i];
+        sr += s_a[i] * r[i];
+        ys += y_a[i] * s[i];
+    }
+    out[0] = ss;
+    out[1] = sy;
+    out[2] = sr;
+    out[3] = ys;
+}
+
+/*
+ * Middle matrix M = h0 S'Y - L of the k pairs starting at slot `first`
+ * (circularly), where L is the strictly lower triangular part of S'S; it is
+ * stored in cache->R.
+ */
+static void scs_broyden_middle_matrix(
+        ScsDirectionCache * RESTRICT cache,
+        scs_int first,
+        scs_int k) {
+    const scs_int slots = cache->mem + 1;
+    const scs_float h0 = cache->h0;
+    scs_int i, j, si, sj;
+    for (j = 0; j < k; ++j) {
+        sj = (first + j) % slots;
+        for (i = 0; i < k; ++i) {
+            si = (first + i) % slots;
+            cache->R[i + j * cache->mem] = h0 * cache->StU[si + sj * slots]
+                    - (i > j ? cache->G[si + sj * slots] : 0.0);
         }
     }
+}
 
-    if ((work->stgs->broyden_init_scaling && i == 1)
-            || (work->stgs->tRule == 1 || work->stgs->tRule == 2)) {
-        ip = scs_inner_product(work->Yk, work->Sk, work->l);
+/*
+ * b <- A^{-1} b by Gaussian elimination with partial pivoting; the k-by-k
+ * matrix A (leading dimension ld) is overwritten. Returns 0 if A is
+ * (numerically) singular. The ratio of the largest entry of A to its smallest
+ * pivot is stored in `cond`.
+ */
+static scs_int scs_broyden_solve(
+        scs_float * RESTRICT A,
+        scs_int ld,
+        scs_float * RESTRICT b,
+        scs_int k,
+        scs_float * RESTRICT cond) {
+    scs_float a_max = 0, p_min = INFINITY, tmp, f;
+    scs_int i, j, p, piv;
+
+    for (i = 0; i < k * ld; ++i) {
+        a_max = MAX(a_max, ABS(A[i]));
+    }
+    for (p = 0; p < k; ++p) {
+        piv = p;
+        for (i = p + 1; i < k; ++i) {
+            if (ABS(A[i + p * ld]) > ABS(A[piv + p * ld])) piv = i;
+        }
+        if (!(ABS(A[piv + p * ld]) > scs_broyden_singularity_tol * a_max)) {
+            *cond = INFINITY;
+            return 0;
+        }
+        p_min = MIN(p_min, ABS(A[piv + p * ld]));
+        if (piv != p) {
+            for (j = p; j < k; ++j) {
+                tmp = A[p + j * ld];
+                A[p + j * ld] = A[piv + j * ld];
+                A[piv + j * ld] = tmp;
+            }
+            tmp = b[p];
+            b[p] = b[piv];
+            b[piv] = tmp;
+        }
+        for (i = p + 1; i < k; ++i) {
+            f = A[i + p * ld] / A[p + p * ld];
+            for (j = p + 1; j < k; ++j) {
+                A[i + j * ld] -= f * A[p + j * ld];
+            }
+            b[i] -= f * b[p];
+        }
+    }
+    for (i = k - 1; i >= 0; --i) {
+        for (j = i + 1; j < k; ++j) {
+            b[i] -= A[i + j * ld] * b[j];
+        }
+        b[i] /= A[i + i * ld];
     }
+    *cond = k > 0 ? a_max / p_min : 1.0;
+    return 1;
+}
 
-    if (work->stgs->broyden_init_scaling && i == 1) {
-        scs_int i;
-        tmp = ip / scs_norm(work->Yk, work->l);
-        for (i = 0; i < work->l; ++i) {
-            work->H[i * (work->l + 1)] = tmp;
+/*
+ * x <- x + alpha * X z, where the columns of X are the k vectors of a
+ * circular buffer with `slots` positions starting at slot `first`.
+ */
+static void scs_broyden_window_multiply(
+        const scs_cache_float * RESTRICT X,
+        scs_int slots,
+        scs_int first,
+        scs_int k,
+        scs_int l,
+        scs_float alpha,
+        const scs_float * RESTRICT z,
+        scs_float * RESTRICT x) {
+    const scs_int cols_first = MIN(k, slots - first);
+    if (k == 0) return;
+    scs_cache_multiply(l, cols_first, alpha, X + first * l, z, x);
+    if (cols_first < k) {
+        scs_cache_multiply(l, k - cols_first, alpha, X, z + cols_first, x);
+    }
+}
+
+scs_int scs_compute_dir_full_broyden(ScsWork *work) {
+    ScsDirectionCache * cache = work->direction_cache;
+    const scs_int l = work->l;
+    const scs_int mem = cache->mem;
+    const scs_int slots = mem + 1;
+    const scs_int c = cache->mem_cursor;
+    const scs_float theta_bar = work->stgs->thetabar;
+    scs_float * RESTRICT ss = cache->t; /* s_j's */
+    scs_float * RESTRICT sy = cache->t + slots; /* s_j'y */
+    scs_float * RESTRICT sr = cache->t + 2 * slots; /* s_j'R */
+    scs_float * RESTRICT ys = cache->t + 3 * slots; /* y_j's */
+    scs_float * RESTRICT z = cache->t + 4 * slots;
+    scs_float * RESTRICT y_new = cache->ws;
+    scs_float dots[4];
+    scs_float s_norm_sq, s_y, s_Hy, theta = 1, h0, tmp;
+    scs_int k = cache->current_mem;
+    scs_int first = (c - k + slots) % slots;
+    scs_int j, jj, a, b, drop;
+
+    /* --- inner products of s, y and R with the cached pairs (one pass) --- */
+    for (j = 0; j < k; ++j) {
+        a = (first + j) % slots;
+        scs_broyden_dot4(cache->S + a * l, cache->U + a * l,
+                work->Sk, work->Yk, work->R, l, dots);
+        ss[j] = dots[0];
+        sy[j] = dots[1];
+        sr[j] = dots[2];
+        ys[j] = dots[3];
+    }
+    scs_cache_copy(cache->S + c * l, work->Sk, l);
+    scs_broyden_dot4(cache->S + c * l, cache->S + c * l,
+            work->Sk, work->Yk, work->R, l, dots);
+    s_norm_sq = dots[0];
+    s_y = dots[1];
+    sr[k] = dots[2];
+
+    if (k == 0) {
+        /* H0 = h0 I, scaled using the first pair */
+        tmp = work->stgs->broyden_init_scaling ? scs_norm_squared(work->Yk, l) : 0;
+        cache->h0 = (tmp > 0 && s_y > 0) ? s_y / tmp : 1.0;
+    }
+    h0 = cache->h0;
+
+    /* --- <s, H y> with H = h0 I + (S - h0 Y) M^{-1} h0 S' --- */
+    s_Hy = h0 * s_y;
+    if (k > 0) {
+        scs_broyden_middle_matrix(cache, first, k);
+        for (j = 0; j < k; ++j) z[j] = h0 * sy[j];
+        if (scs_broyden_solve(cache->R, mem, z, k, &cache->cond)) {
+            for (j = 0; j < k; ++j) {
+                s_Hy += (ss[j] - h0 * ys[j]) * z[j];
+            }
+        } else {
+            /* restart the memory */
+            sr[0] = sr[k];
+            first = c;
+            k = 0;
+            s_Hy = h0 * s_y;
         }
     }
 
+    /* --- Powell's safeguard: y is replaced by theta y + (1-theta) B s --- */
+    if (ABS(s_Hy) < theta_bar * s_norm_sq) {
+        theta = s_norm_sq * (1 - SGN(s_Hy) * theta_bar) / (s_norm_sq - s_Hy);
+    }
+
+    cache->G[c + c * slots] = s_norm_sq;
+    for (j = 0; j < k; ++j) {
+        a = (first + j) % slots;
+        cache->G[a + c * slots] = ss[j];
+        cache->G[c + a * slots] = ss[j];
+        cache->StU[c + a * slots] = ys[j];
+    }
+    if (theta == 1) {
+        scs_cache_copy(cache->U + c * l, work->Yk, l);
+        for (j = 0; j < k; ++j) {
+            cache->StU[(first + j) % slots + c * slots] = sy[j];
+        }
+        cache->StU[c + c * slots] = s_y;
+    } else {
+        /* B s = s / h0 + (Y - S / h0) N^{-1} S's, N = upper triangular part of S'S */
+        for (j = k - 1; j >= 0; --j) {
+            a = (first + j) % slots;
+            z[j] = ss[j];
+            for (jj = j + 1; jj < k; ++jj) {
+                z[j] -= cache->G[a + ((first + jj) % slots) * slots] * z[jj];
+            }
+            z[j] /= cache->G[a + a * slots];
+        }
+        scs_axpy(y_new, work->Yk, work->Sk, theta, (1 - theta) / h0, l);
+        scs_broyden_window_multiply(cache->U, slots, first, k, l, 1 - theta, z, y_new);
+        scs_broyden_window_multiply(cache->S, slots, first, k, l, -(1 - theta) / h0, z, y_new);
+        scs_cache_copy(cache->U + c * l, y_new, l);
+        /* s_j'y_new and s'y_new from the cached inner products */
+        for (j = 0; j < k; ++j) {
+            a = (first + j) % slots;
+            tmp = ss[j] / h0;
+            for (jj = 0; jj < k; ++jj) {
+                b = (first + jj) % slots;
+                tmp += (cache->StU[a + b * slots] - cache->G[a + b * slots] / h0) * z[jj];
+            }
+            cache->StU[a + c * slots] = theta * sy[j] + (1 - theta) * tmp;
+        }
+        tmp = s_norm_sq / h0;
+        for (jj = 0; jj < k; ++jj) {
+            tmp += (ys[jj] - ss[jj] / h0) * z[jj];
+        }
+        cache->StU[c + c * slots] = theta * s_y + (1 - theta) * tmp;
+    }
+
+    /* --- push the new pair, dropping the oldest ones if the memory is full --- */
+    drop = MAX(0, k + 1 - cache->mem_active);
+    first = (first + drop) % slots;
+    k = k + 1 - drop;
+    cache->mem_cursor = (c + 1) % slots;
+
+    /* --- d = -H R = -h0 R - (S - h0 Y) M^{-1} h0 S'R --- */
+    scs_set_as_scaled_array(work->dir, work->R, -h0, l);
+    scs_broyden_middle_matrix(cache, first, k);
+    for (j = 0; j < k; ++j) z[j] = h0 * sr[j + drop];
+    if (!scs_broyden_solve(cache->R, mem, z, k, &cache->cond)) {
+        /* restart the memory keeping only the newest pair */
+        z[0] = h0 * sr[k - 1 + drop];
+        first = c;
+        k = 1;
+        scs_broyden_middle_matrix(cache, first, k);
+        if (!scs_broyden_solve(cache->R, mem, z, k, &cache->cond)) k = 0;
+    }
+    scs_broyden_window_multiply(cache->S, slots, first, k, l, -1.0, z, work->dir);
+    scs_broyden_window_multiply(cache->U, slots, first, k, l, h0, z, work->dir);
+    cache->current_mem = k;
+
     return SCS_DIRECTION_SUCCESS;
 }
 
-/* LCOV_EXCL_STOP */
-
 scs_int scs_compute_direction(ScsWork *work, scs_int i) {
     scs_int status = SCS_DIRECTION_SUCCESS;
 
@@ -234,23 +948,22 @@ scs_int scs_compute_direction(ScsWork *work, scs_int i) {
             status = scs_compute_dir_restarted_broyden(work);
             break;
         case anderson_acceleration:
-            status = scs_compute_dir_anderson(work);
+            status = work->stgs->anderson_gram
+                    ? scs_compute_dir_anderson_gram(work)
+                    : scs_compute_dir_anderson(work);
             break;
         case full_broyden:
-            status = scs_compute_dir_full_broyden(work, i);
+            status = scs_compute_dir_full_broyden(work);
             break;
         default:
             /* Not implemented yet */
             status = SCS_DIRECTION_ERROR;
     }
 
+    if (status >= 0 && work->stgs->adaptive_memory && work->direction_cache != SCS_NULL) {
+        scs_adapt_memory(work);
+    }
+
     return status;
 }
 
-/* LCOV_EXCL_START */
-void scs_free_full_broyden() {
-    if (HY != SCS_NULL) {
-        scs_free(HY);
-    }
-}
-/* LCOV_EXCL_STOP */
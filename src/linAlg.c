@@ -130,20 +130,24 @@ extern void LPCK(gelss)(
 
 
 /* LCOV_EXCL_START */
-#define SCS_DGEMM_NN_MC  384
-#define SCS_DGEMM_NN_KC  384
-#define SCS_DGEMM_NN_NC  4096
+/*
+ * Block sizes; the packed panels of A (MC x KC) and B (KC x NC) are kept on
+ * the stack of scs_dgemm_nn (144KB with the defaults), so they must not be
+ * too large
+ */
+#ifndef SCS_DGEMM_NN_MC
+#define SCS_DGEMM_NN_MC  96
+#endif
+#ifndef SCS_DGEMM_NN_KC
+#define SCS_DGEMM_NN_KC  96
+#endif
+#ifndef SCS_DGEMM_NN_NC
+#define SCS_DGEMM_NN_NC  96
+#endif
 
 #define SCS_DGEMM_NN_MR  4
 #define SCS_DGEMM_NN_NR  4
 
-/* 
- *   Local buffers for storing panels from A, B and C
- */
-static double SCS_DGEMM_NN__A[SCS_DGEMM_NN_MC*SCS_DGEMM_NN_KC];
-static double SCS_DGEMM_NN__B[SCS_DGEMM_NN_KC*SCS_DGEMM_NN_NC];
-static double SCS_DGEMM_NN__C[SCS_DGEMM_NN_MR*SCS_DGEMM_NN_NR];
-
 /*
  *  Packing complete panels from A (i.e. without padding)
  */
@@ -369,10 +373,13 @@ scs_dgemm_macro_kernel(int mc,
         int nc,
         int kc,
         double alpha,
+        const double *_A,
+        const double *_B,
         double beta,
         double *C,
         int incRowC,
         int incColC) {
+    double _C[SCS_DGEMM_NN_MR * SCS_DGEMM_NN_NR];
     int mp = (mc + SCS_DGEMM_NN_MR - 1) / SCS_DGEMM_NN_MR;
     int np = (nc + SCS_DGEMM_NN_NR - 1) / SCS_DGEMM_NN_NR;
 
@@ -390,17 +397,17 @@ scs_dgemm_macro_kernel(int mc,
             mr = (i != mp - 1 || _mr == 0) ? SCS_DGEMM_NN_MR : _mr;
 
             if (mr == SCS_DGEMM_NN_MR && nr == SCS_DGEMM_NN_NR) {
-                scs_dgemm_micro_kernel(kc, alpha, &SCS_DGEMM_NN__A[i * kc * SCS_DGEMM_NN_MR], &SCS_DGEMM_NN__B[j * kc * SCS_DGEMM_NN_NR],
+                scs_dgemm_micro_kernel(kc, alpha, &_A[i * kc * SCS_DGEMM_NN_MR], &_B[j * kc * SCS_DGEMM_NN_NR],
                         beta,
                         &C[i * SCS_DGEMM_NN_MR * incRowC + j * SCS_DGEMM_NN_NR * incColC],
                         incRowC, incColC);
             } else {
-                scs_dgemm_micro_kernel(kc, alpha, &SCS_DGEMM_NN__A[i * kc * SCS_DGEMM_NN_MR], &SCS_DGEMM_NN__B[j * kc * SCS_DGEMM_NN_NR],
+                scs_dgemm_micro_kernel(kc, alpha, &_A[i * kc * SCS_DGEMM_NN_MR], &_B[j * kc * SCS_DGEMM_NN_NR],
                         0.0,
-                        SCS_DGEMM_NN__C, 1, SCS_DGEMM_NN_MR);
+                        _C, 1, SCS_DGEMM_NN_MR);
                 scs_dgescal(mr, nr, beta,
                         &C[i * SCS_DGEMM_NN_MR * incRowC + j * SCS_DGEMM_NN_NR * incColC], incRowC, incColC);
-                scs_dgeaxpy(mr, nr, 1.0, SCS_DGEMM_NN__C, 1, SCS_DGEMM_NN_MR,
+                scs_dgeaxpy(mr, nr, 1.0, _C, 1, SCS_DGEMM_NN_MR,
                         &C[i * SCS_DGEMM_NN_MR * incRowC + j * SCS_DGEMM_NN_NR * incColC], incRowC, incColC);
             }
         }
@@ -472,6 +479,13 @@ scs_dgemm_nn(int m,
     int i, j, l;
 
     double _beta;
+    /* 
+     * packed panels of A and B; they are local so that concurrent calls do
+     * not share any state (MC and NC are multiples of MR and NR, so there is
+     * room for the padding)
+     */
+    double _A[SCS_DGEMM_NN_MC * SCS_DGEMM_NN_KC];
+    double _B[SCS_DGEMM_NN_KC * SCS_DGEMM_NN_NC];
 
     if (alpha == 0.0 || k == 0) {
         scs_dgescal(m, n, beta, C, incRowC, incColC);
@@ -488,16 +502,16 @@ scs_dgemm_nn(int m,
 
             scs_pack_B(kc, nc,
                     &B[l * SCS_DGEMM_NN_KC * incRowB + j * SCS_DGEMM_NN_NC * incColB], incRowB, incColB,
-                    SCS_DGEMM_NN__B);
+                    _B);
 
             for (i = 0; i < mb; ++i) {
                 mc = (i != mb - 1 || _mc == 0) ? SCS_DGEMM_NN_MC : _mc;
 
                 scs_pack_A(mc, kc,
                         &A[i * SCS_DGEMM_NN_MC * incRowA + l * SCS_DGEMM_NN_KC * incColA], incRowA, incColA,
-                        SCS_DGEMM_NN__A);
+                        _A);
 
-                scs_dgemm_macro_kernel(mc, nc, kc, alpha, _beta,
+                scs_dgemm_macro_kernel(mc, nc, kc, alpha, _A, _B, _beta,
                         &C[i * SCS_DGEMM_NN_MC * incRowC + j * SCS_DGEMM_NN_NC * incColC],
                         incRowC, incColC);
             }
@@ -624,8 +638,23 @@ void scs_scale_array(scs_float * RESTRICT a, const scs_float b, scs_int len) {
 #endif    
 }
 
-/* x'*y */
-scs_float scs_inner_product(
+/*
+ * Vectors of length at least SCS_PARALLEL_VECTOR_THRESHOLD are split into
+ * SCS_PARALLEL_VECTOR_BLOCKS contiguous blocks of (almost) equal length which
+ * are processed by the OpenMP threads. The partition does not depend on the
+ * number of threads and the partial sums of reductions are added up in block 
+ * order, so the result is the same for any number of threads (and without 
+ * OpenMP).
+ */
+static scs_int scs_vector_block(scs_int k, scs_int len, scs_int *start) {
+    const scs_int block_len = 
+            (len + SCS_PARALLEL_VECTOR_BLOCKS - 1) / SCS_PARALLEL_VECTOR_BLOCKS;
+    *start = MIN(k * block_len, len);
+    return MIN(block_len, len - *start);
+}
+
+/* x'*y (serial) */
+static scs_float scs_inner_product_block(
         const scs_float * RESTRICT x,
         const scs_float * RESTRICT y,
         scs_int len) {
@@ -668,6 +697,33 @@ scs_float scs_inner_product(
 #endif
 }
 
+/* x'*y */
+scs_float scs_inner_product(
+        const scs_float * RESTRICT x,
+        const scs_float * RESTRICT y,
+        scs_int len) {
+    scs_float partial[SCS_PARALLEL_VECTOR_BLOCKS];
+    scs_float ip = 0.;
+    scs_int k, start, block_len;
+
+    if (len < SCS_PARALLEL_VECTOR_THRESHOLD) {
+        return scs_inner_product_block(x, y, len);
+    }
+#ifdef _OPENMP
+#pragma omp parallel for private(start, block_len) schedule(static)
+#endif
+    for (k = 0; k < SCS_PARALLEL_VECTOR_BLOCKS; ++k) {
+        block_len = scs_vector_block(k, len, &start);
+        partial[k] = block_len > 0
+                ? scs_inner_product_block(x + start, y + start, block_len)
+                : 0.;
+    }
+    for (k = 0; k < SCS_PARALLEL_VECTOR_BLOCKS; ++k) {
+        ip += partial[k];
+    }
+    return ip;
+}
+
 /* ||v||_2^2 */
 scs_float scs_norm_squared(const scs_float * RESTRICT v, scs_int len) {
     return scs_inner_product(v, v, len);
@@ -704,8 +760,8 @@ scs_float scs_norm_infinity(
 #endif
 }
 
-/* saxpy a += sc*b */
-void scs_add_scaled_array(
+/* saxpy a += sc*b (serial) */
+static void scs_add_scaled_array_block(
         scs_float * RESTRICT a,
         const scs_float * RESTRICT b,
         scs_int len,
@@ -740,7 +796,31 @@ void scs_add_scaled_array(
 #endif
 }
 
-void scs_axpy(
+/* saxpy a += sc*b */
+void scs_add_scaled_array(
+        scs_float * RESTRICT a,
+        const scs_float * RESTRICT b,
+        scs_int len,
+        const scs_float sc) {
+    scs_int k, start, block_len;
+
+    if (len < SCS_PARALLEL_VECTOR_THRESHOLD) {
+        scs_add_scaled_array_block(a, b, len, sc);
+        return;
+    }
+#ifdef _OPENMP
+#pragma omp parallel for private(start, block_len) schedule(static)
+#endif
+    for (k = 0; k < SCS_PARALLEL_VECTOR_BLOCKS; ++k) {
+        block_len = scs_vector_block(k, len, &start);
+        if (block_len > 0) {
+            scs_add_scaled_array_block(a + start, b + start, block_len, sc);
+        }
+    }
+}
+
+/* x = alpha*u + beta*v (serial) */
+static void scs_axpy_block(
         scs_float * RESTRICT x,
         const scs_float * RESTRICT u,
         const scs_float * RESTRICT v,
@@ -760,7 +840,7 @@ void scs_axpy(
         scs_scale_array(x, alpha, n);
     }
     /* x += b * v */
-    scs_add_scaled_array(x, v, n, beta);
+    scs_add_scaled_array_block(x, v, n, beta);
 #else
     register scs_int j;
     const scs_int block_size = 4;
@@ -787,6 +867,31 @@ void scs_axpy(
 #endif
 }
 
+void scs_axpy(
+        scs_float * RESTRICT x,
+        const scs_float * RESTRICT u,
+        const scs_float * RESTRICT v,
+        scs_float alpha,
+        scs_float beta,
+        scs_int n) {
+    scs_int k, start, block_len;
+
+    if (n < SCS_PARALLEL_VECTOR_THRESHOLD) {
+        scs_axpy_block(x, u, v, alpha, beta, n);
+        return;
+    }
+#ifdef _OPENMP
+#pragma omp parallel for private(start, block_len) schedule(static)
+#endif
+    for (k = 0; k < SCS_PARALLEL_VECTOR_BLOCKS; ++k) {
+        block_len = scs_vector_block(k, n, &start);
+        if (block_len > 0) {
+            scs_axpy_block(x + start, u + start, v + start,
+                    alpha, beta, block_len);
+        }
+    }
+}
+
 void scs_add_array(
         scs_float * RESTRICT a,
         const scs_float * RESTRICT b,
@@ -818,12 +923,13 @@ void scs_add_array(
 #endif
 }
 
-void scs_subtract_array(
+/* a -= b (serial) */
+static void scs_subtract_array_block(
         scs_float * RESTRICT a,
         const scs_float * RESTRICT b,
         scs_int len) {
 #ifdef LAPACK_LIB_FOUND
-    scs_add_scaled_array(a, b, len, -1.0);
+    scs_add_scaled_array_block(a, b, len, -1.0);
 #else
     register scs_int j = 0;
     const scs_int block_size = 4;
@@ -851,6 +957,27 @@ void scs_subtract_array(
 #endif
 }
 
+void scs_subtract_array(
+        scs_float * RESTRICT a,
+        const scs_float * RESTRICT b,
+        scs_int len) {
+    scs_int k, start, block_len;
+
+    if (len < SCS_PARALLEL_VECTOR_THRESHOLD) {
+        scs_subtract_array_block(a, b, len);
+        return;
+    }
+#ifdef _OPENMP
+#pragma omp parallel for private(start, block_len) schedule(static)
+#endif
+    for (k = 0; k < SCS_PARALLEL_VECTOR_BLOCKS; ++k) {
+        block_len = scs_vector_block(k, len, &start);
+        if (block_len > 0) {
+            scs_subtract_array_block(a + start, b + start, block_len);
+        }
+    }
+}
+
 scs_float scs_norm_difference(
         const scs_float * RESTRICT a,
         const scs_float * RESTRICT b,
@@ -878,6 +1005,65 @@ scs_float scs_norm_infinity_difference(
     return max;
 }
 
+void scs_axpy2(
+        scs_float * RESTRICT x,
+        const scs_float * RESTRICT u,
+        const scs_float * RESTRICT v,
+        scs_float * RESTRICT y,
+        const scs_float * RESTRICT w,
+        const scs_float * RESTRICT z,
+        scs_float beta,
+        scs_int l) {
+    scs_int i;
+    for (i = 0; i < l; ++i) {
+        x[i] = u[i] + beta * v[i];
+        y[i] = w[i] + beta * z[i];
+    }
+}
+
+scs_float scs_difference_weighted_norm_squared(
+        scs_float * RESTRICT x,
+        const scs_float * RESTRICT a,
+        const scs_float * RESTRICT b,
+        scs_float rho,
+        scs_int n,
+        scs_int l) {
+    scs_float nrm_x = 0.0, nrm_y = 0.0, tmp;
+    scs_int i;
+    for (i = 0; i < n; ++i) {
+        tmp = a[i] - b[i];
+        x[i] = tmp;
+        nrm_x += tmp * tmp;
+    }
+    for (i = n; i < l; ++i) {
+        tmp = a[i] - b[i];
+        x[i] = tmp;
+        nrm_y += tmp * tmp;
+    }
+    return rho * nrm_x + nrm_y;
+}
+
+void scs_scaled_difference2(
+        scs_float * RESTRICT x,
+        const scs_float * RESTRICT a,
+        const scs_float * RESTRICT b,
+        scs_float * RESTRICT y,
+        const scs_float * RESTRICT c,
+        const scs_float * RESTRICT d,
+        scs_float gamma,
+        scs_int n,
+        scs_int l) {
+    scs_int i;
+    for (i = 0; i < n; ++i) {
+        x[i] = gamma * (a[i] - b[i]);
+        y[i] = gamma * (c[i] - d[i]);
+    }
+    for (i = n; i < l; ++i) {
+        x[i] = a[i] - b[i];
+        y[i] = c[i] - d[i];
+    }
+}
+
 scs_float * scs_cgls_malloc_workspace(scs_int m, scs_int n) {
     const scs_int maxmn = m > n ? m : n;
     if (m <= 0 || n <= 0) {
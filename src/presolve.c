@@ -0,0 +1,398 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 Pantelis Sopasakis (https://alphaville.github.io),
+ *                    Krina Menounou (https://www.linkedin.com/in/krinamenounou), 
+ *                    Panagiotis Patrinos (http://homes.esat.kuleuven.be/~ppatrino)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * 
+ */
+#include "presolve.h"
+#include "linsys/amatrix.h"
+
+/* orders the second-order cones by dimension and, for equal dimensions, by index */
+static int scs_presolve_compare_soc(const void * a, const void * b) {
+    const scs_int * pa = (const scs_int *) a;
+    const scs_int * pb = (const scs_int *) b;
+    if (pa[0] != pb[0]) return pa[0] < pb[0] ? -1 : 1;
+    return pa[1] < pb[1] ? -1 : (pa[1] > pb[1]);
+}
+
+/* whether the cone is already in canonical form */
+static scs_int scs_presolve_is_canonical(const ScsCone * RESTRICT cone) {
+    scs_int i;
+    for (i = 0; i < cone->qsize; ++i) {
+        if (cone->q[i] <= 1 || (i > 0 && cone->q[i] < cone->q[i - 1])) return 0;
+    }
+    for (i = 0; i < cone->ssize; ++i) {
+        if (cone->s[i] <= 1) return 0;
+    }
+    return 1;
+}
+
+/*
+ * Computes the canonical cone and the row permutation; the rows are ordered
+ * as f, l, folded cones, box, q (sorted), rq, s, ep, ed, p.
+ */
+static scs_int scs_presolve_build_cone(
+        ScsPresolve * RESTRICT presolve,
+        const ScsCone * RESTRICT cone) {
+    ScsCone * kc = presolve->cone;
+    scs_int * RESTRICT perm = presolve->row_perm;
+    scs_int * RESTRICT q_start;
+    scs_int * RESTRICT q_order;
+    scs_int i, j, row, rq_offset, nq = 0, ns = 0, r = 0;
+    const scs_int box_start = cone->f + cone->l;
+    const scs_int q_offset = box_start + cone->bsize;
+    scs_int s_offset = q_offset;
+
+    for (i = 0; i < cone->qsize; ++i) {
+        s_offset += cone->q[i];
+        nq += cone->q[i] > 1;
+    }
+    rq_offset = s_offset;
+    for (i = 0; i < cone->rqsize; ++i) {
+        s_offset += cone->rq[i];
+    }
+    for (i = 0; i < cone->ssize; ++i) {
+        ns += cone->s[i] > 1;
+    }
+
+    q_start = scs_malloc((cone->qsize + 1) * sizeof (scs_int));
+    q_order = scs_malloc(2 * (nq + 1) * sizeof (scs_int));
+    kc->q = nq > 0 ? scs_malloc(nq * sizeof (scs_int)) : SCS_NULL;
+    kc->s = ns > 0 ? scs_malloc(ns * sizeof (scs_int)) : SCS_NULL;
+    if (q_start == SCS_NULL || q_order == SCS_NULL
+            || (nq > 0 && kc->q == SCS_NULL) || (ns > 0 && kc->s == SCS_NULL)) {
+        /* LCOV_EXCL_START */
+        scs_free(q_start);
+        scs_free(q_order);
+        return -1;
+        /* LCOV_EXCL_STOP */
+    }
+
+    /* f and l rows are kept in place */
+    for (row = 0; row < box_start; ++row) {
+        perm[r++] = row;
+    }
+    /* 1-dimensional SOCs and 1x1 PSD cones are appended to the LP block */
+    q_start[0] = q_offset;
+    for (i = 0; i < cone->qsize; ++i) {
+        q_start[i + 1] = q_start[i] + cone->q[i];
+        if (cone->q[i] == 1) perm[r++] = q_start[i];
+    }
+    row = s_offset;
+    for (i = 0; i < cone->ssize; ++i) {
+        if (cone->s[i] == 1) perm[r++] = row;
+        row += (cone->s[i] * (cone->s[i] + 1)) / 2;
+    }
+    kc->f = cone->f;
+    kc->l = r - cone->f;
+    /* box cone */
+    for (row = box_start; row < q_offset; ++row) {
+        perm[r++] = row;
+    }
+    /* second-order cones, sorted by dimension */
+    for (i = 0, j = 0; i < cone->qsize; ++i) {
+        if (cone->q[i] > 1) {
+            q_order[2 * j] = cone->q[i];
+            q_order[2 * j + 1] = i;
+            j++;
+        }
+    }
+    qsort(q_order, nq, 2 * sizeof (scs_int), scs_presolve_compare_soc);
+    for (j = 0; j < nq; ++j) {
+        i = q_order[2 * j + 1];
+        kc->q[j] = cone->q[i];
+        for (row = q_start[i]; row < q_start[i + 1]; ++row) {
+            perm[r++] = row;
+        }
+    }
+    /* rotated second-order cones are kept in place */
+    for (row = rq_offset; row < s_offset; ++row) {
+        perm[r++] = row;
+    }
+    /* PSD cones */
+    for (i = 0, j = 0; i < cone->ssize; ++i) {
+        scs_int sz = (cone->s[i] * (cone->s[i] + 1)) / 2;
+        if (cone->s[i] > 1) {
+            kc->s[j++] = cone->s[i];
+            for (; sz > 0; --sz) {
+                perm[r++] = row++;
+            }
+        } else {
+            row += sz;
+        }
+    }
+    /* exponential and power cones are kept in place */
+    for (; row < presolve->m; ++row) {
+        perm[r++] = row;
+    }
+    kc->qsize = nq;
+    kc->ssize = ns;
+    kc->bsize = cone->bsize;
+    kc->rqsize = cone->rqsize;
+    kc->ep = cone->ep;
+    kc->ed = cone->ed;
+    kc->psize = cone->psize;
+    if (cone->bsize > 1) {
+        kc->bl = scs_malloc((cone->bsize - 1) * sizeof (scs_float));
+        kc->bu = scs_malloc((cone->bsize - 1) * sizeof (scs_float));
+        if (kc->bl == SCS_NULL || kc->bu == SCS_NULL) {
+            /* LCOV_EXCL_START */
+            scs_free(q_start);
+            scs_free(q_order);
+            return -1;
+            /* LCOV_EXCL_STOP */
+        }
+        memcpy(kc->bl, cone->bl, (cone->bsize - 1) * sizeof (scs_float));
+        memcpy(kc->bu, cone->bu, (cone->bsize - 1) * sizeof (scs_float));
+    }
+    if (cone->rqsize > 0) {
+        kc->rq = scs_malloc(cone->rqsize * sizeof (scs_int));
+        if (kc->rq == SCS_NULL) {
+            /* LCOV_EXCL_START */
+            scs_free(q_start);
+            scs_free(q_order);
+            return -1;
+            /* LCOV_EXCL_STOP */
+        }
+        memcpy(kc->rq, cone->rq, cone->rqsize * sizeof (scs_int));
+    }
+    if (cone->psize > 0) {
+        kc->p = scs_malloc(cone->psize * sizeof (scs_float));
+        if (kc->p == SCS_NULL) {
+            /* LCOV_EXCL_START */
+            scs_free(q_start);
+            scs_free(q_order);
+            return -1;
+            /* LCOV_EXCL_STOP */
+        }
+        memcpy(kc->p, cone->p, cone->psize * sizeof (scs_float));
+    }
+    scs_free(q_start);
+    scs_free(q_order);
+    return 0;
+}
+
+/*
+ * Permutes the rows of A; the entries are visited row by row in the new
+ * order, so the row indices of every column of the result are sorted.
+ */
+static scs_int scs_presolve_build_matrix(
+        ScsPresolve * RESTRICT presolve,
+        const ScsAMatrix * RESTRICT A) {
+    const scs_int m = presolve->m;
+    const scs_int n = presolve->n;
+    const scs_int nnz = A->p[n];
+    const scs_int * RESTRICT perm = presolve->row_perm;
+    scs_int * RESTRICT row_ptr = scs_calloc(m + 1, sizeof (scs_int));
+    scs_int * RESTRICT inv = scs_malloc(m * sizeof (scs_int));
+    scs_int * RESTRICT next = scs_malloc((MAX(m, n) + 1) * sizeof (scs_int));
+    scs_int * RESTRICT cols = scs_malloc((nnz + 1) * sizeof (scs_int));
+    scs_float * RESTRICT vals = scs_malloc((nnz + 1) * sizeof (scs_float));
+    ScsAMatrix * Ap = scs_calloc(1, sizeof (ScsAMatrix));
+    scs_int i, j, k;
+
+    if (Ap != SCS_NULL) {
+        Ap->m = m;
+        Ap->n = n;
+        Ap->p = scs_malloc((n + 1) * sizeof (scs_int));
+        Ap->i = scs_malloc((nnz + 1) * sizeof (scs_int));
+        Ap->x = scs_malloc((nnz + 1) * sizeof (scs_float));
+        presolve->data->A = Ap;
+    }
+    if (row_ptr == SCS_NULL || inv == SCS_NULL || next == SCS_NULL
+            || cols == SCS_NULL || vals == SCS_NULL || Ap == SCS_NULL
+            || Ap->p == SCS_NULL || Ap->i == SCS_NULL || Ap->x == SCS_NULL) {
+        /* LCOV_EXCL_START */
+        scs_free(row_ptr);
+        scs_free(inv);
+        scs_free(next);
+        scs_free(cols);
+        scs_free(vals);
+        return -1;
+        /* LCOV_EXCL_STOP */
+    }
+
+    for (i = 0; i < m; ++i) {
+        inv[perm[i]] = i;
+    }
+    /* permuted matrix in compressed row format */
+    for (k = 0; k < nnz; ++k) {
+        row_ptr[inv[A->i[k]] + 1]++;
+    }
+    for (i = 0; i < m; ++i) {
+        row_ptr[i + 1] += row_ptr[i];
+        next[i] = row_ptr[i];
+    }
+    for (j = 0; j < n; ++j) {
+        for (k = A->p[j]; k < A->p[j + 1]; ++k) {
+            scs_int pos = next[inv[A->i[k]]]++;
+            cols[pos] = j;
+            vals[pos] = A->x[k];
+        }
+    }
+    /* back to compressed column format */
+    memcpy(Ap->p, A->p, (n + 1) * sizeof (scs_int));
+    memcpy(next, A->p, n * sizeof (scs_int));
+    for (i = 0; i < m; ++i) {
+        for (k = row_ptr[i]; k < row_ptr[i + 1]; ++k) {
+            scs_int pos = next[cols[k]]++;
+            Ap->i[pos] = i;
+            Ap->x[pos] = vals[k];
+        }
+    }
+
+    scs_free(row_ptr);
+    scs_free(inv);
+    scs_free(next);
+    scs_free(cols);
+    scs_free(vals);
+    return 0;
+}
+
+ScsPresolve *scs_presolve_init(
+        const ScsData * RESTRICT data,
+        const ScsCone * RESTRICT cone) {
+    ScsPresolve * presolve;
+
+    if (scs_presolve_is_canonical(cone)) {
+        return SCS_NULL;
+    }
+    presolve = scs_calloc(1, sizeof (ScsPresolve));
+    if (presolve == SCS_NULL) {
+        return SCS_NULL; /* LCOV_EXCL_LINE */
+    }
+    presolve->m = data->m;
+    presolve->n = data->n;
+    presolve->row_perm = scs_malloc(data->m * sizeof (scs_int));
+    presolve->data = scs_calloc(1, sizeof (ScsData));
+    presolve->cone = scs_calloc(1, sizeof (ScsCone));
+    presolve->sol = scs_calloc(1, sizeof (ScsSolution));
+    if (presolve->row_perm == SCS_NULL || presolve->data == SCS_NULL
+            || presolve->cone == SCS_NULL || presolve->sol == SCS_NULL
+            || scs_presolve_build_cone(presolve, cone) < 0
+            || scs_presolve_build_matrix(presolve, data->A) < 0) {
+        /* LCOV_EXCL_START */
+        scs_presolve_free(presolve);
+        return SCS_NULL;
+        /* LCOV_EXCL_STOP */
+    }
+    presolve->data->m = data->m;
+    presolve->data->n = data->n;
+    presolve->data->stgs = data->stgs;
+    presolve->data->P = data->P; /* only rows are permuted */
+    presolve->data->b = scs_malloc(data->m * sizeof (scs_float));
+    presolve->data->c = scs_malloc(data->n * sizeof (scs_float));
+    presolve->sol->x = scs_calloc(data->n, sizeof (scs_float));
+    presolve->sol->y = scs_calloc(data->m, sizeof (scs_float));
+    presolve->sol->s = scs_calloc(data->m, sizeof (scs_float));
+    if (presolve->data->b == SCS_NULL || presolve->data->c == SCS_NULL
+            || presolve->sol->x == SCS_NULL || presolve->sol->y == SCS_NULL
+            || presolve->sol->s == SCS_NULL) {
+        /* LCOV_EXCL_START */
+        scs_presolve_free(presolve);
+        return SCS_NULL;
+        /* LCOV_EXCL_STOP */
+    }
+    scs_presolve_update_data(presolve, data);
+    return presolve;
+}
+
+void scs_presolve_update_data(
+        ScsPresolve * RESTRICT presolve,
+        const ScsData * RESTRICT data) {
+    scs_int i;
+    for (i = 0; i < presolve->m; ++i) {
+        presolve->data->b[i] = data->b[presolve->row_perm[i]];
+    }
+    memcpy(presolve->data->c, data->c, presolve->n * sizeof (scs_float));
+}
+
+void scs_presolve_lift_solution(
+        ScsPresolve * RESTRICT presolve,
+        const ScsSolution * RESTRICT sol) {
+    scs_int i;
+    ScsSolution * sp = presolve->sol;
+
+    if (sol->x == SCS_NULL || sol->y == SCS_NULL || sol->s == SCS_NULL) {
+        return;
+    }
+    memcpy(sp->x, sol->x, presolve->n * sizeof (scs_float));
+    for (i = 0; i < presolve->m; ++i) {
+        sp->y[i] = sol->y[presolve->row_perm[i]];
+        sp->s[i] = sol->s[presolve->row_perm[i]];
+    }
+}
+
+scs_int scs_presolve_recover_solution(
+        const ScsPresolve * RESTRICT presolve,
+        ScsSolution * RESTRICT sol) {
+    scs_int i;
+    const ScsSolution * sp = presolve->sol;
+
+    if (sol->x == SCS_NULL) sol->x = scs_malloc(presolve->n * sizeof (scs_float));
+    if (sol->y == SCS_NULL) sol->y = scs_malloc(presolve->m * sizeof (scs_float));
+    if (sol->s == SCS_NULL) sol->s = scs_malloc(presolve->m * sizeof (scs_float));
+    if (sol->x == SCS_NULL || sol->y == SCS_NULL || sol->s == SCS_NULL) {
+        return -1; /* LCOV_EXCL_LINE */
+    }
+    memcpy(sol->x, sp->x, presolve->n * sizeof (scs_float));
+    for (i = 0; i < presolve->m; ++i) {
+        sol->y[presolve->row_perm[i]] = sp->y[i];
+        sol->s[presolve->row_perm[i]] = sp->s[i];
+    }
+    return 0;
+}
+
+void scs_presolve_free(ScsPresolve * RESTRICT presolve) {
+    if (presolve == SCS_NULL) {
+        return;
+    }
+    if (presolve->data != SCS_NULL) {
+        if (presolve->data->A != SCS_NULL) {
+            scs_free(presolve->data->A->x);
+            scs_free(presolve->data->A->i);
+            scs_free(presolve->data->A->p);
+            scs_free(presolve->data->A);
+        }
+        scs_free(presolve->data->b);
+        scs_free(presolve->data->c);
+        scs_free(presolve->data);
+    }
+    if (presolve->cone != SCS_NULL) {
+        scs_free(presolve->cone->q);
+        scs_free(presolve->cone->rq);
+        scs_free(presolve->cone->s);
+        scs_free(presolve->cone->p);
+        scs_free(presolve->cone->bl);
+        scs_free(presolve->cone->bu);
+        scs_free(presolve->cone);
+    }
+    if (presolve->sol != SCS_NULL) {
+        scs_free(presolve->sol->x);
+        scs_free(presolve->sol->y);
+        scs_free(presolve->sol->s);
+        scs_free(presolve->sol);
+    }
+    scs_free(presolve->row_perm);
+    scs_free(presolve);
+}
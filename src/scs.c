@@ -28,13 +28,19 @@
 #include "scs.h"
 #include "normalize.h"
 #include "directions.h"
+#include "chordal.h"
+#include "presolve.h"
 #include "linsys/amatrix.h"
 #include <time.h>
 
+#if !(defined _WIN32 || defined _WIN64 || defined _WINDLL)
+/* the convergence monitor runs on a POSIX thread */
+#define SCS_MONITOR_THREAD
+#include <pthread.h>
+#endif
+
 /* if verbose print summary output every this num iterations */
 #define SCS_PRINT_INTERVAL 100
-/* check for convergence every this num iterations */
-#define SCS_CONVERGED_INTERVAL 1
 
 /* tolerance at which we declare problem indeterminate */
 #define SCS_INDETERMINATE_TOL 1e-9
@@ -83,12 +89,13 @@ struct scs_residuals {
      * \brief Relative duality gap defined as 
      * 
      * \f[
-     *  \text{relgap} = \frac{c'x + b'y}{1+|c'x|+|b'y|}
+     *  \text{relgap} = \frac{|x'Px + c'x + b'y|}{1+|\text{pcost}|+|\text{dcost}|}
      * \f]
      */
     scs_float rel_gap;
     scs_float cTx_by_tau; /* not divided by tau */
     scs_float bTy_by_tau; /* not divided by tau */
+    scs_float xTPx_by_tau; /* x'Px divided by tau once (0 if the cost is linear) */
     /**
      * Variable \f$\tau\f$ (\f$\bar{\tau}\f$ in SuperSCS)
      */
@@ -98,12 +105,67 @@ struct scs_residuals {
      */
     scs_float kap; /* for superSCS it's kap_b */
 };
+
+/**
+ * \brief Snapshot of the iterates of SuperSCS passed to the convergence monitor
+ */
+struct scs_snapshot {
+    scs_float *u_b; /**< \brief \f$\bar{u}\f$ (length \f$l\f$) */
+    scs_float *s_b; /**< \brief \f$\bar{s}\f$ (length \f$m\f$) */
+    scs_float kap_b; /**< \brief \f$\bar{\kappa}\f$ */
+    scs_float nrmR_con; /**< \brief norm of the FPR */
+    scs_int iter; /**< \brief iteration of the snapshot */
+    scs_int idx_progress; /**< \brief index in the progress arrays */
+};
+
+/**
+ * \brief Convergence monitor of SuperSCS (see ScsSettings#async_monitor)
+ * 
+ * The solver fills the back buffer and hands it over to the monitor, which 
+ * evaluates the residuals of the front buffer on a helper thread. All fields 
+ * below the mutex which are shared by the two threads are accessed only 
+ * while holding it.
+ */
+struct scs_monitor {
+    struct scs_snapshot snapshot[2]; /**< \brief double buffer */
+    scs_int front; /**< \brief index of the buffer read by the monitor */
+    scs_float *pr; /**< \brief primal residual workspace (length \f$m\f$) */
+    scs_float *dr; /**< \brief dual residual workspace (length \f$n\f$) */
+    scs_float *Px; /**< \brief workspace for \f$Px\f$ (length \f$n\f$) */
+    ScsWork *work; /**< \brief workspace of the solver */
+    ScsInfo *info; /**< \brief progress data are recorded here */
+    ScsTimer timer; /**< \brief copy of the timer of the solver (started with it) */
+    struct scs_residuals residuals; /**< \brief residuals of the certified snapshot */
+    scs_int running; /**< \brief whether the helper thread is running */
+    scs_int busy; /**< \brief whether the front buffer is being evaluated */
+    scs_int stop; /**< \brief request to the helper thread to stop */
+    scs_int status; /**< \brief nonzero once a snapshot is certified (termination flag) */
+#ifdef SCS_MONITOR_THREAD
+    pthread_t thread; /**< \brief helper thread */
+    pthread_mutex_t mutex; /**< \brief protects the shared fields */
+    pthread_cond_t cond; /**< \brief signals a new snapshot or a stop request */
+#endif
+};
+
+static void scs_monitor_stop(ScsWork * RESTRICT work);
+static void scs_free_monitor(ScsMonitor * RESTRICT mon);
 /* printing header */
 static const char *SCS_HEADER[] = {
     " Iter ", " pri res ", " dua res ", " rel gap ",
     " pri obj ", " dua obj ", " kap/tau ", "   FPR   ", " time (s)"
 };
 static const scs_int scs_hspace = 9;
+
+/* primal cost c'x/tau + x'Px/(2 tau^2) */
+static scs_float scs_primal_cost(const struct scs_residuals * RESTRICT r) {
+    return (r->cTx_by_tau + 0.5 * r->xTPx_by_tau) / r->tau;
+}
+
+/* dual cost -b'y/tau - x'Px/(2 tau^2) */
+static scs_float scs_dual_cost(const struct scs_residuals * RESTRICT r) {
+    return -(r->bTy_by_tau + 0.5 * r->xTPx_by_tau) / r->tau;
+}
+
 static const scs_int scs_header_length = 9;
 static const scs_int scs_header_line_length = 87;
 
@@ -111,9 +173,10 @@ static scs_int scs_isnan(scs_float x) {
     return (isnan(x)); /* `isnan` works both for `float` and `double` types */
 }
 
-static ScsDirectionCache * scs_init_direction_cache(scs_int memory, scs_int l, scs_int print_mode, ScsDirectionType dir_type) {
+static ScsDirectionCache * scs_init_direction_cache(scs_int memory, scs_int l, scs_int print_mode, ScsDirectionType dir_type, scs_int anderson_gram) {
     ScsDirectionCache * RESTRICT cache = scs_calloc(1, sizeof (*cache));
-    scs_int length_S = 0, length_U = 0, length_S_minus_U = 0, length_t = 0, length_ws = 0;
+    scs_int length_S = 0, length_U = 0, length_S_minus_U = 0, length_t = 0;
+    scs_int length_Q = 0, length_R = 0, length_G = 0, length_StU = 0, length_ws = 0;
 
 
     if (cache == SCS_NULL) {
@@ -123,7 +186,6 @@ static ScsDirectionCache * scs_init_direction_cache(scs_int memory, scs_int l, s
         /* LCOV_EXCL_STOP */
     }
 
-    cache->ls_wspace_length = 0;
     cache->current_mem = 0;
 
     switch (dir_type) {
@@ -131,56 +193,63 @@ static ScsDirectionCache * scs_init_direction_cache(scs_int memory, scs_int l, s
             /* we allocate one extra memory position because it's needed */
             length_S = (1 + memory) * l;
             length_U = (1 + memory) * l;
+            /* <s_i, u_j> for the blocked update of the direction and two
+             * vectors of coefficients (see scs_compute_dir_restarted_broyden) */
+            length_StU = memory * memory;
+            length_t = 2 * memory;
+            length_ws = l;
             break;
         case anderson_acceleration:
-            length_S = memory * l;
-            length_U = memory * l;
-            length_S_minus_U = memory * l;
             /* -----------------------------------------------------------------
-             * Although t is a vector of dimension 'memory', we allocate space
-             * of length 'l' because we first need to store the residual 'R'
-             * therein (see directions.c: scs_compute_dir_anderson).
-             * Note: we give some additional space because the BLAS documentation
-             * says that we should give **at least** this much memory.
+             * In Anderson's acceleration we keep S-Y and a thin QR
+             * factorization of Y, which is updated as columns enter and leave
+             * the buffer (see directions.c: scs_compute_dir_anderson); the
+             * vectors s_i are not stored.
              * ----------------------------------------------------------------- */
-            length_t = l;
-#ifdef SVD_ACTIVATED
-            cache->ls_wspace_length = 1000 + scs_svd_workspace_size(l, memory);
-            /* -----------------------------------------------------------------
-             * In Anderson's acceleration, we solve a least squares problem
-             * using lapack's SVD-based 'sgelss' (see svdls). This requires a
-             * workspace whose size is given by 'cache->ls_wspace_length' (above).
-             * To that we add another 'memory' memory positions to store the
-             * singular values of the LHS matrix and another 'l*memory'
-             * memory positions to make a copy of the Y-cache; this is
-             * because 'sgelss' modified the LHS (i.e., the Y-cache).
-             * ----------------------------------------------------------------- */
-            length_ws = (cache->ls_wspace_length) + memory * (1 + l);
-#else
-            cache->ls_wspace_length = 1000 + scs_qr_workspace_size(l, memory);
+            length_S_minus_U = memory * l;
+            length_Q = memory * l;
+            length_R = memory * memory;
+            length_t = memory;
+            if (anderson_gram) {
+                /* the y_i are kept to update Y'Y (and rebuild the QR
+                 * factorization when Y'Y is ill-conditioned) */
+                length_U = memory * l;
+                length_G = memory * memory;
+            }
+            break;
+        case full_broyden:
             /* -----------------------------------------------------------------
-             * In Anderson's acceleration, we solve a least squares problem
-             * using lapack's SVD-based 'sgelss' (see svdls). This requires a
-             * workspace whose size is given by 'cache->ls_wspace_length' (above).
-             * To that we add another 'l*memory'
-             * memory positions to make a copy of the Y-cache; this is
-             * because 'sgelss' modified the LHS (i.e., the Y-cache).
+             * Pairs (s_i, y_i) are kept in a circular buffer with one extra
+             * position for the incoming pair, together with S'Y and S'S
+             * (indexed by buffer positions), the middle matrix of the compact
+             * representation and five vectors of inner products (see
+             * directions.c: scs_compute_dir_full_broyden).
              * ----------------------------------------------------------------- */
-            length_ws = (cache->ls_wspace_length) + memory * l;
-#endif
+            length_S = (1 + memory) * l;
+            length_U = (1 + memory) * l;
+            length_StU = (1 + memory) * (1 + memory);
+            length_G = (1 + memory) * (1 + memory);
+            length_R = memory * memory;
+            length_t = 5 * (1 + memory);
+            length_ws = l;
             break;
         default:
             break;
     }
 
-    cache->S = scs_malloc(length_S * sizeof (scs_float));
-    cache->U = scs_malloc(length_U * sizeof (scs_float));
-    cache->S_minus_Y = scs_malloc(length_S_minus_U * sizeof (scs_float));
+    cache->S = scs_malloc(length_S * sizeof (scs_cache_float));
+    cache->U = scs_malloc(length_U * sizeof (scs_cache_float));
+    cache->S_minus_Y = scs_malloc(length_S_minus_U * sizeof (scs_cache_float));
     cache->t = scs_malloc(length_t * sizeof (scs_float));
-    cache->ls_wspace = scs_malloc(length_ws * sizeof (scs_float));
+    cache->Q = scs_malloc(length_Q * sizeof (scs_float));
+    cache->R = scs_malloc(length_R * sizeof (scs_float));
+    cache->G = scs_malloc(length_G * sizeof (scs_float));
+    cache->StU = scs_malloc(length_StU * sizeof (scs_float));
+    cache->ws = scs_malloc(length_ws * sizeof (scs_float));
 
     /* the cache must know its memory length */
     cache->mem = memory;
+    cache->mem_active = memory;
 
     /* initial active memory is 0 */
     scs_reset_direction_cache(cache);
@@ -194,10 +263,33 @@ static void scs_free_direction_cache(ScsDirectionCache * RESTRICT cache) {
     scs_free(cache->U);
     scs_free(cache->S_minus_Y);
     scs_free(cache->t);
-    scs_free(cache->ls_wspace);
+    scs_free(cache->Q);
+    scs_free(cache->R);
+    scs_free(cache->G);
+    scs_free(cache->StU);
+    scs_free(cache->ws);
     scs_free(cache);
 }
 
+static void scs_free_line_search_slots(ScsWork * RESTRICT work) {
+    scs_int i;
+    if (work->ls_points != SCS_NULL) {
+        for (i = 0; i < 4 * (work->ls_slots - 1); ++i) {
+            scs_free(work->ls_points[i]);
+        }
+        scs_free_((void *) work->ls_points);
+        work->ls_points = SCS_NULL;
+    }
+    if (work->ls_cone_work != SCS_NULL) {
+        for (i = 0; i < work->ls_slots - 1; ++i) {
+            if (work->ls_cone_work[i] != SCS_NULL) scs_finish_cone(work->ls_cone_work[i]);
+        }
+        scs_free(work->ls_cone_work);
+    }
+    scs_free(work->ls_nrmR);
+    scs_free(work->ls_warm_start);
+}
+
 static void scs_free_work(ScsWork * RESTRICT work) {
     if (work == SCS_NULL) return;
     scs_free(work->u);
@@ -210,6 +302,7 @@ static void scs_free_work(ScsWork * RESTRICT work) {
     scs_free(work->c);
     scs_free(work->pr);
     scs_free(work->dr);
+    scs_free(work->Px);
     if (work->scal != SCS_NULL) {
         scs_free(work->scal->D);
         scs_free(work->scal->E);
@@ -228,9 +321,11 @@ static void scs_free_work(ScsWork * RESTRICT work) {
         scs_free(work->wu_t);
         scs_free(work->wu_b);
         scs_free(work->Rwu);
+        scs_free_line_search_slots(work);
+        scs_monitor_stop(work);
+        scs_free_monitor(work->monitor);
         scs_free_direction_cache(work->direction_cache);
         scs_free(work->s_b);
-        scs_free(work->H);
     }
     scs_free(work);
 }
@@ -275,6 +370,9 @@ static void scs_print_init_header(
             "memory = %i\n", (int) stgs->do_super_scs, (int) stgs->direction,
             (int) stgs->memory);
     scs_special_print(print_mode, stream, "Variables n = %i, constraints m = %i\n", (int) data->n, (int) data->m);
+    if (data->P != SCS_NULL) {
+        scs_special_print(print_mode, stream, "Quadratic cost, nnz(P) = %li\n", (long) data->P->p[data->n]);
+    }
     scs_special_print(print_mode, stream, "%s", coneStr);
     scs_free(coneStr);
 #ifdef MATLAB_MEX_FILE
@@ -330,9 +428,17 @@ static scs_int scs_failure(
         const char *RESTRICT ststr,
         scs_int print_mode) {
     scs_int status = stint;
+    if (work != SCS_NULL && work->chordal != SCS_NULL) {
+        /* the solution arrays have the dimensions of the original problem */
+        m = work->chordal->m;
+        n = work->chordal->n;
+    }
+    if (work != SCS_NULL) {
+        scs_monitor_stop(work);
+        endInterruptListener(&work->interrupt);
+    }
     scs_populate_on_failure(m, n, sol, info, status, ststr);
     scs_special_print(print_mode, stderr, "Failure:%s\n", msg);
-    endInterruptListener();
     return status;
 }
 
@@ -396,6 +502,13 @@ static void scs_warm_start_vars(
         work->u[n + m] = -scs_inner_product(work->c, work->u_t, work->n)
                 - scs_inner_product(work->b, &(work->u_t[n]), work->m)
                 + work->u_t[n + m];
+        if (work->P != SCS_NULL) {
+            /* Px_t is added to the x-part and x_t'Px_t/tau_t is subtracted */
+            memset(work->Px, 0, n * sizeof (scs_float));
+            scs_accum_by_p(work->P, work->u_t, work->Px);
+            scs_add_array(work->u, work->Px, n);
+            work->u[n + m] -= scs_inner_product(work->u_t, work->Px, n) / work->u_t[n + m];
+        }
     }
     if (Ax != SCS_NULL) {
         scs_free(Ax);
@@ -430,23 +543,36 @@ static scs_float scs_calc_primal_resid(
 
 static scs_float scs_calc_dual_resid(
         ScsWork * RESTRICT work,
+        const scs_float * RESTRICT x,
         const scs_float * RESTRICT y,
         const scs_float tau,
-        scs_float * RESTRICT nmATy) {
+        scs_float * RESTRICT nmATy,
+        scs_float * RESTRICT nmPx) {
     scs_int i;
-    scs_float dres = 0, scale, *dr = work->dr;
+    scs_float dres = 0, scale, tmp, *dr = work->dr, *Px = work->Px;
     *nmATy = 0;
+    *nmPx = 0;
     memset(dr, 0, work->n * sizeof (scs_float));
     scs_accum_by_a_trans(work->A, work->p, y, dr); /* dr = A'y */
+    if (work->P != SCS_NULL) {
+        memset(Px, 0, work->n * sizeof (scs_float));
+        scs_accum_by_p(work->P, x, Px); /* Px = P x */
+    }
     for (i = 0; i < work->n; ++i) {
         scale =
                 work->stgs->normalize ? (work->scal->E[i] / (work->sc_c * work->stgs->scale)) : 1;
         scale = scale * scale;
         *nmATy += (dr[i] * dr[i]) * scale;
-        dres += (dr[i] + work->c[i] * tau) * (dr[i] + work->c[i] * tau) * scale;
+        tmp = dr[i] + work->c[i] * tau;
+        if (work->P != SCS_NULL) {
+            *nmPx += (Px[i] * Px[i]) * scale;
+            tmp += Px[i];
+        }
+        dres += tmp * tmp * scale;
     }
     *nmATy = SQRTF(*nmATy);
-    return SQRTF(dres); /* norm(A'y + c * tau), for superSCS: norm(A'y_b + c * tau_b)*/
+    *nmPx = SQRTF(*nmPx);
+    return SQRTF(dres); /* norm(Px + A'y + c * tau) */
 }
 
 /* calculates un-normalized quantities */
@@ -461,7 +587,8 @@ static void scs_calc_residuals(
     scs_float nmdr_tau;
     scs_float nmAxs_tau;
     scs_float nmATy_tau;
-    scs_float cTx, bTy;
+    scs_float nmPx_tau;
+    scs_float pcost, dcost;
     scs_int n = work->n, m = work->m;
 
     /* checks if the residuals are unchanged by checking iteration */
@@ -479,7 +606,7 @@ static void scs_calc_residuals(
             (work->stgs->normalize ? (work->stgs->scale * work->sc_c * work->sc_b) : 1);
 
     nmpr_tau = scs_calc_primal_resid(work, x, s, res->tau, &nmAxs_tau);
-    nmdr_tau = scs_calc_dual_resid(work, y, res->tau, &nmATy_tau);
+    nmdr_tau = scs_calc_dual_resid(work, x, y, res->tau, &nmATy_tau, &nmPx_tau);
 
     res->bTy_by_tau =
             scs_inner_product(y, work->b, m) /
@@ -487,59 +614,71 @@ static void scs_calc_residuals(
     res->cTx_by_tau =
             scs_inner_product(x, work->c, n) /
             (work->stgs->normalize ? (work->stgs->scale * work->sc_c * work->sc_b) : 1);
+    res->xTPx_by_tau = work->P == SCS_NULL ? 0.0
+            : scs_inner_product(x, work->Px, n) / res->tau /
+            (work->stgs->normalize ? (work->stgs->scale * work->sc_c * work->sc_b) : 1);
 
     res->res_infeas =
             res->bTy_by_tau < 0 ? work->nm_b * nmATy_tau / -res->bTy_by_tau : NAN;
     res->res_unbdd =
-            res->cTx_by_tau < 0 ? work->nm_c * nmAxs_tau / -res->cTx_by_tau : NAN;
+            res->cTx_by_tau < 0 ? work->nm_c * MAX(nmAxs_tau, nmPx_tau) / -res->cTx_by_tau : NAN;
 
-    bTy = res->bTy_by_tau / res->tau;
-    cTx = res->cTx_by_tau / res->tau;
+    pcost = scs_primal_cost(res);
+    dcost = scs_dual_cost(res);
 
     res->res_pri = nmpr_tau / (1 + work->nm_b) / res->tau;
     res->res_dual = nmdr_tau / (1 + work->nm_c) / res->tau;
-    res->rel_gap = ABS(cTx + bTy) / (1 + ABS(cTx) + ABS(bTy));
+    res->rel_gap = ABS(pcost - dcost) / (1 + ABS(pcost) + ABS(dcost));
 }
 
-static void scs_calc_residuals_superscs(
-        ScsWork * RESTRICT work,
-        struct scs_residuals * RESTRICT residuals,
-        scs_int iter) {
-    scs_float * RESTRICT xb;
-    scs_float * RESTRICT yb;
-    scs_float * RESTRICT sb;
-    scs_float cTx;
-    scs_float bTy;
-    scs_float * RESTRICT pr = work->pr;
-    scs_float * RESTRICT dr = work->dr;
+/*
+ * Computes the residuals at (u_b, s_b, kap_b) using pr, dr and Px as 
+ * workspace. The products with A use the linear-system workspace p or, 
+ * if p is SCS_NULL, the host matrix A only (so that they can be computed 
+ * by the convergence monitor while the solver is running).
+ */
+static void scs_compute_residuals_superscs(
+        const ScsWork * RESTRICT work,
+        const scs_float * RESTRICT u_b,
+        const scs_float * RESTRICT sb,
+        scs_float kap_b,
+        scs_float * RESTRICT pr,
+        scs_float * RESTRICT dr,
+        scs_float * RESTRICT Px,
+        ScsPrivWorkspace * p,
+        struct scs_residuals * RESTRICT residuals) {
+    const scs_float * RESTRICT xb;
+    const scs_float * RESTRICT yb;
+    scs_float pcost;
+    scs_float dcost;
     scs_int n = work->n;
     scs_int m = work->m;
     scs_int i;
     scs_float norm_D_A_x_plus_s; /* norm of D*(Ax+s), intermediate variable */
     scs_float norm_E_Atran_yb; /* norm of E*A'*y,   intermediate variable */
+    scs_float norm_E_P_xb = 0; /* norm of E*P*x,  intermediate variable */
     scs_float tmp__c_times_x; /* c'x */
     scs_float tmp__b_times_yb; /* b'y */
     const scs_float temp1 = work->sc_b * work->stgs->scale; /* auxiliary variable #1 */
     const scs_float temp2 = work->sc_c * temp1; /* auxiliary variable #2 */
     const scs_float temp3 = work->sc_c * work->stgs->scale; /* auxiliary variable #3 */
 
+    xb = u_b;
+    yb = &(u_b[n]);
 
-    /* checks if the residuals are unchanged by checking iteration */
-    if (residuals->last_iter == iter) {
-        return;
-    }
-    residuals->last_iter = iter;
-
-    sb = work->s_b;
-    xb = work->u_b;
-    yb = &(work->u_b[n]);
-
-    residuals->kap = work->kap_b;
-    residuals->tau = work->u_b[n + m]; /* it's actually tau_b */
+    residuals->kap = kap_b;
+    residuals->tau = u_b[n + m]; /* it's actually tau_b */
     memset(pr, 0, work->m * sizeof (scs_float)); /* pr = 0 */
     memset(dr, 0, work->n * sizeof (scs_float)); /* dr = 0 */
 
-    scs_accum_by_a(work->A, work->p, xb, pr); /* pr = A xb */
+#ifdef _OPENMP
+    if (p != SCS_NULL) {
+        scs_accum_by_a(work->A, p, xb, pr); /* pr = A xb */
+        scs_accum_by_a_trans(work->A, p, yb, dr); /* dr = A' yb */
+    } else
+#endif
+        /* pr = A xb, dr = A' yb (one pass over A) */
+        scs_accum_by_a_and_a_trans(work->A, xb, yb, pr, dr);
     scs_add_scaled_array(pr, sb, work->m, 1.0); /* pr = A xb + sb */
     /* --- compute ||D(Ax + s)|| --- */
     norm_D_A_x_plus_s = 0;
@@ -554,9 +693,6 @@ static void scs_calc_residuals_superscs(
     norm_D_A_x_plus_s = SQRTF(norm_D_A_x_plus_s);
     scs_add_scaled_array(pr, work->b, m, -residuals->tau); /* pr = A xb + sb - b taub */
 
-    scs_accum_by_a_trans(work->A, work->p, yb, dr); /* dr = A' yb */
-
-
     /* --- compute ||E A' yb|| --- */
     norm_E_Atran_yb = 0.0;
     if (work->stgs->normalize) {
@@ -570,6 +706,26 @@ static void scs_calc_residuals_superscs(
     norm_E_Atran_yb = SQRTF(norm_E_Atran_yb);
     scs_add_scaled_array(dr, work->c, work->n, residuals->tau); /* dr = A' yb + c taub */
 
+    if (work->P != SCS_NULL) {
+        memset(Px, 0, n * sizeof (scs_float));
+        scs_accum_by_p(work->P, xb, Px); /* Px = P xb */
+        if (work->stgs->normalize) {
+            for (i = 0; i < n; ++i) {
+                scs_float tmp = work->scal->E[i] * Px[i];
+                norm_E_P_xb += tmp * tmp;
+            }
+            /* in the units of D(Ax + s) */
+            norm_E_P_xb = SQRTF(norm_E_P_xb) * work->sc_b / work->sc_c;
+        } else {
+            norm_E_P_xb = scs_norm(Px, n);
+        }
+        scs_add_array(dr, Px, n); /* dr = P xb + A' yb + c taub */
+        residuals->xTPx_by_tau = scs_inner_product(xb, Px, n) / residuals->tau
+                / (work->stgs->normalize ? (temp2) : 1);
+    } else {
+        residuals->xTPx_by_tau = 0.0;
+    }
+
     /*
      * bTy_by_tau = b'yb / (scale*sc_c*sc_b)
      * cTx_by_tau = c'xb / (scale*sc_c*sc_b)
@@ -580,11 +736,11 @@ static void scs_calc_residuals_superscs(
     residuals->cTx_by_tau = tmp__c_times_x / (work->stgs->normalize ? (temp2) : 1);
 
     /*
-     * bTy = b'yb / (scale*sc_c*sc_b) / taub
-     * cTx = c'xb / (scale*sc_c*sc_b) / taub
+     * pcost = c'x/tau + x'Px/(2 tau^2)
+     * dcost = -b'y/tau - x'Px/(2 tau^2)
      */
-    bTy = residuals->bTy_by_tau / residuals->tau;
-    cTx = residuals->cTx_by_tau / residuals->tau;
+    pcost = scs_primal_cost(residuals);
+    dcost = scs_dual_cost(residuals);
 
     /* PRIMAL RESIDUAL */
     if (work->stgs->normalize) {
@@ -616,16 +772,7 @@ static void scs_calc_residuals_superscs(
 
     /* UNBOUNDEDNESS */
     if (tmp__c_times_x < 0) {
-        scs_float norm_Ec = 0;
-        if (work->stgs->normalize) {
-            for (i = 0; i < n; ++i) {
-                scs_float tmp = work->scal->E[i] * work->c[i];
-                norm_Ec += (tmp * tmp);
-            }
-        } else {
-            norm_Ec += scs_norm_squared(work->c, n);
-        }
-        residuals->res_unbdd = -SQRTF(norm_Ec) * norm_D_A_x_plus_s / tmp__c_times_x;
+        residuals->res_unbdd = -work->nm_Ec * MAX(norm_D_A_x_plus_s, norm_E_P_xb) / tmp__c_times_x;
         residuals->res_unbdd /= (work->stgs->normalize ? work->stgs->scale : 1);
     } else {
         residuals->res_unbdd = NAN; /* not unbounded */
@@ -634,21 +781,25 @@ static void scs_calc_residuals_superscs(
 
     /* INFEASIBILITY */
     if (tmp__b_times_yb < 0) {
-        scs_float norm_Db_squared = 0;
-        if (work->stgs->normalize) {
-            for (i = 0; i < m; ++i) {
-                scs_float tmp = work->scal->D[i] * work->b[i];
-                norm_Db_squared += (tmp * tmp);
-            }
-        } else {
-            norm_Db_squared += scs_norm_squared(work->b, m);
-        }
-        residuals->res_infeas = -SQRTF(norm_Db_squared) * norm_E_Atran_yb / tmp__b_times_yb;
+        residuals->res_infeas = -work->nm_Db * norm_E_Atran_yb / tmp__b_times_yb;
         residuals->res_infeas /= (work->stgs->normalize ? work->stgs->scale : 1);
     } else {
         residuals->res_infeas = NAN; /* not infeasible */
     }
-    residuals->rel_gap = ABS(cTx + bTy) / (1 + ABS(cTx) + ABS(bTy));
+    residuals->rel_gap = ABS(pcost - dcost) / (1 + ABS(pcost) + ABS(dcost));
+}
+
+static void scs_calc_residuals_superscs(
+        ScsWork * RESTRICT work,
+        struct scs_residuals * RESTRICT residuals,
+        scs_int iter) {
+    /* checks if the residuals are unchanged by checking iteration */
+    if (residuals->last_iter == iter) {
+        return;
+    }
+    residuals->last_iter = iter;
+    scs_compute_residuals_superscs(work, work->u_b, work->s_b, work->kap_b,
+            work->pr, work->dr, work->Px, work->p, residuals);
 }
 
 static void scs_cold_start_vars(ScsWork * RESTRICT work) {
@@ -661,6 +812,72 @@ static void scs_cold_start_vars(ScsWork * RESTRICT work) {
     }
 }
 
+/*
+ * With a quadratic cost, the projection on the linear system maps w to the
+ * solution of
+ *
+ *   (rho_x + P) x + A'y + c tau        = rho_x w_x
+ *   -A x + y + b tau                   = w_y
+ *   -c'x - b'y + tau - x'Px / tau      = w_tau
+ *
+ * (x, y) is affine in tau: (x, y) = p - tau g, where p solves the linear system
+ * with right-hand side (rho_x w_x, -w_y) and g solves it for (c, -b), so tau is
+ * the nonnegative root of a quadratic equation.
+ *
+ * Unlike the linear case, this map is not linear in w; only p is. Given p in
+ * the (x, y)-part of u_t, this function computes tau and sets (x, y) = p - tau g.
+ */
+static void scs_quadratic_tau_step(
+        scs_float * RESTRICT u_t,
+        scs_float w_tau,
+        ScsWork * RESTRICT work) {
+    const scs_int n = work->n, l = work->l;
+    scs_float a, b, c, discr, tau;
+
+    memset(work->Px, 0, n * sizeof (scs_float));
+    scs_accum_by_p(work->P, u_t, work->Px);
+    a = 1 + work->gTh - work->gTPg; /* = 1 + rho_x |g_x|^2 + |g_y|^2 */
+    b = 2 * scs_inner_product(work->g, work->Px, n)
+            - scs_inner_product(work->h, u_t, l - 1) - w_tau;
+    c = -scs_inner_product(u_t, work->Px, n);
+    discr = SQRTF(MAX(b * b - 4 * a * c, 0));
+    tau = b > 0 ? -2 * c / (b + discr) : (discr - b) / (2 * a);
+
+    scs_add_scaled_array(u_t, work->g, l - 1, -tau);
+    u_t[l - 1] = tau;
+}
+
+/* status < 0 indicates failure */
+static scs_int scs_project_lin_sys_quadratic(
+        scs_float * RESTRICT u_t,
+        const scs_float * RESTRICT warm,
+        ScsWork * RESTRICT work,
+        scs_int iter) {
+    const scs_int n = work->n, m = work->m;
+    const scs_float w_tau = u_t[work->l - 1];
+    scs_int status;
+
+    scs_scale_array(u_t, work->stgs->rho_x, n);
+    scs_scale_array(u_t + n, -1, m);
+    status = scs_solve_lin_sys(work->A, work->stgs, work->p, u_t, warm, iter);
+    scs_quadratic_tau_step(u_t, w_tau, work);
+    return status;
+}
+
+/*
+ * Line search point w = u + step * dir: with a quadratic cost, wu_t cannot be
+ * obtained by combining u_t and dut; their p-parts (x, y) + tau g are combined
+ * instead and tau is computed anew, which needs no linear system solve.
+ */
+static void scs_quadratic_line_search_point(
+        scs_float * RESTRICT wu_t,
+        scs_float w_tau,
+        ScsWork * RESTRICT work) {
+    const scs_int l = work->l;
+    scs_add_scaled_array(wu_t, work->g, l - 1, wu_t[l - 1]);
+    scs_quadratic_tau_step(wu_t, w_tau, work);
+}
+
 /* status < 0 indicates failure */
 static scs_int scs_project_lin_sys(
         ScsWork * RESTRICT work,
@@ -670,6 +887,10 @@ static scs_int scs_project_lin_sys(
     memcpy(work->u_t, work->u, l * sizeof (scs_float));
     scs_add_scaled_array(work->u_t, work->v, l, 1.0);
 
+    if (work->P != SCS_NULL) {
+        return scs_project_lin_sys_quadratic(work->u_t, work->u, work, iter);
+    }
+
     scs_scale_array(work->u_t, work->stgs->rho_x, n);
 
     scs_add_scaled_array(work->u_t, work->h, l - 1, -work->u_t[l - 1]);
@@ -693,6 +914,11 @@ static scs_int superscs_project_lin_sys(
     scs_int status;
     const scs_int l = work->l;
 
+    if (work->P != SCS_NULL) {
+        memcpy(u_t, u, l * sizeof (scs_float));
+        return scs_project_lin_sys_quadratic(u_t, u, work, iter);
+    }
+
     /* x_t = rho_x * x_t */
     memcpy(u_t + work->n, u + work->n, (work->m + 1) * sizeof (scs_float));
     scs_set_as_scaled_array(u_t, u, work->stgs->rho_x, work->n);
@@ -747,15 +973,6 @@ static void scs_update_dual_vars(ScsWork * RESTRICT work) {
     scs_add_scaled_array(work->v, work->u_prev, l, -1.0 + work->stgs->alpha);
 }
 
-/* Calculates the fixed point residual R */
-static void scs_calc_FPR(
-        scs_float * RESTRICT fpr,
-        scs_float * RESTRICT u_t,
-        scs_float * RESTRICT u_b,
-        scs_int l) {
-    scs_axpy(fpr, u_t, u_b, 1.0, -1.0, l);
-}
-
 /* status < 0 indicates failure */
 static scs_int scs_project_cones(
         ScsWork * RESTRICT work,
@@ -771,7 +988,8 @@ static scs_int scs_project_cones(
                 (1 - work->stgs->alpha) * work->u_prev[i] - work->v[i];
     }
     /* u = [x;y;tau] */
-    status = scs_project_dual_cone(&(work->u[n]), cone, work->coneWork, &(work->u_prev[n]), iter);
+    status = scs_project_dual_cone(&(work->u[n]), cone, work->coneWork, &(work->u_prev[n]),
+            work->stgs->inexact_cone_projections ? iter : -1);
     if (work->u[l - 1] < 0.0)
         work->u[l - 1] = 0.0;
 
@@ -784,6 +1002,7 @@ static scs_int superscs_project_cones(
         scs_float * RESTRICT u_t,
         scs_float * RESTRICT u,
         ScsWork * RESTRICT work,
+        ScsConeWork * RESTRICT cone_work,
         const ScsCone * RESTRICT cone,
         scs_int iter) {
     scs_int n = work->n;
@@ -793,7 +1012,8 @@ static scs_int superscs_project_cones(
     scs_axpy(u_b, u_t, u, 2.0, -1.0, l);
 
     /* u = [x;y;tau] */
-    status = scs_project_dual_cone(&(u_b[n]), cone, work->coneWork, &(work->u_prev[n]), iter);
+    status = scs_project_dual_cone(&(u_b[n]), cone, cone_work, &(work->u_prev[n]),
+            work->stgs->inexact_cone_projections ? iter : -1);
     if (u_b[l - 1] < 0.0) {
         u_b[l - 1] = 0.0;
     }
@@ -919,8 +1139,8 @@ static void scs_get_info(
         info->relGap = residuals->rel_gap;
         info->resPri = residuals->res_pri;
         info->resDual = residuals->res_dual;
-        info->pobj = residuals->cTx_by_tau / residuals->tau;
-        info->dobj = -residuals->bTy_by_tau / residuals->tau;
+        info->pobj = scs_primal_cost(residuals);
+        info->dobj = scs_dual_cost(residuals);
     } else if (scs_is_unbounded_status(info->statusVal)) {
         info->relGap = NAN;
         info->resPri = NAN;
@@ -936,6 +1156,18 @@ static void scs_get_info(
     }
 }
 
+/* 
+ * solution of the problem which is actually solved, that is, after the 
+ * presolve and the chordal decomposition 
+ */
+static ScsSolution * scs_work_solution(
+        ScsWork * RESTRICT work,
+        ScsSolution * RESTRICT sol) {
+    if (work->chordal != SCS_NULL) return work->chordal->sol;
+    if (work->presolve != SCS_NULL) return work->presolve->sol;
+    return sol;
+}
+
 /* sets solutions, re-scales by inner prods if infeasible or unbounded */
 static void scs_get_solution(
         ScsWork * RESTRICT work,
@@ -944,6 +1176,10 @@ static void scs_get_solution(
         struct scs_residuals * RESTRICT r,
         scs_int iter) {
     scs_int l = work->l;
+    /* with a presolve or a chordal decomposition, the solution of the 
+     * transformed problem is computed first and then mapped back to the 
+     * original problem */
+    ScsSolution * work_sol = scs_work_solution(work, sol);
     if (work->stgs->do_super_scs == 0) {
         scs_calc_residuals(work, r, iter);
     } else {
@@ -951,30 +1187,45 @@ static void scs_get_solution(
         r->kap = ABS(work->kap_b) /
                 (work->stgs->normalize ? (work->stgs->scale * work->sc_c * work->sc_b) : 1.0);
     }
-    scs_set_x(work, sol);
-    scs_set_y(work, sol);
-    scs_set_s(work, sol);
+    scs_set_x(work, work_sol);
+    scs_set_y(work, work_sol);
+    scs_set_s(work, work_sol);
     if (info->statusVal == SCS_UNFINISHED) {
         /* not yet converged, take best guess */
         if (r->tau > SCS_INDETERMINATE_TOL && r->tau > r->kap) {
-            info->statusVal = scs_solved(work, sol, info, r->tau);
+            info->statusVal = scs_solved(work, work_sol, info, r->tau);
         } else if (scs_norm(work->u, l) <
                 SCS_INDETERMINATE_TOL * SQRTF((scs_float) l)) {
-            info->statusVal = scs_indeterminate(work, sol, info);
+            info->statusVal = scs_indeterminate(work, work_sol, info);
         } else if (r->bTy_by_tau < r->cTx_by_tau) {
-            info->statusVal = scs_infeasible(work, sol, info, r->bTy_by_tau);
+            info->statusVal = scs_infeasible(work, work_sol, info, r->bTy_by_tau);
         } else {
-            info->statusVal = scs_unbounded(work, sol, info, r->cTx_by_tau);
+            info->statusVal = scs_unbounded(work, work_sol, info, r->cTx_by_tau);
         }
     } else if (scs_is_solved_status(info->statusVal)) {
-        info->statusVal = scs_solved(work, sol, info, r->tau);
+        info->statusVal = scs_solved(work, work_sol, info, r->tau);
     } else if (scs_is_infeasible_status(info->statusVal)) {
-        info->statusVal = scs_infeasible(work, sol, info, r->bTy_by_tau);
+        info->statusVal = scs_infeasible(work, work_sol, info, r->bTy_by_tau);
     } else {
-        info->statusVal = scs_unbounded(work, sol, info, r->cTx_by_tau);
+        info->statusVal = scs_unbounded(work, work_sol, info, r->cTx_by_tau);
     }
     if (work->stgs->normalize) {
-        scs_unnormalize_sol(work, sol);
+        scs_unnormalize_sol(work, work_sol);
+    }
+    if (work->chordal != SCS_NULL
+            && scs_chordal_recover_solution(work->chordal,
+            work->presolve != SCS_NULL ? work->presolve->sol : sol) < 0) {
+        /* LCOV_EXCL_START */
+        scs_special_print(work->stgs->do_override_streams, stderr,
+                "ERROR: recovering the solution of the decomposed problem failed\n");
+        /* LCOV_EXCL_STOP */
+    }
+    if (work->presolve != SCS_NULL
+            && scs_presolve_recover_solution(work->presolve, sol) < 0) {
+        /* LCOV_EXCL_START */
+        scs_special_print(work->stgs->do_override_streams, stderr,
+                "ERROR: recovering the solution of the presolved problem failed\n");
+        /* LCOV_EXCL_STOP */
     }
     scs_get_info(work, sol, info, r, iter);
 }
@@ -991,8 +1242,8 @@ static void scs_print_summary(
     scs_special_print(print_mode, stream, "%*.2e ", (int) scs_hspace, residuals->res_pri);
     scs_special_print(print_mode, stream, "%*.2e ", (int) scs_hspace, residuals->res_dual);
     scs_special_print(print_mode, stream, "%*.2e ", (int) scs_hspace, residuals->rel_gap);
-    scs_special_print(print_mode, stream, "%*.2e ", (int) scs_hspace, residuals->cTx_by_tau / residuals->tau);
-    scs_special_print(print_mode, stream, "%*.2e ", (int) scs_hspace, -residuals->bTy_by_tau / residuals->tau);
+    scs_special_print(print_mode, stream, "%*.2e ", (int) scs_hspace, scs_primal_cost(residuals));
+    scs_special_print(print_mode, stream, "%*.2e ", (int) scs_hspace, scs_dual_cost(residuals));
     scs_special_print(print_mode, stream, "%*.2e ", (int) scs_hspace, residuals->kap / residuals->tau);
     if (work->stgs->do_super_scs) {
         scs_special_print(print_mode, stream, "%*.2e ", (int) scs_hspace, work->nrmR_con);
@@ -1182,6 +1433,48 @@ static scs_int scs_has_converged(
     return 0;
 }
 
+static void scs_reset_convergence_checks(ScsWork * RESTRICT work) {
+    work->next_check = 0;
+    work->last_check = -1;
+    work->last_check_ratio = NAN;
+}
+
+/*
+ * Schedules the next convergence check after the one at iteration `iter`. 
+ * The distance from convergence is the smallest ratio of the termination 
+ * criteria of scs_has_converged to eps. Assuming it decreases linearly (in 
+ * log scale) at the rate observed between the last two checks, the next 
+ * check takes place after half the predicted number of iterations to reach 
+ * eps, but no later than max_check_interval iterations.
+ */
+static void scs_schedule_convergence_check(
+        ScsWork * RESTRICT work,
+        const struct scs_residuals * RESTRICT residuals,
+        scs_int iter) {
+    const scs_int max_interval = work->stgs->max_check_interval;
+    scs_float ratio = MAX(MAX(residuals->res_pri, residuals->res_dual), residuals->rel_gap);
+    scs_float rate, predicted;
+    scs_int interval = max_interval;
+
+    if (residuals->res_unbdd < ratio) ratio = residuals->res_unbdd;
+    if (residuals->res_infeas < ratio) ratio = residuals->res_infeas;
+    ratio /= work->stgs->eps;
+
+    if (max_interval > 1) {
+        if (work->last_check < 0) {
+            interval = 1; /* estimate the rate first */
+        } else if (ratio > 1 && work->last_check_ratio > ratio) {
+            /* decrease of log(ratio) per iteration */
+            rate = log(work->last_check_ratio / ratio) / (iter - work->last_check);
+            predicted = 0.5 * log(ratio) / rate;
+            if (predicted < max_interval) interval = MAX(1, (scs_int) predicted);
+        }
+    }
+    work->last_check = iter;
+    work->last_check_ratio = ratio;
+    work->next_check = iter + interval;
+}
+
 static scs_int scs_validate_superscs_settings(const ScsData *data) {
     ScsSettings * stgs = data->stgs;
     scs_int print_mode = stgs->do_override_streams;
@@ -1196,7 +1489,8 @@ static scs_int scs_validate_superscs_settings(const ScsData *data) {
         /* LCOV_EXCL_STOP */
     }
     if ((stgs->direction == restarted_broyden
-            || stgs->direction == anderson_acceleration)
+            || stgs->direction == anderson_acceleration
+            || stgs->direction == full_broyden)
             && stgs->memory <= 1) {
         /* LCOV_EXCL_START */
         scs_special_print(print_mode, stderr, "Quasi-Newton memory length "
@@ -1223,6 +1517,13 @@ static scs_int scs_validate_superscs_settings(const ScsData *data) {
         return SCS_FAILED;
         /* LCOV_EXCL_STOP */
     }
+    if (stgs->ls_parallel < 1) {
+        /* LCOV_EXCL_START */
+        scs_special_print(print_mode, stderr, "Illegal number of parallel line search trials (ls_parallel=%ld).\n",
+                (long) stgs->ls_parallel);
+        return SCS_FAILED;
+        /* LCOV_EXCL_STOP */
+    }
     if (stgs->ls >= 40) {
         /* LCOV_EXCL_START */
         scs_special_print(print_mode, stderr, "WARNING! The value ls=%ld is too high. The maximum allowed "
@@ -1300,6 +1601,13 @@ static scs_int scs_validate_general_settings(const ScsData *data) {
         return SCS_FAILED;
         /* LCOV_EXCL_STOP */
     }
+    if (stgs->max_check_interval < 1) {
+        /* LCOV_EXCL_START */
+        scs_special_print(print_mode, stderr, "max_check_interval must be positive (max_check_interval=%ld)\n",
+                (long) stgs->max_check_interval);
+        return SCS_FAILED;
+        /* LCOV_EXCL_STOP */
+    }
     if (stgs->eps <= 0) {
         /* LCOV_EXCL_START */
         scs_special_print(print_mode, stderr, "eps tolerance must be positive (eps=%g)\n", stgs->eps);
@@ -1324,6 +1632,24 @@ static scs_int scs_validate_general_settings(const ScsData *data) {
         return SCS_FAILED;
         /* LCOV_EXCL_STOP */
     }
+    if (stgs->chordal_decomposition != 0 && stgs->chordal_decomposition != 1) {
+        /* LCOV_EXCL_START */
+        scs_special_print(print_mode, stderr, "chordal_decomposition (=%d) can be either 0 or 1.\n", (int) stgs->chordal_decomposition);
+        return SCS_FAILED;
+        /* LCOV_EXCL_STOP */
+    }
+    if (stgs->presolve_cones != 0 && stgs->presolve_cones != 1) {
+        /* LCOV_EXCL_START */
+        scs_special_print(print_mode, stderr, "presolve_cones (=%d) can be either 0 or 1.\n", (int) stgs->presolve_cones);
+        return SCS_FAILED;
+        /* LCOV_EXCL_STOP */
+    }
+    if (stgs->inexact_cone_projections != 0 && stgs->inexact_cone_projections != 1) {
+        /* LCOV_EXCL_START */
+        scs_special_print(print_mode, stderr, "inexact_cone_projections (=%d) can be either 0 or 1.\n", (int) stgs->inexact_cone_projections);
+        return SCS_FAILED;
+        /* LCOV_EXCL_STOP */
+    }
     if (stgs->do_super_scs != 0 && stgs->do_super_scs != 1) {
         /* LCOV_EXCL_START */
         scs_special_print(print_mode, stderr, "do_super_scs (=%d) can be either 0 or 1.\n", (int) stgs->do_super_scs);
@@ -1357,6 +1683,12 @@ static scs_int scs_validate(
         return SCS_FAILED;
         /* LCOV_EXCL_STOP */
     }
+    if (data->P != SCS_NULL && scs_validate_quadratic_cost(data->P, data->n) < 0) {
+        /* LCOV_EXCL_START */
+        scs_special_print(print_mode, stderr, "invalid quadratic cost\n");
+        return SCS_FAILED;
+        /* LCOV_EXCL_STOP */
+    }
     if (scs_validate_cones(data, cone) < 0) {
         /* LCOV_EXCL_START */
         scs_special_print(print_mode, stderr, "cone validation error\n");
@@ -1371,6 +1703,36 @@ static scs_int scs_validate(
     return 0;
 }
 
+/*
+ * Allocates the ScsWork#ls_slots - 1 additional trial points of the 
+ * line search (the first one is stored in wu, wu_t, wu_b and Rwu) 
+ * together with a cone workspace for each of them, and the buffer for the 
+ * warm-start state of the cone projections.
+ */
+static scs_int scs_init_line_search_slots(
+        ScsWork * RESTRICT work,
+        const ScsCone * RESTRICT cone,
+        scs_int l) {
+    scs_int i;
+    work->ls_slots = MAX(1, MIN(work->stgs->ls_parallel, work->stgs->ls));
+    work->ls_nrmR = scs_malloc(work->ls_slots * sizeof (scs_float));
+    work->ls_warm_start = scs_malloc(scs_cone_warm_start_size(cone) * sizeof (scs_float));
+    if (work->ls_nrmR == SCS_NULL || work->ls_warm_start == SCS_NULL) return -1; /* LCOV_EXCL_LINE */
+    if (work->ls_slots == 1) return 0;
+    work->ls_points = scs_calloc(4 * (work->ls_slots - 1), sizeof (scs_float *));
+    work->ls_cone_work = scs_calloc(work->ls_slots - 1, sizeof (ScsConeWork *));
+    if (work->ls_points == SCS_NULL || work->ls_cone_work == SCS_NULL) return -1; /* LCOV_EXCL_LINE */
+    for (i = 0; i < 4 * (work->ls_slots - 1); ++i) {
+        work->ls_points[i] = scs_malloc(l * sizeof (scs_float));
+        if (work->ls_points[i] == SCS_NULL) return -1; /* LCOV_EXCL_LINE */
+    }
+    for (i = 0; i < work->ls_slots - 1; ++i) {
+        work->ls_cone_work[i] = scs_init_conework(cone);
+        if (work->ls_cone_work[i] == SCS_NULL) return -1; /* LCOV_EXCL_LINE */
+    }
+    return 0;
+}
+
 static ScsWork * scs_init_work(
         const ScsData * RESTRICT data,
         const ScsCone * RESTRICT cone) {
@@ -1528,9 +1890,11 @@ static ScsWork * scs_init_work(
          * of an (S,U)-cache.
          * ------------------------------------- */
         if ((work->stgs->direction == restarted_broyden
-                || work->stgs->direction == anderson_acceleration)
+                || work->stgs->direction == anderson_acceleration
+                || work->stgs->direction == full_broyden)
                 && work->stgs->memory > 0) {
-            work->direction_cache = scs_init_direction_cache(work->stgs->memory, l, print_mode, work->stgs->direction);
+            work->direction_cache = scs_init_direction_cache(work->stgs->memory, l, print_mode,
+                    work->stgs->direction, work->stgs->anderson_gram);
             if (work->direction_cache == SCS_NULL) {
                 /* LCOV_EXCL_START */
                 scs_special_print(print_mode, stderr,
@@ -1542,27 +1906,6 @@ static ScsWork * scs_init_work(
             work->direction_cache = SCS_NULL;
         }
 
-        /* -------------------------------------
-         * Allocate memory for the full Broyden
-         * method
-         * ------------------------------------- */
-        if (work->stgs->direction == full_broyden) {
-            scs_int i;
-            work->H = scs_malloc(l * l * sizeof (scs_float));
-            if (work->H == SCS_NULL) {
-                /* LCOV_EXCL_START */
-                scs_special_print(print_mode, stderr, "ERROR: `H` memory allocation failure\n");
-                return SCS_NULL;
-                /* LCOV_EXCL_STOP */
-            }
-            /* H = I */
-            for (i = 0; i < l; ++i) {
-                work->H[i * (l + 1)] = 1.0;
-            }
-        } else {
-            work->H = SCS_NULL;
-        }
-
         work->Sk = scs_malloc(l * sizeof (scs_float));
         if (work->Sk == SCS_NULL) {
             /* LCOV_EXCL_START */
@@ -1607,6 +1950,12 @@ static ScsWork * scs_init_work(
                 return SCS_NULL;
                 /* LCOV_EXCL_STOP */
             }
+            if (scs_init_line_search_slots(work, cone, l) < 0) {
+                /* LCOV_EXCL_START */
+                scs_special_print(print_mode, stderr, "ERROR: line search memory allocation failure\n");
+                return SCS_NULL;
+                /* LCOV_EXCL_STOP */
+            }
         }
     } else {
         /* -------------------------------------
@@ -1643,13 +1992,34 @@ static ScsWork * scs_init_work(
     } else {
         work->scal = SCS_NULL;
     }
+    work->P = data->P;
+    if (work->P != SCS_NULL) {
+        if (work->stgs->normalize) {
+#ifdef COPYAMATRIX
+            if (scs_copy_a_matrix(&(work->P), data->P) == 0) {
+                /* LCOV_EXCL_START */
+                scs_special_print(print_mode, stderr, "ERROR: copy P matrix failed\n");
+                return SCS_NULL;
+                /* LCOV_EXCL_STOP */
+            }
+#endif
+            scs_normalize_quadratic_cost(work, data);
+        }
+        work->Px = scs_malloc(data->n * sizeof (scs_float));
+        if (work->Px == SCS_NULL) {
+            /* LCOV_EXCL_START */
+            scs_special_print(print_mode, stderr, "ERROR: `Px` memory allocation failure\n");
+            return SCS_NULL;
+            /* LCOV_EXCL_STOP */
+        }
+    }
     if ((work->coneWork = scs_init_conework(cone)) == SCS_NULL) {
         /* LCOV_EXCL_START */
         scs_special_print(print_mode, stderr, "ERROR: initCone failure\n");
         return SCS_NULL;
         /* LCOV_EXCL_STOP */
     }
-    work->p = scs_init_priv(work->A, work->stgs);
+    work->p = scs_init_priv(work->A, work->P, work->stgs);
     if (work->p == SCS_NULL) {
         /* LCOV_EXCL_START */
         scs_special_print(print_mode, stderr, "ERROR: scs_init_priv failure\n");
@@ -1673,9 +2043,34 @@ static scs_int scs_update_work(
     memcpy(work->c, data->c, data->n * sizeof (scs_float));
 
     if (work->stgs->normalize) {
+        scs_int i;
         scs_normalize_bc(work);
+        /* ||Db|| and ||Ec|| do not change within a solve (see scs_calc_residuals_superscs) */
+        work->nm_Db = 0;
+        for (i = 0; i < m; ++i) {
+            scs_float tmp = work->scal->D[i] * work->b[i];
+            work->nm_Db += tmp * tmp;
+        }
+        work->nm_Db = SQRTF(work->nm_Db);
+        work->nm_Ec = 0;
+        for (i = 0; i < n; ++i) {
+            scs_float tmp = work->scal->E[i] * work->c[i];
+            work->nm_Ec += tmp * tmp;
+        }
+        work->nm_Ec = SQRTF(work->nm_Ec);
+    } else {
+        work->nm_Db = scs_norm(work->b, m);
+        work->nm_Ec = scs_norm(work->c, n);
     }
     if (work->stgs->warm_start) {
+        if (work->presolve != SCS_NULL) {
+            scs_presolve_lift_solution(work->presolve, sol);
+            sol = work->presolve->sol;
+        }
+        if (work->chordal != SCS_NULL) {
+            scs_chordal_lift_solution(work->chordal, sol);
+            sol = work->chordal->sol;
+        }
         scs_warm_start_vars(work, sol);
     } else {
         scs_cold_start_vars(work);
@@ -1683,8 +2078,17 @@ static scs_int scs_update_work(
     memcpy(work->h, work->c, n * sizeof (scs_float));
     memcpy(&(work->h[n]), work->b, m * sizeof (scs_float));
     memcpy(work->g, work->h, (n + m) * sizeof (scs_float));
-    scs_solve_lin_sys(work->A, work->stgs, work->p, work->g, SCS_NULL, -1);
-    scs_scale_array(&(work->g[n]), -1, m);
+    if (work->P == SCS_NULL) {
+        scs_solve_lin_sys(work->A, work->stgs, work->p, work->g, SCS_NULL, -1);
+        scs_scale_array(&(work->g[n]), -1, m);
+    } else {
+        /* g solves the linear system for (c, -b), see scs_project_lin_sys_quadratic */
+        scs_scale_array(&(work->g[n]), -1, m);
+        scs_solve_lin_sys(work->A, work->stgs, work->p, work->g, SCS_NULL, -1);
+        memset(work->Px, 0, n * sizeof (scs_float));
+        scs_accum_by_p(work->P, work->g, work->Px);
+        work->gTPg = scs_inner_product(work->g, work->Px, n);
+    }
     work->gTh = scs_inner_product(work->h, work->g, n + m);
     return 0;
 }
@@ -1763,6 +2167,10 @@ static scs_int scs_init_progress_data(
             info->progress_ls = scs_malloc(sizeof (scs_int) * max_history_alloc);
             if (info->progress_ls == SCS_NULL) return -10;
         }
+        if (info->progress_mem == SCS_NULL) {
+            info->progress_mem = scs_malloc(sizeof (scs_int) * max_history_alloc);
+            if (info->progress_mem == SCS_NULL) return -11;
+        }
 
         /* ---------------------------------------------------------
          * If `do_record_progress` is true, and there has
@@ -1811,6 +2219,9 @@ static scs_int scs_init_progress_data(
 
             info->progress_ls = realloc(info->progress_ls, sizeof (scs_int) * max_history_alloc);
             if (info->progress_ls == SCS_NULL) return -109;
+
+            info->progress_mem = realloc(info->progress_mem, sizeof (scs_int) * max_history_alloc);
+            if (info->progress_mem == SCS_NULL) return -110;
         }
     }
     return 0;
@@ -1819,20 +2230,221 @@ static scs_int scs_init_progress_data(
 static void scs_record_progress_data(
         ScsInfo * info,
         struct scs_residuals * res,
-        const ScsWork * work,
+        scs_float norm_fpr,
         ScsTimer * solveTimer,
+        scs_int idx_progress,
         scs_int iter) {
-    scs_int idx_progress = iter / SCS_CONVERGED_INTERVAL;
     info->progress_iter[idx_progress] = iter;
     info->progress_relgap[idx_progress] = res->rel_gap;
     info->progress_respri[idx_progress] = res->res_pri;
     info->progress_resdual[idx_progress] = res->res_dual;
-    info->progress_pcost[idx_progress] = res->cTx_by_tau / res->tau;
-    info->progress_dcost[idx_progress] = -res->bTy_by_tau / res->tau;
-    info->progress_norm_fpr[idx_progress] = work->nrmR_con;
+    info->progress_pcost[idx_progress] = scs_primal_cost(res);
+    info->progress_dcost[idx_progress] = scs_dual_cost(res);
+    info->progress_norm_fpr[idx_progress] = norm_fpr;
     info->progress_time[idx_progress] = scs_toc_quiet(solveTimer);
 }
 
+/* evaluates the snapshot in the front buffer (on the helper thread) */
+static void scs_monitor_evaluate(ScsMonitor * RESTRICT mon) {
+    ScsWork *work = mon->work;
+    const struct scs_snapshot *snap = &(mon->snapshot[mon->front]);
+    struct scs_residuals r;
+    scs_int status;
+
+    r.last_iter = snap->iter;
+    scs_compute_residuals_superscs(work, snap->u_b, snap->s_b, snap->kap_b,
+            mon->pr, mon->dr, mon->Px, SCS_NULL, &r);
+    if (work->stgs->do_record_progress) {
+        scs_record_progress_data(mon->info, &r, snap->nrmR_con, &(mon->timer), snap->idx_progress, snap->iter);
+    }
+    status = scs_has_converged(work, &r, snap->iter);
+#ifdef SCS_MONITOR_THREAD
+    if (mon->running) pthread_mutex_lock(&(mon->mutex));
+#endif
+    if (status != 0) {
+        mon->status = status;
+        mon->residuals = r;
+    } else {
+        scs_schedule_convergence_check(work, &r, snap->iter);
+    }
+    mon->busy = 0;
+#ifdef SCS_MONITOR_THREAD
+    if (mon->running) pthread_mutex_unlock(&(mon->mutex));
+#endif
+}
+
+#ifdef SCS_MONITOR_THREAD
+
+static void * scs_monitor_run(void * arg) {
+    ScsMonitor *mon = (ScsMonitor *) arg;
+    pthread_mutex_lock(&(mon->mutex));
+    for (;;) {
+        while (!mon->busy && !mon->stop) {
+            pthread_cond_wait(&(mon->cond), &(mon->mutex));
+        }
+        if (!mon->busy) break; /* stop requested and nothing to evaluate */
+        pthread_mutex_unlock(&(mon->mutex));
+        scs_monitor_evaluate(mon);
+        pthread_mutex_lock(&(mon->mutex));
+    }
+    pthread_mutex_unlock(&(mon->mutex));
+    return SCS_NULL;
+}
+#endif
+
+static void scs_free_monitor(ScsMonitor * RESTRICT mon) {
+    if (mon == SCS_NULL) return;
+    scs_free(mon->snapshot[0].u_b);
+    scs_free(mon->snapshot[0].s_b);
+    scs_free(mon->snapshot[1].u_b);
+    scs_free(mon->snapshot[1].s_b);
+    scs_free(mon->pr);
+    scs_free(mon->dr);
+    scs_free(mon->Px);
+    scs_free(mon);
+}
+
+/*
+ * Starts the convergence monitor (allocated on first use). If no helper 
+ * thread can be started, the snapshots are evaluated synchronously.
+ */
+static scs_int scs_monitor_start(
+        ScsWork * RESTRICT work,
+        ScsInfo * RESTRICT info,
+        ScsTimer * RESTRICT timer) {
+    ScsMonitor *mon = work->monitor;
+    scs_int i;
+    if (mon == SCS_NULL) {
+        mon = scs_calloc(1, sizeof (*mon));
+        if (mon == SCS_NULL) return -1; /* LCOV_EXCL_LINE */
+        work->monitor = mon;
+        for (i = 0; i < 2; ++i) {
+            mon->snapshot[i].u_b = scs_malloc(work->l * sizeof (scs_float));
+            mon->snapshot[i].s_b = scs_malloc(work->m * sizeof (scs_float));
+            if (mon->snapshot[i].u_b == SCS_NULL || mon->snapshot[i].s_b == SCS_NULL) return -1; /* LCOV_EXCL_LINE */
+        }
+        mon->pr = scs_malloc(work->m * sizeof (scs_float));
+        mon->dr = scs_malloc(work->n * sizeof (scs_float));
+        mon->Px = scs_malloc(work->n * sizeof (scs_float));
+        if (mon->pr == SCS_NULL || mon->dr == SCS_NULL || mon->Px == SCS_NULL) return -1; /* LCOV_EXCL_LINE */
+    }
+    mon->work = work;
+    mon->info = info;
+    mon->timer = *timer;
+    mon->front = 0;
+    mon->busy = 0;
+    mon->stop = 0;
+    mon->status = 0;
+    mon->running = 0;
+#ifdef SCS_MONITOR_THREAD
+    if (pthread_mutex_init(&(mon->mutex), SCS_NULL) != 0) return 0; /* LCOV_EXCL_LINE */
+    if (pthread_cond_init(&(mon->cond), SCS_NULL) != 0) {
+        /* LCOV_EXCL_START */
+        pthread_mutex_destroy(&(mon->mutex));
+        return 0;
+        /* LCOV_EXCL_STOP */
+    }
+    if (pthread_create(&(mon->thread), SCS_NULL, scs_monitor_run, mon) != 0) {
+        /* LCOV_EXCL_START */
+        pthread_cond_destroy(&(mon->cond));
+        pthread_mutex_destroy(&(mon->mutex));
+        return 0;
+        /* LCOV_EXCL_STOP */
+    }
+    mon->running = 1;
+#endif
+    return 0;
+}
+
+/*
+ * Returns the status certified by the monitor (0 if none) and whether a new
+ * snapshot may be published at iteration `iter` (the monitor is idle and 
+ * the next convergence check is due).
+ */
+static scs_int scs_monitor_poll(
+        ScsWork * RESTRICT work,
+        scs_int iter,
+        scs_int * RESTRICT publish) {
+    ScsMonitor *mon = work->monitor;
+    scs_int status;
+#ifdef SCS_MONITOR_THREAD
+    if (mon->running) pthread_mutex_lock(&(mon->mutex));
+#endif
+    status = mon->status;
+    *publish = status == 0 && !mon->busy && iter >= work->next_check;
+#ifdef SCS_MONITOR_THREAD
+    if (mon->running) pthread_mutex_unlock(&(mon->mutex));
+#endif
+    return status;
+}
+
+/* copies the current iterate into the back buffer and hands it over */
+static void scs_monitor_publish(
+        ScsWork * RESTRICT work,
+        scs_int iter,
+        scs_int idx_progress) {
+    ScsMonitor *mon = work->monitor;
+    struct scs_snapshot *snap = &(mon->snapshot[1 - mon->front]);
+    memcpy(snap->u_b, work->u_b, work->l * sizeof (scs_float));
+    memcpy(snap->s_b, work->s_b, work->m * sizeof (scs_float));
+    snap->kap_b = work->kap_b;
+    snap->nrmR_con = work->nrmR_con;
+    snap->iter = iter;
+    snap->idx_progress = idx_progress;
+#ifdef SCS_MONITOR_THREAD
+    if (mon->running) {
+        pthread_mutex_lock(&(mon->mutex));
+        mon->front = 1 - mon->front;
+        mon->busy = 1;
+        pthread_cond_signal(&(mon->cond));
+        pthread_mutex_unlock(&(mon->mutex));
+        return;
+    }
+#endif
+    mon->front = 1 - mon->front;
+    mon->busy = 1;
+    scs_monitor_evaluate(mon);
+}
+
+/* waits for the evaluation in progress (if any) and stops the helper thread */
+static void scs_monitor_stop(ScsWork * RESTRICT work) {
+    ScsMonitor *mon = work->monitor;
+    if (mon == SCS_NULL || !mon->running) return;
+#ifdef SCS_MONITOR_THREAD
+    pthread_mutex_lock(&(mon->mutex));
+    mon->stop = 1;
+    pthread_cond_signal(&(mon->cond));
+    pthread_mutex_unlock(&(mon->mutex));
+    pthread_join(mon->thread, SCS_NULL);
+    pthread_cond_destroy(&(mon->cond));
+    pthread_mutex_destroy(&(mon->mutex));
+#endif
+    mon->running = 0;
+}
+
+/*
+ * If the (stopped) monitor has certified a snapshot, restores it into the 
+ * workspace together with its residuals, iteration and progress index and 
+ * returns its status; otherwise returns 0.
+ */
+static scs_int scs_monitor_certified(
+        ScsWork * RESTRICT work,
+        struct scs_residuals * RESTRICT r,
+        scs_int * RESTRICT iter,
+        scs_int * RESTRICT idx_progress) {
+    ScsMonitor *mon = work->monitor;
+    const struct scs_snapshot *snap = &(mon->snapshot[mon->front]);
+    if (mon->status == 0) return 0;
+    memcpy(work->u_b, snap->u_b, work->l * sizeof (scs_float));
+    memcpy(work->s_b, snap->s_b, work->m * sizeof (scs_float));
+    work->kap_b = snap->kap_b;
+    work->nrmR_con = snap->nrmR_con;
+    *r = mon->residuals;
+    *iter = snap->iter;
+    *idx_progress = snap->idx_progress;
+    return mon->status;
+}
+
 scs_int scs_solve(
         ScsWork * RESTRICT work,
         const ScsData * RESTRICT data,
@@ -1840,10 +2452,11 @@ scs_int scs_solve(
         ScsSolution * RESTRICT sol,
         ScsInfo * RESTRICT info) {
     scs_int i;
+    scs_int idx_progress = 0; /* number of recorded convergence checks */
     ScsTimer solveTimer;
     struct scs_residuals r;
     scs_int print_mode = work->stgs->do_override_streams;
-    const scs_float max_runtime_millis = work->stgs->max_time_milliseconds;
+    ScsDeadline deadline;
 
     if ((i = scs_init_progress_data(info, work)) < 0) {
         /* LCOV_EXCL_START */
@@ -1856,17 +2469,36 @@ scs_int scs_solve(
         scs_special_print(print_mode, stderr, "ERROR: SCS_NULL input\n");
         return SCS_FAILED;
     }
-    /* initialize ctrl-c support */
-    startInterruptListener();
+    if (work->presolve != SCS_NULL) {
+        /* solve the presolved problem (see scs_get_solution) */
+        scs_presolve_update_data(work->presolve, data);
+        data = work->presolve->data;
+        cone = work->presolve->cone;
+    }
+    if (work->chordal != SCS_NULL) {
+        /* solve the decomposed problem (see scs_get_solution) */
+        if (scs_chordal_update_data(work->chordal, data) < 0) {
+            return scs_failure(work, work->m, work->n, sol, info, SCS_FAILED,
+                    "b is nonzero outside the pattern of the chordal decomposition",
+                    "Failure", print_mode);
+        }
+        data = work->chordal->data;
+        cone = work->chordal->cone;
+    }
+    /* initialize ctrl-c support (if requested) */
+    startInterruptListener(&work->interrupt, work->stgs->handle_interrupts);
     scs_tic(&solveTimer);
+    scs_reset_cone_stats(work->coneWork);
     info->statusVal = SCS_UNFINISHED; /* not yet converged */
     r.last_iter = -1;
     scs_update_work(data, work, sol);
+    scs_reset_convergence_checks(work);
 
     if (work->stgs->verbose)
         scs_print_header(work, cone);
     /* scs: */
-    for (i = 0; i < work->stgs->max_iters && scs_toc_quiet(&solveTimer) < max_runtime_millis; ++i) {
+    scs_deadline_start(&deadline, &solveTimer, work->stgs->max_time_milliseconds);
+    for (i = 0; i < work->stgs->max_iters && !scs_deadline_passed(&deadline); ++i) {
         memcpy(work->u_prev, work->u, work->l * sizeof (scs_float));
 
         if (scs_project_lin_sys(work, i) < 0) {
@@ -1880,14 +2512,16 @@ scs_int scs_solve(
 
         scs_update_dual_vars(work);
 
-        if (isInterrupted()) {
+        if (isInterrupted(&work->interrupt)) {
             return scs_failure(work, work->m, work->n, sol, info, SCS_SIGINT, "Interrupted",
                     "Interrupted", print_mode);
         }
-        if (i % SCS_CONVERGED_INTERVAL == 0) {
+        if (i == work->next_check) {
             scs_calc_residuals(work, &r, i);
-            if (work->stgs->do_record_progress) scs_record_progress_data(info, &r, work, &solveTimer, i);
+            if (work->stgs->do_record_progress) scs_record_progress_data(info, &r, work->nrmR_con, &solveTimer, idx_progress, i);
             if ((info->statusVal = scs_has_converged(work, &r, i)) != 0) break;
+            scs_schedule_convergence_check(work, &r, i);
+            idx_progress++;
         }
 
         if (work->stgs->verbose && i % SCS_PRINT_INTERVAL == 0) {
@@ -1902,15 +2536,26 @@ scs_int scs_solve(
     /* populate solution vectors (unnormalized) and info */
     scs_get_solution(work, sol, info, &r, i);
     info->solveTime = scs_toc_quiet(&solveTimer);
+    scs_set_cone_stats(work->coneWork, info);
 
     if (work->stgs->verbose)
-        scs_print_footer(data, cone, sol, work, info); /* LCOV_EXCL_LINE */
-    endInterruptListener();
-    info->history_length = i / SCS_CONVERGED_INTERVAL;
+        scs_print_footer(data, cone,
+                scs_work_solution(work, sol), work, info); /* LCOV_EXCL_LINE */
+    endInterruptListener(&work->interrupt);
+    info->history_length = idx_progress;
 
     return info->statusVal;
 }
 
+/* swaps two vectors of the workspace (of equal length) by pointer */
+static void scs_swap_arrays(
+        scs_float * RESTRICT * a,
+        scs_float * RESTRICT * b) {
+    scs_float * RESTRICT tmp = *a;
+    *a = *b;
+    *b = tmp;
+}
+
 static void scs_compute_sb_kapb(
         ScsWork * RESTRICT work) {
     scs_axpy(work->s_b, work->u_b + work->n, work->u_t + work->n, 1.0, -2.0, work->m);
@@ -1924,10 +2569,10 @@ static void scs_step_k1(
         scs_float * r_safe,
         scs_float q_to_power_iter_times_nrm_R_init,
         scs_int * how) {
-    memcpy(work->u, work->wu, work->l * sizeof (scs_float)); /* u   = wu   */
-    memcpy(work->u_t, work->wu_t, work->l * sizeof (scs_float)); /* u_t = wu_t */
-    memcpy(work->u_b, work->wu_b, work->l * sizeof (scs_float)); /* u_b = wu_b */
-    memcpy(work->R, work->Rwu, work->l * sizeof (scs_float)); /* R   = Rw   */
+    scs_swap_arrays(&work->u, &work->wu); /* u   = wu   */
+    scs_swap_arrays(&work->u_t, &work->wu_t); /* u_t = wu_t */
+    scs_swap_arrays(&work->u_b, &work->wu_b); /* u_b = wu_b */
+    scs_swap_arrays(&work->R, &work->Rwu); /* R   = Rw   */
     scs_compute_sb_kapb(work);
     work->nrmR_con = nrmRw_con_current;
     *r_safe = work->nrmR_con + q_to_power_iter_times_nrm_R_init;
@@ -1949,27 +2594,111 @@ static scs_int scs_step_k2(
     if (slack >= rhs) {
         scs_float stepsize2;
         stepsize2 = (work->stgs->alpha * (slack / (nrmRw_con * nrmRw_con)));
-        scs_add_scaled_array(work->u, work->Rwu, work->l, -stepsize2);
+        scs_axpy(work->u, work->u_prev, work->Rwu, 1.0, -stepsize2, work->l);
         *how = 2;
         do_break_loop = 1;
     }
     return do_break_loop;
 }
 
+/*
+ * Vector k (0: wu, 1: wu_t, 2: wu_b, 3: Rwu) of the trial point in slot s 
+ * of the line search.
+ */
+static scs_float * scs_ls_vector(
+        ScsWork * RESTRICT work,
+        scs_int s,
+        scs_int k) {
+    if (s > 0) return work->ls_points[4 * (s - 1) + k];
+    switch (k) {
+        case 0: return work->wu;
+        case 1: return work->wu_t;
+        case 2: return work->wu_b;
+        default: return work->Rwu;
+    }
+}
+
+/*
+ * Makes the trial point in slot s the current trial point 
+ * (wu, wu_t, wu_b and Rwu) by swapping pointers; the warm-start state of its
+ * cone projections is copied into work->coneWork.
+ */
+static void scs_ls_select(
+        ScsWork * RESTRICT work,
+        const ScsCone * RESTRICT cone,
+        scs_int s) {
+    if (s == 0) return;
+    scs_copy_cone_warm_start(work->coneWork, work->ls_cone_work[s - 1], cone);
+    scs_swap_arrays(&work->wu, &work->ls_points[4 * (s - 1)]);
+    scs_swap_arrays(&work->wu_t, &work->ls_points[4 * (s - 1) + 1]);
+    scs_swap_arrays(&work->wu_b, &work->ls_points[4 * (s - 1) + 2]);
+    scs_swap_arrays(&work->Rwu, &work->ls_points[4 * (s - 1) + 3]);
+}
+
+/*
+ * Evaluates the trial points u_prev + t*dir for the step sizes 
+ * t = stepsize * beta^s, s = 0, ..., count - 1, and the norms of their 
+ * fixed-point residuals. The trial points are formed sequentially (they share 
+ * work->Px), whereas the cone projections, which carry the main computational 
+ * burden, are carried out in parallel, each slot with its own cone workspace.
+ * All projections are warm-started from the state of work->coneWork at the
+ * beginning of the line search (work->ls_warm_start), so the iterates depend 
+ * neither on ScsSettings#ls_parallel nor on the number of threads.
+ */
+static scs_int superscs_line_search_trials(
+        ScsWork * RESTRICT work,
+        const ScsCone * RESTRICT cone,
+        const scs_float * RESTRICT dir,
+        const scs_float * RESTRICT dut,
+        scs_float stepsize,
+        scs_int count,
+        scs_int iter) {
+    const scs_int l = work->l;
+    const scs_int n = work->n;
+    const scs_float rhox = work->stgs->rho_x;
+    scs_int s;
+    scs_int failed = 0;
+
+    for (s = 0; s < count; ++s) {
+        scs_float *wu = scs_ls_vector(work, s, 0);
+        scs_float *wu_t = scs_ls_vector(work, s, 1);
+        ScsConeWork *cone_work = s == 0 ? work->coneWork : work->ls_cone_work[s - 1];
+        scs_set_cone_warm_start(cone_work, cone, work->ls_warm_start);
+        /* wu = u + step * dir, wut = u_t + step * dut */
+        scs_axpy2(wu, work->u_prev, dir, wu_t, work->u_t, dut, stepsize, l);
+        if (work->P != SCS_NULL) scs_quadratic_line_search_point(wu_t, wu[l - 1], work);
+        stepsize *= work->stgs->beta;
+    }
+#ifdef _OPENMP
+#pragma omp parallel for reduction(+:failed) if (count > 1)
+#endif
+    for (s = 0; s < count; ++s) {
+        scs_float *wu_b = scs_ls_vector(work, s, 2);
+        scs_float *wu_t = scs_ls_vector(work, s, 1);
+        ScsConeWork *cone_work = s == 0 ? work->coneWork : work->ls_cone_work[s - 1];
+        if (superscs_project_cones(wu_b, wu_t, scs_ls_vector(work, s, 0), work, cone_work, cone, iter) < 0) {
+            failed++;
+        } else {
+            /* calculate FPR on scaled vectors and its norm */
+            work->ls_nrmR[s] = SQRTF(scs_difference_weighted_norm_squared(
+                    scs_ls_vector(work, s, 3), wu_t, wu_b, rhox, n, l));
+        }
+    }
+    return failed > 0 ? -1 : 0;
+}
+
 static void scs_update_caches(
         ScsWork * RESTRICT work,
         scs_float sqrt_rhox,
         scs_int how) {
-    if (how == 0 || work->stgs->ls == 0) {
-        scs_axpy(work->Sk, work->u, work->u_prev, 1.0, -1.0, work->l); /* Sk = u - u_prev */
-        scs_axpy(work->Yk, work->R, work->R_prev, sqrt_rhox, -1.0, work->n); /* Yk = sqrt_rhox * R - R_prev */
-        scs_axpy(work->Yk + work->n, work->R + work->n, work->R_prev + work->n, 1.0, -1.0, work->m + 1);
-        scs_scale_array(work->Sk, sqrt_rhox, work->n); /* Sk *= sqrt_rhox */
+    /* Sk = u - u_prev and Yk = R - R_prev (x-parts scaled by sqrt_rhox) in
+     * one pass; after a K1 step, (wu, Rwu) have been swapped into (u, R) */
+    if (how == 0 || how == 1 || work->stgs->ls == 0) {
+        scs_scaled_difference2(work->Sk, work->u, work->u_prev,
+                work->Yk, work->R, work->R_prev, sqrt_rhox, work->n, work->l);
     } else {
-        scs_axpy(work->Sk, work->wu, work->u_prev, sqrt_rhox, -sqrt_rhox, work->n);
-        scs_axpy(work->Sk + work->n, work->wu + work->n, work->u_prev + work->n, 1.0, -1.0, work->m + 1);
-        scs_axpy(work->Yk, work->Rwu, work->R_prev, sqrt_rhox, -1.0, work->n);
-        scs_axpy(work->Yk + work->n, work->Rwu + work->n, work->R_prev + work->n, 1.0, -1.0, work->m + 1);
+        scs_scaled_difference2(work->Sk, work->wu, work->u_prev,
+                work->Yk, work->Rwu, work->R_prev, sqrt_rhox, work->n, work->l);
     }
 }
 
@@ -1985,16 +2714,14 @@ static scs_int scs_exit_loop_without_k1(
                 "error in projectLinSysv2", "Failure", print_mode);
     }
     /* u_bar = proj_C(2u_t - u) */
-    if (superscs_project_cones(work->u_b, work->u_t, work->u, work, cone, i) < 0) {
+    if (superscs_project_cones(work->u_b, work->u_t, work->u, work, work->coneWork, cone, i) < 0) {
         return scs_failure(work, work->m, work->n, sol, info, SCS_FAILED,
                 "error in projectConesv2", "Failure", print_mode);
     }
     scs_compute_sb_kapb(work);
-    scs_calc_FPR(work->R, work->u_t, work->u_b, work->l);
-    work->nrmR_con = SQRTF(
-            work->stgs->rho_x * scs_norm_squared(work->R, work->n)
-            + scs_norm_squared(work->R + work->n, work->m + 1)
-            );
+    /* R = u_t - u_b and its norm in one pass */
+    work->nrmR_con = SQRTF(scs_difference_weighted_norm_squared(work->R,
+            work->u_t, work->u_b, work->stgs->rho_x, work->n, work->l));
     return 0;
 }
 
@@ -2006,6 +2733,8 @@ scs_int superscs_solve(
         ScsInfo * RESTRICT info) {
     scs_int i; /* i indexes the (outer) iterations */
     scs_int how = 0; /* -1:unsuccessful backtracking, 0:K0, 1:K1, 2:K2 */
+    scs_int s; /* s indexes the slots of the line search */
+    scs_int idx_progress = 0; /* number of recorded convergence checks */
     scs_float eta;
     scs_float nrm_R_0;
     scs_float r_safe;
@@ -2019,6 +2748,7 @@ scs_int superscs_solve(
     const scs_int m = work->m;
     const scs_int l = work->l;
     ScsTimer solveTimer;
+    ScsDeadline deadline;
     struct scs_residuals r;
     scs_int print_mode = work->stgs->do_override_streams;
     /* ------------------------------------
@@ -2028,16 +2758,6 @@ scs_int superscs_solve(
     ScsSettings * RESTRICT settings = work->stgs;
     scs_float alpha = settings->alpha;
     scs_float * RESTRICT dir = work->dir;
-    scs_float * RESTRICT R = work->R;
-    scs_float * RESTRICT R_prev = work->R_prev;
-    scs_float * RESTRICT Rwu = work->Rwu;
-    scs_float * RESTRICT u = work->u;
-    scs_float * RESTRICT u_t = work->u_t;
-    scs_float * RESTRICT u_b = work->u_b;
-    scs_float * RESTRICT u_prev = work->u_prev;
-    scs_float * RESTRICT wu = work->wu;
-    scs_float * RESTRICT wu_t = work->wu_t;
-    scs_float * RESTRICT wu_b = work->wu_b;
     scs_float * RESTRICT dut = work->dut;
 
     if ((i = scs_init_progress_data(info, work)) < 0) {
@@ -2052,30 +2772,59 @@ scs_int superscs_solve(
         scs_special_print(print_mode, stderr, "ERROR: SCS_NULL input\n");
         return SCS_FAILED;
     }
+    if (work->presolve != SCS_NULL) {
+        /* solve the presolved problem (see scs_get_solution) */
+        scs_presolve_update_data(work->presolve, data);
+        data = work->presolve->data;
+        cone = work->presolve->cone;
+    }
+    if (work->chordal != SCS_NULL) {
+        /* solve the decomposed problem (see scs_get_solution) */
+        if (scs_chordal_update_data(work->chordal, data) < 0) {
+            return scs_failure(work, m, n, sol, info, SCS_FAILED,
+                    "b is nonzero outside the pattern of the chordal decomposition",
+                    "Failure", print_mode);
+        }
+        data = work->chordal->data;
+        cone = work->chordal->cone;
+    }
 
-    /* initialize ctrl-c support */
-    startInterruptListener();
+    /* initialize ctrl-c support (if requested) */
+    startInterruptListener(&work->interrupt, work->stgs->handle_interrupts);
     scs_tic(&solveTimer);
+    scs_reset_cone_stats(work->coneWork);
+    for (s = 0; s < work->ls_slots - 1; ++s) {
+        scs_reset_cone_stats(work->ls_cone_work[s]);
+    }
+    if (work->direction_cache != SCS_NULL) {
+        scs_reset_adaptive_memory(work->direction_cache, settings->adaptive_memory);
+    }
     info->statusVal = SCS_UNFINISHED; /* not yet converged */
     r.last_iter = -1;
     scs_update_work(data, work, sol);
+    scs_reset_convergence_checks(work);
+    if (settings->async_monitor && scs_monitor_start(work, info, &solveTimer) < 0) {
+        /* LCOV_EXCL_START */
+        return scs_failure(work, m, n, sol, info, SCS_FAILED,
+                "memory allocation error (convergence monitor)", "Failure", print_mode);
+        /* LCOV_EXCL_STOP */
+    }
 
     if (settings->verbose > 0) scs_print_header(work, cone);
 
     /* Initialize: */
     i = 0; /* Needed for the next two functions */
-    if (superscs_project_lin_sys(u_t, u, work, i) < 0) { /* u_t = (I+Q)^{-1} u*/
+    if (superscs_project_lin_sys(work->u_t, work->u, work, i) < 0) { /* u_t = (I+Q)^{-1} u*/
         return scs_failure(work, m, n, sol, info, SCS_FAILED,
                 "error in projectLinSysv2", "Failure", print_mode);
     }
-    if (superscs_project_cones(u_b, u_t, u, work, cone, i) < 0) { /* u_bar = proj_C(2u_t - u) */
+    if (superscs_project_cones(work->u_b, work->u_t, work->u, work, work->coneWork, cone, i) < 0) { /* u_bar = proj_C(2u_t - u) */
         return scs_failure(work, m, n, sol, info, SCS_FAILED,
                 "error in projectConesv2", "Failure", print_mode);
     }
     scs_compute_sb_kapb(work); /* compute s_b and kappa_b */
-    scs_calc_FPR(R, u_t, u_b, l); /* compute Ru */
-    /* initialize eta = |Ru^0| (norm of R using rho_x)... */
-    eta = SQRTF(rhox * scs_norm_squared(R, n) + scs_norm_squared(R + n, m + 1));
+    /* compute Ru and initialize eta = |Ru^0| (norm of R using rho_x)... */
+    eta = SQRTF(scs_difference_weighted_norm_squared(work->R, work->u_t, work->u_b, rhox, n, l));
     r_safe = eta;
     work->nrmR_con = eta;
     nrm_R_0 = MIN(1.0, eta);
@@ -2086,20 +2835,31 @@ scs_int superscs_solve(
      * MAIN SUPER SCS LOOP 
      * 
      * ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ */
+    scs_deadline_start(&deadline, &solveTimer, settings->max_time_milliseconds);
     for (i = 0; i < settings->max_iters
-            && scs_toc_quiet(&solveTimer) < work->stgs->max_time_milliseconds; ++i) {
+            && !scs_deadline_passed(&deadline); ++i) {
         scs_int j_iter_ls = 0; /* j indexes the line search iterations */
+        scs_int checked = 0; /* whether the residuals were checked at this iteration */
 
-        if (isInterrupted()) {
+        if (isInterrupted(&work->interrupt)) {
             return scs_failure(work, m, n, sol, info, SCS_SIGINT, "Interrupted",
                     "Interrupted", print_mode);
         }
 
         /* Convergence checks */
-        if (i % SCS_CONVERGED_INTERVAL == 0) {
+        if (settings->async_monitor) {
+            scs_int publish;
+            if ((info->statusVal = scs_monitor_poll(work, i, &publish)) != 0) break;
+            if (publish) {
+                scs_monitor_publish(work, i, idx_progress);
+                checked = 1;
+            }
+        } else if (i == work->next_check) {
             scs_calc_residuals_superscs(work, &r, i);
-            if (settings->do_record_progress) scs_record_progress_data(info, &r, work, &solveTimer, i);
+            if (settings->do_record_progress) scs_record_progress_data(info, &r, work->nrmR_con, &solveTimer, idx_progress, i);
             if ((info->statusVal = scs_has_converged(work, &r, i)) != 0) break;
+            scs_schedule_convergence_check(work, &r, i);
+            checked = 1;
         }
 
         /* Prints results every PRINT_INTERVAL iterations */
@@ -2115,12 +2875,12 @@ scs_int superscs_solve(
                  * At i=0, the direction is defined using the
                  * FPR: dir^0 = -R
                  * -------------------------------------------- */
-                scs_set_as_scaled_array(dir, R, -sqrt_rhox, n);
-                scs_set_as_scaled_array(dir + n, R + n, -1, m + 1);
+                scs_set_as_scaled_array(dir, work->R, -sqrt_rhox, n);
+                scs_set_as_scaled_array(dir + n, work->R + n, -1, m + 1);
 
             } else {
                 scs_update_caches(work, sqrt_rhox, how);
-                scs_scale_array(R, sqrt_rhox, n); /* R *= sqrt_rhox */
+                scs_scale_array(work->R, sqrt_rhox, n); /* R *= sqrt_rhox */
                 if (scs_compute_direction(work, i) < 0) { /* compute direction */
                     /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
                      * Function `scs_compute_direction` is invoked at iterations i>=1.
@@ -2129,7 +2889,7 @@ scs_int superscs_solve(
                     return scs_failure(work, m, n, sol, info, SCS_FAILED,
                             "error in scs_compute_direction", "Failure", print_mode);
                 }
-                scs_scale_array(R, 1 / sqrt_rhox, n); /* R = R/sqrt_rhox */
+                scs_scale_array(work->R, 1 / sqrt_rhox, n); /* R = R/sqrt_rhox */
             }
             /* -------------------------------------------
              * Scale the x-part of dir using sqrt_rhox
@@ -2137,9 +2897,10 @@ scs_int superscs_solve(
             scs_scale_array(dir, 1 / sqrt_rhox, n);
         }
 
-        memcpy(u_prev, u, l * sizeof (scs_float)); /* u_prev = u */
-        memcpy(R_prev, R, l * sizeof (scs_float)); /* R_prev = R */
-        scs_scale_array(R_prev, sqrt_rhox, n);
+        /* u_prev = u and R_prev = R by swapping pointers; the new iterate
+         * is written into the buffer of u (out of place) */
+        scs_swap_arrays(&work->u, &work->u_prev);
+        scs_swap_arrays(&work->R, &work->R_prev);
         how = -1; /* no backtracking (yet) */
         nrmR_con_old = work->nrmR_con;
 
@@ -2148,7 +2909,7 @@ scs_int superscs_solve(
              *   Blind updates (K0)
              * ------------------------------------------------ */
             if (settings->k0 == 1 && work->nrmR_con <= settings->c_bl * eta) {
-                scs_add_array(u, dir, l); /* u += dir */
+                scs_axpy(work->u, work->u_prev, dir, 1.0, 1.0, l); /* u = u_prev + dir */
                 how = 0;
                 eta = work->nrmR_con;
                 work->stepsize = 1.0;
@@ -2162,17 +2923,19 @@ scs_int superscs_solve(
                  *   Line search 
                  *   Main computational burden: 1 projection
                  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+                scs_get_cone_warm_start(work->coneWork, cone, work->ls_warm_start);
                 for (j_iter_ls = 0; j_iter_ls < settings->ls; ++j_iter_ls) {
-                    work->stepsize *= settings->beta;
-                    scs_axpy(wu, u, dir, 1.0, work->stepsize, l); /* wu = u + step * dir */
-                    scs_axpy(wu_t, u_t, dut, 1.0, work->stepsize, l); /* wut = u_t + step * dut */
-
-                    if (superscs_project_cones(wu_b, wu_t, wu, work, cone, i) < 0) {
-                        return scs_failure(work, m, n, sol, info, SCS_FAILED, "error in superscs_project_cones", "Failure", print_mode);
+                    scs_int slot = j_iter_ls % work->ls_slots;
+                    if (slot == 0) {
+                        /* evaluate the next (up to) ls_slots step sizes at once */
+                        if (superscs_line_search_trials(work, cone, dir, dut, work->stepsize * settings->beta,
+                                MIN(work->ls_slots, settings->ls - j_iter_ls), i) < 0) {
+                            return scs_failure(work, m, n, sol, info, SCS_FAILED, "error in superscs_project_cones", "Failure", print_mode);
+                        }
                     }
-                    scs_calc_FPR(Rwu, wu_t, wu_b, l); /* calculate FPR on scaled vectors */
-
-                    nrmRw_con = SQRTF(scs_norm_squared(Rwu + n, m + 1) + rhox * scs_norm_squared(Rwu, n));
+                    work->stepsize *= settings->beta;
+                    scs_ls_select(work, cone, slot);
+                    nrmRw_con = work->ls_nrmR[slot];
 
                     /* K1 */
                     if (settings->k1
@@ -2190,8 +2953,8 @@ scs_int superscs_solve(
         } /* IF-block: iterated after warm start */
 
         if (how == -1) { /* means that R didn't change */
-            /* x -= alpha*Rx */
-            scs_add_scaled_array(u, R, l, -alpha);
+            /* x = x_prev - alpha*Rx */
+            scs_axpy(work->u, work->u_prev, work->R_prev, 1.0, -alpha, l);
         } /* how == -1 */
         if (how != 1) { /* exited with other than K1 */
             scs_int status = scs_exit_loop_without_k1(work, sol, info, cone, i, print_mode);
@@ -2202,14 +2965,25 @@ scs_int superscs_solve(
         /* -------------------------------------------
          * Record some more progress information
          * -------------------------------------------*/
-        if (settings->do_record_progress && i % SCS_CONVERGED_INTERVAL == 0) {
-            scs_int idx_progress = i / SCS_CONVERGED_INTERVAL;
-            info->progress_mode[idx_progress] = how;
-            info->progress_ls[idx_progress] = j_iter_ls;
+        if (checked) {
+            if (settings->do_record_progress) {
+                info->progress_mode[idx_progress] = how;
+                info->progress_ls[idx_progress] = j_iter_ls;
+                info->progress_mem[idx_progress] = work->direction_cache != SCS_NULL
+                        ? work->direction_cache->mem_active : 0;
+            }
+            idx_progress++;
         }
 
     } /* main for loop */
 
+    if (settings->async_monitor) {
+        /* report the snapshot certified by the monitor (if any) */
+        scs_int certified_status;
+        scs_monitor_stop(work);
+        certified_status = scs_monitor_certified(work, &r, &i, &idx_progress);
+        if (certified_status != 0) info->statusVal = certified_status;
+    }
 
     info->cg_total_iters = scs_linsys_total_cg_iters(work->p);
     info->linsys_total_solve_time_ms = scs_linsys_total_solve_time_ms(work->p);
@@ -2224,11 +2998,16 @@ scs_int superscs_solve(
     scs_get_solution(work, sol, info, &r, i);
     info->iter = i;
     info->solveTime = scs_toc_quiet(&solveTimer);
-    info->history_length = i / SCS_CONVERGED_INTERVAL;
+    info->history_length = idx_progress;
+    for (s = 0; s < work->ls_slots - 1; ++s) {
+        scs_add_cone_stats(work->coneWork, work->ls_cone_work[s]);
+    }
+    scs_set_cone_stats(work->coneWork, info);
 
     if (settings->verbose)
-        scs_print_footer(data, cone, sol, work, info); /* LCOV_EXCL_LINE */
-    endInterruptListener();
+        scs_print_footer(data, cone,
+                scs_work_solution(work, sol), work, info); /* LCOV_EXCL_LINE */
+    endInterruptListener(&work->interrupt);
 
     return info->statusVal;
 }
@@ -2239,12 +3018,20 @@ void scs_finish(ScsWork * RESTRICT w) {
         if (w->stgs != SCS_NULL && w->stgs->normalize != 0) {
 #ifndef COPYAMATRIX
             scs_unnormalize_a(w->A, w->stgs, w->scal);
+            if (w->P != SCS_NULL) {
+                scs_unnormalize_p(w->P, w->scal, w->stgs->scale * w->sc_c / w->sc_b);
+            }
 #else
             scs_free_a_matrix(w->A);
+            if (w->P != SCS_NULL) {
+                scs_free_a_matrix(w->P);
+            }
 #endif
         }
         if (w->p != SCS_NULL)
             scs_free_priv(w->p);
+        scs_chordal_free(w->chordal);
+        scs_presolve_free(w->presolve);
         scs_free_work(w);
     }
 }
@@ -2254,8 +3041,9 @@ ScsWork * scs_init(
         const ScsCone * RESTRICT cone,
         ScsInfo * RESTRICT info) {
     ScsWork * RESTRICT work;
+    ScsChordal * chordal = SCS_NULL;
+    ScsPresolve * presolve = SCS_NULL;
     ScsTimer initTimer;
-    startInterruptListener();
     if (data == SCS_NULL
             || cone == SCS_NULL
             || info == SCS_NULL) {
@@ -2271,14 +3059,36 @@ ScsWork * scs_init(
     }
 #endif
     scs_tic(&initTimer);
-    work = scs_init_work(data, cone);
+    if (data->stgs->presolve_cones) {
+        presolve = scs_presolve_init(data, cone);
+    }
+    if (presolve != SCS_NULL) {
+        data = presolve->data;
+        cone = presolve->cone;
+    }
+    if (data->stgs->chordal_decomposition) {
+        chordal = scs_chordal_init(data, cone);
+    }
+    if (chordal != SCS_NULL) {
+        work = scs_init_work(chordal->data, chordal->cone);
+    } else {
+        work = scs_init_work(data, cone);
+    }
+    if (work != SCS_NULL) {
+        work->chordal = chordal;
+        work->presolve = presolve;
+    } else {
+        /* LCOV_EXCL_START */
+        scs_chordal_free(chordal);
+        scs_presolve_free(presolve);
+        /* LCOV_EXCL_STOP */
+    }
     /* strtoc("init", &initTimer); */
     info->setupTime = scs_toc_quiet(&initTimer);
     if (data->stgs->verbose) {
         scs_special_print(work->stgs->do_override_streams,
                 work->stgs->output_stream, "Setup time: %1.2es\n", info->setupTime / 1e3);
     }
-    endInterruptListener();
     return work;
 }
 
@@ -2291,6 +3101,7 @@ static void scs_compute_allocated_memory(
     unsigned long long allocated_memory;
     size_t i;
     size_t float_size = (scs_int) sizeof (scs_float);
+    size_t cache_float_size = (scs_int) sizeof (scs_cache_float);
     size_t int_size = (scs_int) sizeof (scs_int);
     size_t l = data->m + data->n + 1;
     long mem = work->stgs->memory;
@@ -2306,6 +3117,8 @@ static void scs_compute_allocated_memory(
             + 6 * data->m
             + 9 * data->n
             + k->qsize
+            + k->rqsize
+            + k->bsize
             + k->psize
             + k->ssize
             + 2 * temp_n_max * temp_n_max
@@ -2318,19 +3131,34 @@ static void scs_compute_allocated_memory(
             + data->m + 2);
 
     if (work->stgs->ls > 0) {
-        allocated_memory += float_size * 4 * l;
+        allocated_memory += float_size * (4 * l * work->ls_slots + work->ls_slots - 4 * l
+                + scs_cone_warm_start_size(k));
     }
+    /* the cached vectors (S, U, S-Y) are of type scs_cache_float */
     if (work->stgs->direction == restarted_broyden && mem > 0) {
-        allocated_memory += float_size * 2 * l * (mem + 1);
+        allocated_memory += cache_float_size * 2 * l * (mem + 1)
+                + float_size * (l + mem * mem + 2 * mem);
     }
     if (work->stgs->direction == anderson_acceleration) {
-        allocated_memory += float_size * (4 * l * mem + l
-                + mem + scs_svd_workspace_size(l, mem));
+        allocated_memory += cache_float_size * l * mem
+                + float_size * (l * mem + mem * mem + mem);
+        if (work->stgs->anderson_gram) {
+            allocated_memory += cache_float_size * l * mem + float_size * mem * mem;
+        }
+    }
+    if (work->stgs->direction == full_broyden) {
+        allocated_memory += cache_float_size * 2 * l * (mem + 1)
+                + float_size * (l + 2 * (mem + 1) * (mem + 1) + mem * mem + 5 * (mem + 1));
     }
 
     if (work->stgs->normalize) {
         allocated_memory += float_size * (data->m + data->n);
     }
+    if (data->P != SCS_NULL) {
+        /* copy of P and the workspace for products with it */
+        allocated_memory += float_size * (data->P->p[data->n] + data->n)
+                + int_size * (data->P->p[data->n] + data->n + 1);
+    }
     info->allocated_memory = allocated_memory;
 }
 
@@ -2525,6 +3353,7 @@ ScsInfo * scs_init_info() {
     info->progress_time = SCS_NULL;
     info->progress_mode = SCS_NULL;
     info->progress_ls = SCS_NULL;
+    info->progress_mem = SCS_NULL;
     return info;
 }
 
@@ -2539,6 +3368,7 @@ ScsData * scs_init_data() {
     }
 
     data->A = SCS_NULL;
+    data->P = SCS_NULL;
     data->b = SCS_NULL;
     data->c = SCS_NULL;
     data->m = 0;
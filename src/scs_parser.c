@@ -54,21 +54,24 @@ static const char scs_yaml_matrix_A_J[] = "J";
 static const char scs_yaml_vector_b[] = "b";
 static const char scs_yaml_vector_c[] = "c";
 static const char scs_yaml_cone_K[] = "K";
+static const char scs_yaml_cone_field_bl[] = "bl";
+static const char scs_yaml_cone_field_bu[] = "bu";
 static const char scs_yaml_cone_field_ep[] = "ep";
 static const char scs_yaml_cone_field_ed[] = "ed";
 static const char scs_yaml_cone_field_f[] = "f";
 static const char scs_yaml_cone_field_l[] = "l";
 static const char scs_yaml_cone_field_p[] = "p";
 static const char scs_yaml_cone_field_q[] = "q";
+static const char scs_yaml_cone_field_rq[] = "rq";
 static const char scs_yaml_cone_field_s[] = "s";
+static const char scs_yaml_cone_field_bsize[] = "bsize";
 static const char scs_yaml_cone_field_psize[] = "psize";
 static const char scs_yaml_cone_field_qsize[] = "qsize";
+static const char scs_yaml_cone_field_rqsize[] = "rqsize";
 static const char scs_yaml_cone_field_ssize[] = "ssize";
 
-static char scs_yaml_variable_name[SCS_YAML_CHAR_LEN];
-
-static void scs_yaml_clear_char_array(void) {
-    memset(scs_yaml_variable_name, 0, SCS_YAML_CHAR_LEN * sizeof (char));
+static void scs_yaml_clear_char_array(char * name) {
+    memset(name, 0, SCS_YAML_CHAR_LEN * sizeof (char));
 }
 
 static void scs_yaml_skip_to_end_of_line(FILE * fp) {
@@ -76,7 +79,12 @@ static void scs_yaml_skip_to_end_of_line(FILE * fp) {
     while ((c = fgetc(fp)) != EOF && c != SCS_EOL);
 }
 
-static char * scs_yaml_get_variable_name(FILE * fp) {
+/* 
+ * Reads the name of the next variable into `name`, which is an array of 
+ * length SCS_YAML_CHAR_LEN owned by the caller (so that the parser can be
+ * used from several threads).
+ */
+static char * scs_yaml_get_variable_name(FILE * fp, char * name) {
     int c;
     size_t k = 0;
     char colon = ':';
@@ -84,15 +92,15 @@ static char * scs_yaml_get_variable_name(FILE * fp) {
     char begin_yaml[] = "---";
     char end_yaml[] = "...";
 
-    scs_yaml_clear_char_array();
+    scs_yaml_clear_char_array(name);
 
     /* read the first three characters (unless a hash is found - then stop) */
     while (k < 3 && (c = fgetc(fp)) != EOF && c != colon && c != hash)
-        if (c != ' ' && c != '\n') scs_yaml_variable_name[k++] = (char) c;
+        if (c != ' ' && c != '\n') name[k++] = (char) c;
 
     /* check whether the first three chars are --- or ... */
-    if (strcmp(begin_yaml, scs_yaml_variable_name) == 0
-            || strcmp(end_yaml, scs_yaml_variable_name) == 0) {
+    if (strcmp(begin_yaml, name) == 0
+            || strcmp(end_yaml, name) == 0) {
         scs_yaml_skip_to_end_of_line(fp); /* skip to the end of the line */
         return SCS_NULL;
     }
@@ -101,19 +109,20 @@ static char * scs_yaml_get_variable_name(FILE * fp) {
         scs_yaml_skip_to_end_of_line(fp); /* skip to the end of the line */
         return SCS_NULL;
     }
-    if (c == colon) return scs_yaml_variable_name;
+    if (c == colon) return name;
 
     /* read the rest */
     while ((c = fgetc(fp)) != EOF && c != colon)
-        if (c != ' ') scs_yaml_variable_name[k++] = (char) c;
+        if (c != ' ' && k < SCS_YAML_CHAR_LEN - 1) name[k++] = (char) c;
 
-    return scs_yaml_variable_name; /* variable name */
+    return name; /* variable name */
 }
 
 static void scs_yaml_skip_to_problem(FILE * fp) {
     while (!feof(fp)) {
+        char name[SCS_YAML_CHAR_LEN];
         char * var_name;
-        var_name = scs_yaml_get_variable_name(fp);
+        var_name = scs_yaml_get_variable_name(fp, name);
         if (var_name != SCS_NULL) {
             scs_yaml_skip_to_end_of_line(fp);
             if (strcmp(var_name, scs_yaml_problem) == 0) break;
@@ -140,8 +149,9 @@ static scs_float scs_yaml_read_numeric(FILE * fp) {
 static void scs_yaml_discover_matrix_sizes(FILE * fp, ScsData * data, scs_int * nnz) {
     size_t k = 0;
     while (k++ < 6 && !feof(fp)) {
+        char name[SCS_YAML_CHAR_LEN];
         char * var_name;
-        var_name = scs_yaml_get_variable_name(fp);
+        var_name = scs_yaml_get_variable_name(fp, name);
         if (var_name == SCS_NULL) {
             k--;
             continue;
@@ -159,9 +169,10 @@ static void scs_yaml_discover_matrix_sizes(FILE * fp, ScsData * data, scs_int *
 
 static void scs_yaml_discover_cone_sizes(FILE * fp, ScsCone * cone) {
     size_t k = 0;
-    while (k++ < 10 && !feof(fp)) {
+    while (k++ < 15 && !feof(fp)) {
+        char name[SCS_YAML_CHAR_LEN];
         char * var_name;
-        var_name = scs_yaml_get_variable_name(fp);
+        var_name = scs_yaml_get_variable_name(fp, name);
         if (var_name == SCS_NULL) {
             k--;
             continue;
@@ -170,8 +181,12 @@ static void scs_yaml_discover_cone_sizes(FILE * fp, ScsCone * cone) {
             cone->psize = scs_yaml_read_size_t(fp);
         } else if (strcmp(var_name, scs_yaml_cone_field_qsize) == 0) {
             cone->qsize = scs_yaml_read_size_t(fp);
+        } else if (strcmp(var_name, scs_yaml_cone_field_rqsize) == 0) {
+            cone->rqsize = scs_yaml_read_size_t(fp);
         } else if (strcmp(var_name, scs_yaml_cone_field_ssize) == 0) {
             cone->ssize = scs_yaml_read_size_t(fp);
+        } else if (strcmp(var_name, scs_yaml_cone_field_bsize) == 0) {
+            cone->bsize = scs_yaml_read_size_t(fp);
         }
         scs_yaml_skip_to_end_of_line(fp);
     }
@@ -188,8 +203,9 @@ static int scs_yaml_discover_sizes(
 
     /* parse the problem */
     while (!feof(fp)) {
+        char name[SCS_YAML_CHAR_LEN];
         char * variable_name;
-        variable_name = scs_yaml_get_variable_name(fp);
+        variable_name = scs_yaml_get_variable_name(fp, name);
         scs_yaml_skip_to_end_of_line(fp);
         if (variable_name == SCS_NULL) continue;
         if (strcmp(variable_name, scs_yaml_matrix_A) == 0) {
@@ -210,6 +226,8 @@ static int scs_yaml_initialise_data_and_cone(ScsData * data, ScsCone * cone, scs
     if (cone->psize < 0) return 703;
     if (cone->qsize < 0) return 704;
     if (cone->ssize < 0) return 705;
+    if (cone->bsize < 0) return 706;
+    if (cone->rqsize < 0) return 707;
 
     /* initialise matrix `A` */
     data->A = scs_malloc(sizeof (ScsAMatrix));
@@ -236,10 +254,22 @@ static int scs_yaml_initialise_data_and_cone(ScsData * data, ScsCone * cone, scs
     if (cone->qsize > 0 && cone->q == SCS_NULL) goto yaml_init_error_7;
     cone->s = scs_malloc(cone->ssize * sizeof (scs_int));
     if (cone->ssize && cone->s == SCS_NULL) goto yaml_init_error_8;
+    cone->bl = cone->bsize > 1 ? scs_malloc((cone->bsize - 1) * sizeof (scs_float)) : SCS_NULL;
+    if (cone->bsize > 1 && cone->bl == SCS_NULL) goto yaml_init_error_9;
+    cone->bu = cone->bsize > 1 ? scs_malloc((cone->bsize - 1) * sizeof (scs_float)) : SCS_NULL;
+    if (cone->bsize > 1 && cone->bu == SCS_NULL) goto yaml_init_error_10;
+    cone->rq = scs_malloc(cone->rqsize * sizeof (scs_int));
+    if (cone->rqsize > 0 && cone->rq == SCS_NULL) goto yaml_init_error_11;
 
     return 0;
 
     /* LCOV_EXCL_START */
+yaml_init_error_11:
+    scs_free(cone->bu);
+yaml_init_error_10:
+    scs_free(cone->bl);
+yaml_init_error_9:
+    scs_free(cone->s);
 yaml_init_error_8:
     scs_free(cone->q);
 yaml_init_error_7:
@@ -286,8 +316,9 @@ static int scs_yaml_parse_matrix_A(FILE * fp, ScsData * data, scs_int nonzeroes)
     size_t k = 0;
     int checkpoints = 0;
     while (k++ < 6 && !feof(fp)) {
+        char name[SCS_YAML_CHAR_LEN];
         char * var_name;
-        var_name = scs_yaml_get_variable_name(fp);
+        var_name = scs_yaml_get_variable_name(fp, name);
         if (var_name == SCS_NULL) {
             k--;
             continue;
@@ -309,9 +340,10 @@ static int scs_yaml_parse_matrix_A(FILE * fp, ScsData * data, scs_int nonzeroes)
 
 static int scs_yaml_parse_cone_K(FILE * fp, ScsCone * cone) {
     size_t k = 0;
+    char name[SCS_YAML_CHAR_LEN];
     char * var_name = SCS_NULL;
-    while (k++ < 10 && !feof(fp)) {
-        var_name = scs_yaml_get_variable_name(fp);
+    while (k++ < 15 && !feof(fp)) {
+        var_name = scs_yaml_get_variable_name(fp, name);
         if (var_name == SCS_NULL) {
             k--;
             continue;
@@ -330,6 +362,12 @@ static int scs_yaml_parse_cone_K(FILE * fp, ScsCone * cone) {
             } else if (cone->qsize > 1) {
                 if (scs_yaml_parse_int_array(fp, cone->q, cone->qsize)) return 1;
             }
+        } else if (strcmp(var_name, scs_yaml_cone_field_rq) == 0) {
+            if (cone->rqsize == 1) {
+                cone->rq[0] = (scs_int) scs_yaml_read_size_t(fp);
+            } else if (cone->rqsize > 1) {
+                if (scs_yaml_parse_int_array(fp, cone->rq, cone->rqsize)) return 1;
+            }
         } else if (strcmp(var_name, scs_yaml_cone_field_p) == 0) {
             if (cone->psize == 1) {
                 cone->p[0] = scs_yaml_read_numeric(fp);
@@ -342,6 +380,14 @@ static int scs_yaml_parse_cone_K(FILE * fp, ScsCone * cone) {
             } else if (cone->ssize > 1) {
                 if (scs_yaml_parse_int_array(fp, cone->s, cone->ssize)) return 1;
             }
+        } else if (strcmp(var_name, scs_yaml_cone_field_bl) == 0) {
+            if (cone->bsize > 1) {
+                if (scs_yaml_parse_float_array(fp, cone->bl, cone->bsize - 1)) return 1;
+            }
+        } else if (strcmp(var_name, scs_yaml_cone_field_bu) == 0) {
+            if (cone->bsize > 1) {
+                if (scs_yaml_parse_float_array(fp, cone->bu, cone->bsize - 1)) return 1;
+            }
         }
         scs_yaml_skip_to_end_of_line(fp);
     }
@@ -353,22 +399,23 @@ static int scs_yaml_parse_data_and_cone(
         ScsData * data,
         ScsCone * cone,
         scs_int nonzeroes) {
+    char name[SCS_YAML_CHAR_LEN];
     /* fast-forward to the problem */
     scs_yaml_skip_to_problem(fp);
 
     /* parse the problem */
     while (!feof(fp)) {
-        scs_yaml_get_variable_name(fp);
-        if (strcmp(scs_yaml_variable_name, scs_yaml_matrix_A) == 0) {
+        scs_yaml_get_variable_name(fp, name);
+        if (strcmp(name, scs_yaml_matrix_A) == 0) {
             scs_yaml_skip_to_end_of_line(fp);
             if (scs_yaml_parse_matrix_A(fp, data, nonzeroes)) return 1;
-        } else if (strcmp(scs_yaml_variable_name, scs_yaml_cone_K) == 0) {
+        } else if (strcmp(name, scs_yaml_cone_K) == 0) {
             scs_yaml_skip_to_end_of_line(fp);
             if (scs_yaml_parse_cone_K(fp, cone)) return 1;
-        } else if (strcmp(scs_yaml_variable_name, scs_yaml_vector_b) == 0) {
+        } else if (strcmp(name, scs_yaml_vector_b) == 0) {
             if (scs_yaml_parse_float_array(fp, data->b, data->m)) return 1;
             scs_yaml_skip_to_end_of_line(fp);
-        } else if (strcmp(scs_yaml_variable_name, scs_yaml_vector_c) == 0) {
+        } else if (strcmp(name, scs_yaml_vector_c) == 0) {
             if (scs_yaml_parse_float_array(fp, data->c, data->n)) return 1;
             scs_yaml_skip_to_end_of_line(fp);
         } else {
@@ -385,12 +432,17 @@ static void scs_reset_cone(ScsCone * cone) {
     cone->ep = 0;
     cone->f = 0;
     cone->l = 0;
+    cone->bsize = 0;
     cone->psize = 0;
     cone->ssize = 0;
     cone->qsize = 0;
     cone->q = SCS_NULL;
+    cone->rqsize = 0;
+    cone->rq = SCS_NULL;
     cone->p = SCS_NULL;
     cone->s = SCS_NULL;
+    cone->bl = SCS_NULL;
+    cone->bu = SCS_NULL;
 }
 
 scs_int scs_from_YAML(
@@ -462,9 +514,9 @@ exit_error_1:
     /* LCOV_EXCL_STOP */
 }
 
-static int scs_double_num_digits = 17;
-static char scs_yaml_space[] = "    ";
-static char scs_yaml_double_space[] = "        ";
+static const int scs_double_num_digits = 17;
+static const char scs_yaml_space[] = "    ";
+static const char scs_yaml_double_space[] = "        ";
 
 static void scs_serialize_array_to_YAML(
         FILE * RESTRICT fp,
@@ -524,6 +576,8 @@ static void scs_serialize_cone_to_YAML(
     fprintf(fp, "%s%s: %d\n", scs_yaml_double_space, scs_yaml_cone_field_psize, (int) cone->psize);
     fprintf(fp, "%s%s: %d\n", scs_yaml_double_space, scs_yaml_cone_field_qsize, (int) cone->qsize);
     fprintf(fp, "%s%s: %d\n", scs_yaml_double_space, scs_yaml_cone_field_ssize, (int) cone->ssize);
+    fprintf(fp, "%s%s: %d\n", scs_yaml_double_space, scs_yaml_cone_field_bsize, (int) cone->bsize);
+    fprintf(fp, "%s%s: %d\n", scs_yaml_double_space, scs_yaml_cone_field_rqsize, (int) cone->rqsize);
     fprintf(fp, "%s%s: %d\n", scs_yaml_double_space, scs_yaml_cone_field_f, (int) cone->f);
     fprintf(fp, "%s%s: %d\n", scs_yaml_double_space, scs_yaml_cone_field_l, (int) cone->l);
     fprintf(fp, "%s%s: %d\n", scs_yaml_double_space, scs_yaml_cone_field_ep, (int) cone->ep);
@@ -534,6 +588,12 @@ static void scs_serialize_cone_to_YAML(
         fprintf(fp, "%s%s: ", scs_yaml_double_space, scs_yaml_cone_field_q);
         scs_serialize_array_to_YAML(fp, cone->q, cone->qsize, 1);
     }
+    if (cone->rqsize == 1) {
+        fprintf(fp, "%s%s: %d\n", scs_yaml_double_space, scs_yaml_cone_field_rq, (int) cone->rq[0]);
+    } else {
+        fprintf(fp, "%s%s: ", scs_yaml_double_space, scs_yaml_cone_field_rq);
+        scs_serialize_array_to_YAML(fp, cone->rq, cone->rqsize, 1);
+    }
     if (cone->psize == 1) {
         fprintf(fp, "%s%s: %.*g\n", scs_yaml_double_space,
                 scs_yaml_cone_field_p, scs_double_num_digits,
@@ -549,6 +609,10 @@ static void scs_serialize_cone_to_YAML(
         fprintf(fp, "%s%s: ", scs_yaml_double_space, scs_yaml_cone_field_s);
         scs_serialize_array_to_YAML(fp, cone->s, cone->ssize, 1);
     }
+    fprintf(fp, "%s%s: ", scs_yaml_double_space, scs_yaml_cone_field_bl);
+    scs_serialize_array_to_YAML(fp, cone->bl, cone->bsize - 1, 0);
+    fprintf(fp, "%s%s: ", scs_yaml_double_space, scs_yaml_cone_field_bu);
+    scs_serialize_array_to_YAML(fp, cone->bu, cone->bsize - 1, 0);
 }
 
 scs_int scs_to_YAML(
@@ -619,7 +683,12 @@ static int scs_time_offset(void) {
 ScsConicProblemMetadata * scs_init_conic_problem_metadata(const char * problemName) {
     ScsConicProblemMetadata * metadata = SCS_NULL;
     time_t t = time(NULL);
-    struct tm date_time_now = *localtime(&t);
+    struct tm date_time_now;
+#if !defined(WIN32)
+    localtime_r(&t, &date_time_now);
+#else
+    date_time_now = *localtime(&t);
+#endif
 
     metadata = scs_malloc(sizeof (*metadata));
     if (metadata == SCS_NULL) return SCS_NULL;
@@ -93,6 +93,37 @@ scs_float scs_toc_quiet(ScsTimer *t) {
 }
 #endif
 
+void scs_deadline_start(ScsDeadline *d, ScsTimer *timer, scs_float budget) {
+    d->timer = timer;
+    d->budget = budget;
+    d->last = scs_toc_quiet(timer);
+    d->stride = 1;
+    d->countdown = 1;
+}
+
+scs_int scs_deadline_passed(ScsDeadline *d) {
+    scs_float now, per_call, target;
+    if (--d->countdown > 0) return 0;
+    now = scs_toc_quiet(d->timer);
+    if (now >= d->budget) {
+        d->countdown = 1;
+        return 1;
+    }
+    /* calibrate the stride using the time per call since the last reading */
+    per_call = (now - d->last) / d->stride;
+    target = MIN(SCS_DEADLINE_READ_INTERVAL, 0.5 * (d->budget - now));
+    if (per_call > 0) {
+        d->stride = target / per_call < SCS_DEADLINE_MAX_STRIDE
+                ? MAX(1, (scs_int) (target / per_call)) : SCS_DEADLINE_MAX_STRIDE;
+    } else {
+        /* below the resolution of the clock */
+        d->stride = MIN(2 * d->stride, SCS_DEADLINE_MAX_STRIDE);
+    }
+    d->last = now;
+    d->countdown = d->stride;
+    return 0;
+}
+
 /* LCOV_EXCL_START */
 scs_float scs_toc(ScsTimer *t) {
     scs_float time = scs_toc_quiet(t);
@@ -110,11 +141,17 @@ void scs_print_cone_data(const ScsCone *RESTRICT k) {
     scs_int i;
     scs_printf("num zeros = %i\n", (int) k->f);
     scs_printf("num LP = %i\n", (int) k->l);
+    scs_printf("box cone size = %i\n", (int) k->bsize);
     scs_printf("num SOCs = %i\n", (int) k->qsize);
     scs_printf("soc array:\n");
     for (i = 0; i < k->qsize; i++) {
         scs_printf("%i\n", (int) k->q[i]);
     }
+    scs_printf("num rotated SOCs = %i\n", (int) k->rqsize);
+    scs_printf("rotated soc array:\n");
+    for (i = 0; i < k->rqsize; i++) {
+        scs_printf("%i\n", (int) k->rq[i]);
+    }
     scs_printf("num SDCs = %i\n", (int) k->ssize);
     scs_printf("sdc array:\n");
     for (i = 0; i < k->ssize; i++) {
@@ -192,6 +229,9 @@ void scs_free_data(ScsData *RESTRICT data) {
         if (data->A != SCS_NULL) {
             scs_free_a_matrix(data->A);
         }
+        if (data->P != SCS_NULL) {
+            scs_free_a_matrix(data->P);
+        }
         scs_free(data);
     }
 }
@@ -200,10 +240,16 @@ void scs_free_cone(ScsCone *RESTRICT cone) {
     if (cone != SCS_NULL) {
         if (cone->q != SCS_NULL)
             scs_free(cone->q);
+        if (cone->rq != SCS_NULL)
+            scs_free(cone->rq);
         if (cone->s != SCS_NULL)
             scs_free(cone->s);
         if (cone->p != SCS_NULL)
             scs_free(cone->p);
+        if (cone->bl != SCS_NULL)
+            scs_free(cone->bl);
+        if (cone->bu != SCS_NULL)
+            scs_free(cone->bu);
         scs_free(cone);
     }
 }
@@ -260,6 +306,9 @@ void scs_free_info(ScsInfo *RESTRICT info) {
         if (info->progress_ls != SCS_NULL) {
             scs_free(info->progress_ls);
         }
+        if (info->progress_mem != SCS_NULL) {
+            scs_free(info->progress_mem);
+        }
         scs_free(info);
     }
 }
@@ -269,14 +318,20 @@ void scs_set_default_settings(ScsData *RESTRICT d) {
     d->stgs->max_time_milliseconds = SCS_MAX_TIME_MILLISECONDS;
     d->stgs->max_iters = SCS_MAX_ITERS_DEFAULT; /* maximum iterations to take: 2500 */
     d->stgs->previous_max_iters = SCS_PMAXITER_DEFAULT; /* maximum iterations of previous invocation */
+    d->stgs->max_check_interval = SCS_MAX_CHECK_INTERVAL_DEFAULT; /* check convergence at every iteration */
+    d->stgs->async_monitor = SCS_ASYNC_MONITOR_DEFAULT;
+    d->stgs->handle_interrupts = SCS_HANDLE_INTERRUPTS_DEFAULT;
     d->stgs->eps = SCS_EPS_DEFAULT; /* convergence tolerance: 1e-3 */
     d->stgs->alpha = SCS_ALPHA_DEFAULT; /* relaxation parameter: 1.5 */
     d->stgs->rho_x = SCS_RHO_X_DEFAULT; /* parameter rho_x: 1e-3 */
     d->stgs->scale = SCS_SCALE_DEFAULT; /* if normalized, rescales by this factor: 1 */
     d->stgs->cg_rate = SCS_CG_RATE_DEFAULT; /* for indirect, tolerance goes down like (1/iter)^CG_RATE: 2 */
+    d->stgs->inexact_cone_projections = SCS_INEXACT_CONE_PROJECTIONS_DEFAULT; /* boolean, inexact cone projections: 0 */
     d->stgs->verbose = SCS_VERBOSE_DEFAULT; /* int, 3 levels (0, 1, 2), write out progress: 1 */
     d->stgs->normalize = SCS_NORMALIZE_DEFAULT; /* boolean, heuristic data rescaling: 1 */
     d->stgs->warm_start = SCS_WARM_START_DEFAULT;
+    d->stgs->chordal_decomposition = SCS_CHORDAL_DECOMPOSITION_DEFAULT;
+    d->stgs->presolve_cones = SCS_PRESOLVE_CONES_DEFAULT;
 
     /* -----------------------------
      * SuperSCS-specific parameters
@@ -288,10 +343,13 @@ void scs_set_default_settings(ScsData *RESTRICT d) {
     d->stgs->k1 = SCS_K1_DEFAULT;
     d->stgs->k2 = SCS_K2_DEFAULT;
     d->stgs->ls = SCS_LS_DEFAULT;
+    d->stgs->ls_parallel = SCS_LS_PARALLEL_DEFAULT;
     d->stgs->sigma = SCS_SIGMA_DEFAULT;
     d->stgs->thetabar = SCS_THETABAR_DEFAULT;
     d->stgs->sse = SCS_SSE_DEFAULT;
     d->stgs->memory = SCS_MEMORY_DEFAULT;
+    d->stgs->anderson_gram = SCS_ANDERSON_GRAM_DEFAULT;
+    d->stgs->adaptive_memory = SCS_ADAPTIVE_MEMORY_DEFAULT;
     d->stgs->direction = SCS_DIRECTION_DEFAULT;
     d->stgs->do_super_scs = SCS_DO_SUPERSCS_DEFAULT; /* whether to run in SuperSCS mode (default: 1) */
     d->stgs->do_record_progress = SCS_DO_RECORD_PROGRESS_DEFAULT;
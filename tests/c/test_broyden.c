@@ -27,6 +27,14 @@
  */
 #include "test_broyden.h"
 
+/* x <- x_c, where x_c is a vector stored in the direction cache */
+static void load_cached(scs_float * x, const scs_cache_float * x_c, scs_int l) {
+    scs_int i;
+    for (i = 0; i < l; ++i) {
+        x[i] = x_c[i];
+    }
+}
+
 static void randomize_values(scs_float* x, scs_int l) {
     scs_int i;
     for (i = 0; i < l; ++i) {
@@ -39,9 +47,13 @@ static void prepare_work(ScsWork * work, scs_int l_size, scs_int memory) {
     work->stgs = scs_calloc(1, sizeof (ScsSettings));
     work->stgs->thetabar = 0.2;
     work->direction_cache = scs_calloc(1, sizeof (ScsDirectionCache));
-    work->direction_cache->S = scs_calloc((1 + memory) * l_size, sizeof (scs_float));
-    work->direction_cache->U = scs_calloc((1 + memory) * l_size, sizeof (scs_float));
+    work->direction_cache->S = scs_calloc((1 + memory) * l_size, sizeof (scs_cache_float));
+    work->direction_cache->U = scs_calloc((1 + memory) * l_size, sizeof (scs_cache_float));
+    work->direction_cache->ws = scs_calloc(l_size, sizeof (scs_float));
+    work->direction_cache->StU = scs_calloc(memory * memory, sizeof (scs_float));
+    work->direction_cache->t = scs_calloc(2 * memory, sizeof (scs_float));
     work->direction_cache->mem = memory;
+    work->direction_cache->mem_active = memory;
     work->direction_cache->mem_cursor = 0;
     work->Sk = scs_calloc(l_size, sizeof (scs_float)); /* malloc would be just fine anyway... */
     work->Yk = scs_calloc(l_size, sizeof (scs_float));
@@ -81,6 +93,9 @@ static void destroy_work(ScsWork * work) {
         if (work->direction_cache->U) {
             scs_free(work->direction_cache->U);
         }
+        scs_free(work->direction_cache->StU);
+        scs_free(work->direction_cache->ws);
+        scs_free(work->direction_cache->t);
         scs_free(work->direction_cache);
     }
     scs_free(work);
@@ -128,6 +143,7 @@ bool test_broyden_direction_empty_memory(char** str) {
     scs_int method_status;
     scs_float u_expected[4] = {-0.0366837857666911, 0.0330154071900220, -0.0440205429200293, 0.2017608217168012};
     scs_float d_expected[4] = {-3.73213499633162, -4.71107850330154, -1.21856199559795, 7.57674247982392};
+    scs_float cached[4];
 
     prepare_work(work, l, mem);
 
@@ -156,9 +172,11 @@ bool test_broyden_direction_empty_memory(char** str) {
 
     method_status = scs_compute_dir_restarted_broyden(work);
     ASSERT_EQUAL_INT_OR_FAIL(method_status, SCS_DIRECTION_CACHE_INCREMENT, str, "memory not incremented");
-    ASSERT_EQUAL_ARRAY_OR_FAIL(work->direction_cache->U, u_expected, l, 1e-10, str, "u not correct");
-    ASSERT_EQUAL_ARRAY_OR_FAIL(work->dir, d_expected, l, 1e-10, str, "direction not correct");
-    ASSERT_EQUAL_ARRAY_OR_FAIL(work->direction_cache->S, work->Sk, l, 1e-10, str, "sk not added to the cache");
+    load_cached(cached, work->direction_cache->U, l);
+    ASSERT_EQUAL_ARRAY_OR_FAIL(cached, u_expected, l, CACHE_TOL(1e-10), str, "u not correct");
+    ASSERT_EQUAL_ARRAY_OR_FAIL(work->dir, d_expected, l, CACHE_TOL(1e-10), str, "direction not correct");
+    load_cached(cached, work->direction_cache->S, l);
+    ASSERT_EQUAL_ARRAY_OR_FAIL(cached, work->Sk, l, CACHE_TOL(1e-10), str, "sk not added to the cache");
 
 
     destroy_work(work);
@@ -176,7 +194,7 @@ bool test_cache_s(char** str) {
     const scs_int mem = 10;
     const scs_int runs = 500;
     scs_int method_status;
-    scs_float * S_prev;
+    scs_cache_float * S_prev;
 
     prepare_work(work, l, mem);
     ASSERT_EQUAL_INT_OR_FAIL(work->direction_cache->mem, mem, str, "memory not set");
@@ -208,7 +226,7 @@ bool test_cache_s(char** str) {
                     ASSERT_EQUAL_FLOAT_OR_FAIL(
                             S_prev[j],
                             0.1 * (j + 1) + 10.0 / (i + 2 - k),
-                            1e-9, str, "S_previous incorrect");
+                            CACHE_TOL(1e-9), str, "S_previous incorrect");
                 }
             }
         }
@@ -222,7 +240,7 @@ bool test_cache_s(char** str) {
 
 bool test_broyden(char** str) {
     ScsWork * work = scs_calloc(1, sizeof (ScsWork));
-    const scs_float tol = 1e-10;
+    const scs_float tol = CACHE_TOL(1e-10);
     const scs_int l = 3;
     const scs_int mem = 4;
     scs_int i;
@@ -304,28 +322,240 @@ bool test_broyden(char** str) {
     scs_compute_dir_restarted_broyden(work);
     ASSERT_EQUAL_INT_OR_FAIL(work->direction_cache->mem_cursor, 3, str, "wrong cursor position");
     for (i = 0; i < work->direction_cache->mem_cursor * l; ++i) {
-        ASSERT_EQUAL_FLOAT_OR_FAIL(work->direction_cache->S[i], 0.1 * (i + 1), 1e-10, str, "wrong memory entry");
+        ASSERT_EQUAL_FLOAT_OR_FAIL(work->direction_cache->S[i], 0.1 * (i + 1), CACHE_TOL(1e-10), str, "wrong memory entry");
     }
 
     if (work != SCS_NULL) destroy_work(work);
     SUCCEED(str);
 }
 
-bool test_full_broyden(char** str) {
+bool test_broyden_blocked_direction(char** str) {
     ScsWork * work = scs_calloc(1, sizeof (ScsWork));
-    /* const scs_float tol = 1e-10; */
-    const scs_int l = 3;
+    const scs_int l = 7;
     const scs_int mem = 4;
-    /* scs_int i; */
+    const scs_int runs = 11;
+    scs_float S[28], U[28], s_tilde[7], dir[7];
+    scs_float ip, s_norm_sq, theta;
+    scs_int i, j, k, cols = 0;
 
     prepare_work(work, l, mem);
+    work->stgs->thetabar = 0.5;
+
+    for (k = 0; k < runs; ++k) {
+        for (i = 0; i < l; ++i) {
+            work->Sk[i] = sin(0.9 * (k + 1) * (i + 1));
+            work->Yk[i] = cos(0.4 * (k + 2) * (i + 1)) + 0.5 * work->Sk[i];
+            work->R[i] = sin(0.3 * k + 2 * i);
+        }
+        /* reference: apply the cached updates one at a time */
+        memcpy(s_tilde, work->Yk, l * sizeof (scs_float));
+        scs_set_as_scaled_array(dir, work->R, -1.0, l);
+        for (j = 0; j < cols; ++j) {
+            ip = scs_inner_product(S + j * l, s_tilde, l);
+            scs_add_scaled_array(s_tilde, U + j * l, l, ip);
+            ip = scs_inner_product(S + j * l, dir, l);
+            scs_add_scaled_array(dir, U + j * l, l, ip);
+        }
+        ip = scs_inner_product(s_tilde, work->Sk, l);
+        s_norm_sq = scs_norm_squared(work->Sk, l);
+        theta = 1;
+        if (ABS(ip) < work->stgs->thetabar * s_norm_sq) {
+            theta = s_norm_sq * (1 - SGN(ip) * work->stgs->thetabar) / (s_norm_sq - ip);
+            scs_scale_array(s_tilde, theta, l);
+            scs_add_scaled_array(s_tilde, work->Sk, l, 1 - theta);
+        }
+        ip = (1 - theta) * s_norm_sq + theta * ip;
+        for (i = 0; i < l; ++i) {
+            U[i + cols * l] = (work->Sk[i] - s_tilde[i]) / ip;
+        }
+        ip = scs_inner_product(work->Sk, dir, l);
+        scs_add_scaled_array(dir, U + cols * l, l, ip);
+        memcpy(S + cols * l, work->Sk, l * sizeof (scs_float));
+
+        scs_compute_dir_restarted_broyden(work);
+        load_cached(s_tilde, work->direction_cache->U + cols * l, l);
+        ASSERT_EQUAL_ARRAY_OR_FAIL(s_tilde, U + cols * l, l, CACHE_TOL(1e-10), str, "wrong u");
+        ASSERT_EQUAL_ARRAY_OR_FAIL(work->dir, dir, l, CACHE_TOL(1e-10), str, "wrong direction");
+        cols = (cols + 1) % mem;
+        ASSERT_EQUAL_INT_OR_FAIL(work->direction_cache->mem_cursor, cols, str, "wrong cursor");
+    }
+
+    destroy_work(work);
+    SUCCEED(str);
+}
+
+/* H <- H + (s - H y) s'H / <s, H y>, with H dense (l-by-l) */
+static void broyden_dense_update(scs_float * H, const scs_float * s,
+        const scs_float * Hy, scs_float * sH, scs_int l) {
+    scs_float ip = scs_inner_product(s, Hy, l);
+    scs_int i, j;
+    scs_matrix_transpose_multiply(l, 1, l, 1.0, H, 0.0, s, sH); /* H's */
+    for (j = 0; j < l; ++j) {
+        for (i = 0; i < l; ++i) {
+            H[i + j * l] += (s[i] - Hy[i]) * sH[j] / ip;
+        }
+    }
+}
+
+bool test_full_broyden(char** str) {
+    ScsWork * work = scs_calloc(1, sizeof (ScsWork));
+    ScsDirectionCache * cache;
+    const scs_int l = 6;
+    const scs_int mem = 3;
+    const scs_int runs = 9;
+    const scs_int slots = mem + 1;
+    scs_float H[36], H_win[36], Hy[6], sH[6], dir_expected[6];
+    scs_float s_cached[6], y_cached[6];
+    scs_float ip, s_norm_sq, theta;
+    scs_int i, j, k, slot;
+
+    prepare_work(work, l, mem);
+    cache = work->direction_cache;
+    scs_free(cache->StU);
+    scs_free(cache->t);
+    cache->StU = scs_calloc(slots * slots, sizeof (scs_float));
+    cache->G = scs_calloc(slots * slots, sizeof (scs_float));
+    cache->R = scs_calloc(mem * mem, sizeof (scs_float));
+    cache->t = scs_calloc(5 * slots, sizeof (scs_float));
     work->stgs->direction = full_broyden;
     work->stgs->broyden_init_scaling = 1;
-    work->stgs->tRule = 1;
-    
+    work->stgs->thetabar = 0.5;
+    scs_reset_direction_cache(cache);
+
+    for (k = 0; k < runs; ++k) {
+        for (i = 0; i < l; ++i) {
+            work->Sk[i] = sin(0.8 * (k + 1) * (i + 1));
+            work->Yk[i] = cos(1.1 * (k + 2) * (i + 1)) + work->Sk[i];
+            work->R[i] = sin(0.4 * k + i);
+        }
+
+        if (k < mem) {
+            /* reference: dense Broyden method with Powell's safeguard */
+            if (k == 0) {
+                memset(H, 0, l * l * sizeof (scs_float));
+                ip = scs_inner_product(work->Sk, work->Yk, l)
+                        / scs_norm_squared(work->Yk, l);
+                for (i = 0; i < l; ++i) H[i * (l + 1)] = ip;
+            }
+            memset(Hy, 0, l * sizeof (scs_float));
+            scs_matrix_multiply(l, 1, l, 1.0, H, 0.0, work->Yk, Hy);
+            ip = scs_inner_product(work->Sk, Hy, l);
+            s_norm_sq = scs_norm_squared(work->Sk, l);
+            if (ABS(ip) < work->stgs->thetabar * s_norm_sq) {
+                theta = s_norm_sq * (1 - SGN(ip) * work->stgs->thetabar) / (s_norm_sq - ip);
+                scs_scale_array(Hy, theta, l);
+                scs_add_scaled_array(Hy, work->Sk, l, 1 - theta);
+            }
+            broyden_dense_update(H, work->Sk, Hy, sH, l);
+        }
+
+        ASSERT_EQUAL_INT_OR_FAIL(scs_compute_direction(work, k), SCS_DIRECTION_SUCCESS,
+                str, "direction not computed");
+        ASSERT_EQUAL_INT_OR_FAIL(cache->current_mem, MIN(k + 1, mem), str, "wrong memory length");
+
+        if (k < mem) {
+            memset(dir_expected, 0, l * sizeof (scs_float));
+            scs_matrix_multiply(l, 1, l, -1.0, H, 0.0, work->R, dir_expected);
+            ASSERT_EQUAL_ARRAY_OR_FAIL(work->dir, dir_expected, l, CACHE_TOL(1e-9),
+                    str, "wrong direction (dense)");
+        }
+
+        /* reference: Broyden updates of h0 I using the cached pairs */
+        memset(H_win, 0, l * l * sizeof (scs_float));
+        for (i = 0; i < l; ++i) H_win[i * (l + 1)] = cache->h0;
+        for (j = 0; j < cache->current_mem; ++j) {
+            slot = (cache->mem_cursor - cache->current_mem + j + slots) % slots;
+            load_cached(s_cached, cache->S + slot * l, l);
+            load_cached(y_cached, cache->U + slot * l, l);
+            memset(Hy, 0, l * sizeof (scs_float));
+            scs_matrix_multiply(l, 1, l, 1.0, H_win, 0.0, y_cached, Hy);
+            broyden_dense_update(H_win, s_cached, Hy, sH, l);
+        }
+        memset(dir_expected, 0, l * sizeof (scs_float));
+        scs_matrix_multiply(l, 1, l, -1.0, H_win, 0.0, work->R, dir_expected);
+        ASSERT_EQUAL_ARRAY_OR_FAIL(work->dir, dir_expected, l, CACHE_TOL(1e-9),
+                str, "wrong direction");
+    }
+
+    scs_free(cache->G);
+    scs_free(cache->R);
+    destroy_work(work);
+    SUCCEED(str);
+}
+
+static bool check_anderson_direction(char** str, scs_int gram) {
+    ScsWork * work = scs_calloc(1, sizeof (ScsWork));
+    ScsDirectionCache * cache;
+    const scs_int l = 6;
+    const scs_int mem = 3;
+    const scs_int runs = 8;
+    scs_float S[18], Y[18], Y_copy[18], t[6], dir_expected[6];
+    scs_float * ls_wspace;
+    scs_int lwork, i, j, k, cols = 0;
+
+    prepare_work(work, l, mem);
+    cache = work->direction_cache;
+    cache->S_minus_Y = scs_calloc(mem * l, sizeof (scs_cache_float));
+    cache->Q = scs_calloc(mem * l, sizeof (scs_float));
+    cache->R = scs_calloc(mem * mem, sizeof (scs_float));
+    cache->G = scs_calloc(mem * mem, sizeof (scs_float));
+    work->stgs->direction = anderson_acceleration;
+    work->stgs->anderson_gram = gram;
+    scs_reset_direction_cache(cache);
+    lwork = scs_qr_workspace_size(l, mem);
+    ls_wspace = scs_calloc(lwork, sizeof (scs_float));
+
+    for (k = 0; k < runs; ++k) {
+        for (i = 0; i < l; ++i) {
+            work->Sk[i] = sin(0.7 * (k + 1) * (i + 1));
+            work->Yk[i] = cos(1.3 * (k + 1) * (i + 2));
+            work->R[i] = sin(0.5 * k + i);
+        }
+        /* reference: keep the last `mem` pairs (oldest first) and solve the
+         * least squares problem from scratch */
+        if (cols == mem) {
+            memmove(S, S + l, (mem - 1) * l * sizeof (scs_float));
+            memmove(Y, Y + l, (mem - 1) * l * sizeof (scs_float));
+            cols--;
+        }
+        memcpy(S + cols * l, work->Sk, l * sizeof (scs_float));
+        memcpy(Y + cols * l, work->Yk, l * sizeof (scs_float));
+        cols++;
+        memcpy(Y_copy, Y, cols * l * sizeof (scs_float));
+        memcpy(t, work->R, l * sizeof (scs_float));
+        scs_qrls(l, cols, Y_copy, t, ls_wspace, lwork);
+        for (i = 0; i < l; ++i) {
+            dir_expected[i] = -work->R[i];
+            for (j = 0; j < cols; ++j) {
+                dir_expected[i] -= (S[i + j * l] - Y[i + j * l]) * t[j];
+            }
+        }
+
+        ASSERT_EQUAL_INT_OR_FAIL(scs_compute_direction(work, k), SCS_DIRECTION_SUCCESS,
+                str, "direction not computed");
+        ASSERT_EQUAL_INT_OR_FAIL(cache->current_mem, cols, str, "wrong memory length");
+        /* the normal equations square the condition number of Y */
+        ASSERT_EQUAL_ARRAY_OR_FAIL(work->dir, dir_expected, l, CACHE_TOL(gram ? 1e-8 : 1e-10),
+                str, "wrong direction");
+    }
+
+    /* a linearly dependent y restarts the memory */
+    scs_compute_direction(work, runs);
+    ASSERT_EQUAL_INT_OR_FAIL(cache->current_mem, 1, str, "memory not restarted");
+
+    scs_free(ls_wspace);
+    scs_free(cache->S_minus_Y);
+    scs_free(cache->Q);
+    scs_free(cache->R);
+    scs_free(cache->G);
     destroy_work(work);
-    
-    /*TODO complete this test! */
-    
     SUCCEED(str);
 }
+
+bool test_anderson_direction(char** str) {
+    return check_anderson_direction(str, 0);
+}
+
+bool test_anderson_gram_direction(char** str) {
+    return check_anderson_direction(str, 1);
+}
@@ -53,7 +53,13 @@ extern "C" {
     
     bool test_broyden(char** str);
     
+    bool test_broyden_blocked_direction(char** str);
+    
     bool test_full_broyden(char** str);
+    
+    bool test_anderson_direction(char** str);
+    
+    bool test_anderson_gram_direction(char** str);
 
 
 #ifdef __cplusplus
@@ -52,6 +52,24 @@ int main(int argc, char** argv) {
     r += scs_test(&test_exponential_unbdd_from_YAML, "Solve exp cone problem from YAML");
     r += scs_test(&test_overtime_stop, "Stop on overtime (SuperSCS)");
     r += scs_test(&test_overtime_stop_scs, "Stop on overtime (SCS)");
+    r += scs_test(&test_chordal_decomposition, "Chordal decomposition of SDP");
+    r += scs_test(&test_chordal_large_sparse_cone, "Chordal decomposition of a large sparse cone");
+    r += scs_test(&test_exp_cone_projection, "Exponential cone projection");
+    r += scs_test(&test_power_cone_projection, "Power cone projection");
+    r += scs_test(&test_cone_projection_batch, "Batch of exp. and power cone projections");
+    r += scs_test(&test_cone_projection_early_iterations, "Cone projections in the first iterations");
+    r += scs_test(&test_inexact_cone_projections, "Inexact cone projections");
+    r += scs_test(&test_box_cone, "Box cone");
+    r += scs_test(&test_cone_stats, "Cone projection statistics");
+    r += scs_test(&test_presolve_cones, "Presolve of the cones");
+    r += scs_test(&test_rotated_soc, "Rotated second-order cone");
+    r += scs_test(&test_quadratic_cost, "Quadratic cost");
+    r += scs_test(&test_adaptive_memory, "Adaptive memory");
+    r += scs_test(&test_parallel_line_search, "Parallel line search");
+    r += scs_test(&test_adaptive_check_interval, "Adaptive convergence checks");
+    r += scs_test(&test_async_monitor, "Asynchronous convergence monitor");
+    r += scs_test(&test_interrupt_listeners, "Interrupt listeners");
+    r += scs_test(&test_concurrent_solves, "Concurrent solves");
     r += scs_test(&test_superscs_with_anderson, "Test SuperSCS with Anderson's accel.");
     r += scs_test(&test_superscs_011_progress, "Test SuperSCS (0,1,1) thoroughly");
     r += scs_test(&testscs_millis_to_time, "Milliseconds to time");
@@ -59,6 +77,10 @@ int main(int argc, char** argv) {
     r += scs_test(&test_scs_inner_product, "Unrolled dot");
     r += scs_test(&test_scs_subtract_array, "Unrolled subtraction");
     r += scs_test(&test_scs_norm_difference, "Norm of difference");
+    r += scs_test(&test_fused_kernels, "Fused vector kernels");
+    r += scs_test(&test_accum_by_a_and_a_trans, "Fused A*x and A'*y");
+    r += scs_test(&test_deadline, "Low-overhead deadline");
+    r += scs_test(&test_long_vector_kernels, "Long vector kernels");
     r += scs_test(&test_project_linsys_v2, "Test projLinSysv2");
     r += scs_test(&test_scs_cgls_square_matrix, "Test CGLS");
     r += scs_test(&test_scs_cgls_tall_matrix, "Test CGLS with tall matrix");
@@ -68,6 +90,7 @@ int main(int argc, char** argv) {
     r += scs_test(&test_scs_svd_least_sq_rank_deficient, "SVD-based least squares (rank def.)");
     r += scs_test(&test_scs_scale_array, "Test scs_scale_array");
     r += scs_test(&test_scs_gemm, "Test GEMM");
+    r += scs_test(&test_scs_gemm_blocks, "Test GEMM (blocks)");
     r += scs_test(&test_scs_gemm_cp, "Test GEMM/CP");
     r += scs_test(&test_scs_gemm_trans_cp, "Test GEMM/Tran/CP");
     r += scs_test(&test_cache_increments, "Test Restarted Broyden cache");
@@ -75,6 +98,9 @@ int main(int argc, char** argv) {
     r += scs_test(&test_full_broyden, "Test full Broyden");
     r += scs_test(&test_cache_s, "Test Broyden S-Cache");
     r += scs_test(&test_broyden, "Test Broyden dir correctness");
+    r += scs_test(&test_broyden_blocked_direction, "Test Broyden (blocked) dir correctness");
+    r += scs_test(&test_anderson_direction, "Test Anderson dir correctness");
+    r += scs_test(&test_anderson_gram_direction, "Test Anderson (Gram) dir correctness");
     r += scs_test(&test_superscs_solve, "Test SuperSCS");
     r += scs_test(&test_superscs_000, "Test SuperSCS (0,0,0)");
     r += scs_test(&test_superscs_001_fpr, "Test SuperSCS (0,0,1) with FPR");
@@ -30,6 +30,13 @@
 #include "linsys/common.h"
 #include <stdio.h>
 #include "scs_parser.h"
+#include "chordal.h"
+#include "presolve.h"
+#include <signal.h>
+#if !(defined _WIN32 || defined _WIN64 || defined _WINDLL)
+#define SCS_TEST_THREADS
+#include <pthread.h>
+#endif
 
 static void prepare_data(ScsData ** data) {
     const scs_int n = 3;
@@ -86,15 +93,74 @@ static void prepare_cone(ScsCone ** cone) {
     (*cone)->ep = 0;
     (*cone)->f = 0;
     (*cone)->l = 0;
+    (*cone)->bsize = 0;
+    (*cone)->bl = SCS_NULL;
+    (*cone)->bu = SCS_NULL;
     (*cone)->psize = 0;
     (*cone)->ssize = 0;
     (*cone)->qsize = 1;
     (*cone)->q = malloc(4 * sizeof (scs_int));
     (*cone)->q[0] = 4;
+    (*cone)->rqsize = 0;
+    (*cone)->rq = SCS_NULL;
     (*cone)->p = SCS_NULL;
     (*cone)->s = SCS_NULL;
 }
 
+/*
+ * maximize sum_i x_i subject to (x_i, 1, z_i) in the exponential cone and
+ * z_i <= 2 + i, for i = 0, ..., num_cones - 1 (i.e., x_i = log(2 + i))
+ */
+static void prepare_exp_problem(ScsData ** data, ScsCone ** cone, scs_int num_cones) {
+    const scs_int n = 3 * num_cones;
+    const scs_int m = 5 * num_cones;
+    scs_int i;
+    ScsAMatrix * A;
+
+    *data = scs_init_data();
+    (*data)->m = m;
+    (*data)->n = n;
+    (*data)->c = calloc(n, sizeof (scs_float));
+    (*data)->b = calloc(m, sizeof (scs_float));
+    A = malloc(sizeof (ScsAMatrix));
+    A->m = m;
+    A->n = n;
+    A->p = malloc((n + 1) * sizeof (scs_int));
+    A->i = malloc(5 * num_cones * sizeof (scs_int));
+    A->x = malloc(5 * num_cones * sizeof (scs_float));
+    A->p[0] = 0;
+    for (i = 0; i < num_cones; ++i) {
+        const scs_int row = 2 * num_cones + 3 * i;
+        const scs_int nz = A->p[3 * i];
+        (*data)->c[3 * i] = -1.0;
+        (*data)->b[i] = 1.0;
+        (*data)->b[num_cones + i] = 2.0 + i;
+        /* x_i */
+        A->i[nz] = row;
+        A->x[nz] = -1.0;
+        A->p[3 * i + 1] = nz + 1;
+        /* y_i = 1 */
+        A->i[nz + 1] = i;
+        A->x[nz + 1] = 1.0;
+        A->i[nz + 2] = row + 1;
+        A->x[nz + 2] = -1.0;
+        A->p[3 * i + 2] = nz + 3;
+        /* z_i <= 2 + i */
+        A->i[nz + 3] = num_cones + i;
+        A->x[nz + 3] = 1.0;
+        A->i[nz + 4] = row + 2;
+        A->x[nz + 4] = -1.0;
+        A->p[3 * i + 3] = nz + 5;
+    }
+    (*data)->A = A;
+
+    prepare_cone(cone);
+    (*cone)->qsize = 0;
+    (*cone)->f = num_cones;
+    (*cone)->l = num_cones;
+    (*cone)->ep = num_cones;
+}
+
 bool test_superscs_solve(char** str) {
 
     scs_int status;
@@ -184,6 +250,15 @@ bool test_superscs_with_anderson(char** str) {
     ASSERT_EQUAL_INT_OR_FAIL(info->iter, 13, str, "wrong number of iterations");
     ASSERT_EQUAL_INT_OR_FAIL(info->statusVal, SCS_SOLVED, str, "problem status not SCS_SOLVED");
 
+    data->stgs->anderson_gram = 1;
+    status = scs(data, cone, sol, info);
+    ASSERT_EQUAL_INT_OR_FAIL(status, SCS_SOLVED, str, "Problem not solved (Gram)");
+    ASSERT_TRUE_OR_FAIL(info->iter <= 15, str, "too many iterations (Gram)");
+
+    data->stgs->direction = (ScsDirectionType) full_broyden;
+    status = scs(data, cone, sol, info);
+    ASSERT_EQUAL_INT_OR_FAIL(status, SCS_SOLVED, str, "Problem not solved (full Broyden)");
+
     scs_free_data_cone(data, cone);
     scs_free_sol(sol);
     scs_free_info(info);
@@ -379,48 +454,48 @@ bool test_superscs_001_rbroyden(char** str) {
 
     status = scs(data, cone, sol, info);
     ASSERT_EQUAL_INT_OR_FAIL(status, SCS_UNBOUNDED_INACCURATE, str, "wrong status");
-    ASSERT_EQUAL_FLOAT_OR_FAIL(sol->x[0], 0.274057420504456, 1e-10, str, "x[0] wrong");
-    ASSERT_EQUAL_FLOAT_OR_FAIL(sol->x[1], -0.058098186140208, 1e-10, str, "x[1] wrong");
-    ASSERT_EQUAL_FLOAT_OR_FAIL(sol->x[2], 0.463417930928291, 1e-10, str, "x[2] wrong");
+    ASSERT_EQUAL_FLOAT_OR_FAIL(sol->x[0], 0.274057420504456, CACHE_TOL(1e-10), str, "x[0] wrong");
+    ASSERT_EQUAL_FLOAT_OR_FAIL(sol->x[1], -0.058098186140208, CACHE_TOL(1e-10), str, "x[1] wrong");
+    ASSERT_EQUAL_FLOAT_OR_FAIL(sol->x[2], 0.463417930928291, CACHE_TOL(1e-10), str, "x[2] wrong");
     for (i = 0; i < 4; ++i) {
         ASSERT_TRUE_OR_FAIL(isnan(sol->y[i]), str, "y should be nan");
     }
-    ASSERT_EQUAL_FLOAT_OR_FAIL(sol->s[0], -0.191928792495329, 1e-10, str, "s[0] wrong");
-    ASSERT_EQUAL_FLOAT_OR_FAIL(sol->s[1], -0.047508022860835, 1e-10, str, "s[1] wrong");
-    ASSERT_EQUAL_FLOAT_OR_FAIL(sol->s[2], 0.182152982731530, 1e-10, str, "s[2] wrong");
-    ASSERT_EQUAL_FLOAT_OR_FAIL(sol->s[3], 0.037415772537480, 1e-10, str, "s[3] wrong");
+    ASSERT_EQUAL_FLOAT_OR_FAIL(sol->s[0], -0.191928792495329, CACHE_TOL(1e-10), str, "s[0] wrong");
+    ASSERT_EQUAL_FLOAT_OR_FAIL(sol->s[1], -0.047508022860835, CACHE_TOL(1e-10), str, "s[1] wrong");
+    ASSERT_EQUAL_FLOAT_OR_FAIL(sol->s[2], 0.182152982731530, CACHE_TOL(1e-10), str, "s[2] wrong");
+    ASSERT_EQUAL_FLOAT_OR_FAIL(sol->s[3], 0.037415772537480, CACHE_TOL(1e-10), str, "s[3] wrong");
 
     data->stgs->max_iters = 2;
     status = scs(data, cone, sol, info);
     ASSERT_EQUAL_INT_OR_FAIL(info->iter, data->stgs->max_iters, str, "no iterations");
     ASSERT_EQUAL_INT_OR_FAIL(status, SCS_SOLVED_INACCURATE, str, "wrong status");
-    ASSERT_EQUAL_FLOAT_OR_FAIL(sol->x[0], -0.465406066728364, 1e-10, str, "x[0] wrong");
-    ASSERT_EQUAL_FLOAT_OR_FAIL(sol->x[1], -0.166978364590537, 1e-10, str, "x[1] wrong");
-    ASSERT_EQUAL_FLOAT_OR_FAIL(sol->x[2], 1.116606860418411, 1e-10, str, "x[2] wrong");
-    ASSERT_EQUAL_FLOAT_OR_FAIL(sol->y[0], 7.224785302606174, 1e-10, str, "y[0] wrong");
-    ASSERT_EQUAL_FLOAT_OR_FAIL(sol->s[0], 0.326281791938008, 1e-10, str, "s[0] wrong");
+    ASSERT_EQUAL_FLOAT_OR_FAIL(sol->x[0], -0.465406066728364, CACHE_TOL(1e-10), str, "x[0] wrong");
+    ASSERT_EQUAL_FLOAT_OR_FAIL(sol->x[1], -0.166978364590537, CACHE_TOL(1e-10), str, "x[1] wrong");
+    ASSERT_EQUAL_FLOAT_OR_FAIL(sol->x[2], 1.116606860418411, CACHE_TOL(1e-10), str, "x[2] wrong");
+    ASSERT_EQUAL_FLOAT_OR_FAIL(sol->y[0], 7.224785302606174, CACHE_TOL(1e-10), str, "y[0] wrong");
+    ASSERT_EQUAL_FLOAT_OR_FAIL(sol->s[0], 0.326281791938008, CACHE_TOL(1e-10), str, "s[0] wrong");
 
 
     data->stgs->max_iters = 11;
     status = scs(data, cone, sol, info);
     ASSERT_EQUAL_INT_OR_FAIL(info->iter, data->stgs->max_iters, str, "no iterations");
     ASSERT_EQUAL_INT_OR_FAIL(status, SCS_UNBOUNDED_INACCURATE, str, "wrong status");
-    ASSERT_EQUAL_FLOAT_OR_FAIL(sol->x[0], -1.046552668150064, 1e-10, str, "x[0] wrong");
-    ASSERT_EQUAL_FLOAT_OR_FAIL(sol->x[1], -0.353299417556677, 1e-10, str, "x[1] wrong");
-    ASSERT_EQUAL_FLOAT_OR_FAIL(sol->x[2], 0.220015388987763, 1e-10, str, "x[2] wrong");
+    ASSERT_EQUAL_FLOAT_OR_FAIL(sol->x[0], -1.046552668150064, CACHE_TOL(1e-10), str, "x[0] wrong");
+    ASSERT_EQUAL_FLOAT_OR_FAIL(sol->x[1], -0.353299417556677, CACHE_TOL(1e-10), str, "x[1] wrong");
+    ASSERT_EQUAL_FLOAT_OR_FAIL(sol->x[2], 0.220015388987763, CACHE_TOL(1e-10), str, "x[2] wrong");
     for (i = 0; i < 4; ++i) {
         ASSERT_TRUE_OR_FAIL(isnan(sol->y[i]), str, "y should be nan");
     }
-    ASSERT_EQUAL_FLOAT_OR_FAIL(sol->s[0], 0.380569177488686, 1e-10, str, "s[0] wrong");
-    ASSERT_EQUAL_FLOAT_OR_FAIL(sol->s[1], 0.283386052682735, 1e-10, str, "s[1] wrong");
-    ASSERT_EQUAL_FLOAT_OR_FAIL(sol->s[2], -0.094498466741551, 1e-10, str, "s[2] wrong");
-    ASSERT_EQUAL_FLOAT_OR_FAIL(sol->s[3], -0.235786521630921, 1e-10, str, "s[3] wrong");
+    ASSERT_EQUAL_FLOAT_OR_FAIL(sol->s[0], 0.380569177488686, CACHE_TOL(1e-10), str, "s[0] wrong");
+    ASSERT_EQUAL_FLOAT_OR_FAIL(sol->s[1], 0.283386052682735, CACHE_TOL(1e-10), str, "s[1] wrong");
+    ASSERT_EQUAL_FLOAT_OR_FAIL(sol->s[2], -0.094498466741551, CACHE_TOL(1e-10), str, "s[2] wrong");
+    ASSERT_EQUAL_FLOAT_OR_FAIL(sol->s[3], -0.235786521630921, CACHE_TOL(1e-10), str, "s[3] wrong");
 
     data->stgs->max_iters = 40;
     status = scs(data, cone, sol, info);
     ASSERT_EQUAL_INT_OR_FAIL(info->iter, data->stgs->max_iters, str, "no iterations");
     ASSERT_EQUAL_INT_OR_FAIL(status, SCS_SOLVED_INACCURATE, str, "wrong status");
-    ASSERT_EQUAL_FLOAT_OR_FAIL(sol->x[0], -18.660744885301725, 1e-10, str, "x[0] wrong");
+    ASSERT_EQUAL_FLOAT_OR_FAIL(sol->x[0], -18.660744885301725, CACHE_TOL(1e-10), str, "x[0] wrong");
 
     /*
      * Here I'm modifying the maximum number of iterations to make sure that  
@@ -521,9 +596,9 @@ bool test_superscs_100_rbroyden(char** str) {
     status = scs(data, cone, sol, info);
 
     ASSERT_EQUAL_INT_OR_FAIL(status, SCS_SOLVED_INACCURATE, str, "wrong status");
-    ASSERT_EQUAL_FLOAT_OR_FAIL(sol->x[0], -0.349018320302040, 1e-10, str, "x[0] wrong");
-    ASSERT_EQUAL_FLOAT_OR_FAIL(sol->x[1], 0.015102755569314, 1e-10, str, "x[1] wrong");
-    ASSERT_EQUAL_FLOAT_OR_FAIL(sol->x[2], 1.778110351429428, 1e-10, str, "x[2] wrong");
+    ASSERT_EQUAL_FLOAT_OR_FAIL(sol->x[0], -0.349018320302040, CACHE_TOL(1e-10), str, "x[0] wrong");
+    ASSERT_EQUAL_FLOAT_OR_FAIL(sol->x[1], 0.015102755569314, CACHE_TOL(1e-10), str, "x[1] wrong");
+    ASSERT_EQUAL_FLOAT_OR_FAIL(sol->x[2], 1.778110351429428, CACHE_TOL(1e-10), str, "x[2] wrong");
 
     scs_free_data_cone(data, cone);
     scs_free_sol(sol);
@@ -566,9 +641,9 @@ bool test_superscs_011_progress(char** str) {
         ASSERT_EQUAL_INT_OR_FAIL(info->progress_ls[i], ls_exp[i], str, "ls");
     }
     for (i = 0; i < 6; ++i) {
-        ASSERT_EQUAL_FLOAT_OR_FAIL(info->progress_relgap[i], gap_exp[i], 1e-10, str, "gap");
-        ASSERT_EQUAL_FLOAT_OR_FAIL(info->progress_respri[i], pres_exp[i], 1e-10, str, "pres");
-        ASSERT_EQUAL_FLOAT_OR_FAIL(info->progress_resdual[i], dres_exp[i], 1e-10, str, "dres");
+        ASSERT_EQUAL_FLOAT_OR_FAIL(info->progress_relgap[i], gap_exp[i], CACHE_TOL(1e-10), str, "gap");
+        ASSERT_EQUAL_FLOAT_OR_FAIL(info->progress_respri[i], pres_exp[i], CACHE_TOL(1e-10), str, "pres");
+        ASSERT_EQUAL_FLOAT_OR_FAIL(info->progress_resdual[i], dres_exp[i], CACHE_TOL(1e-10), str, "dres");
     }
 
     scs_free_data_cone(data, cone);
@@ -632,7 +707,7 @@ bool test_residuals(char** str) {
     status = scs(data, cone, sol, info);
     ASSERT_TRUE_OR_FAIL(isnan(info->progress_relgap[0]), str, "rel gap [0] not NAN");
     ASSERT_EQUAL_ARRAY_OR_FAIL(info->progress_relgap + 1, relgap_expected + 1, 
-            11, 1e-13, str, "relative gap is wrong");
+            11, CACHE_TOL(1e-13), str, "relative gap is wrong");
     ASSERT_EQUAL_INT_OR_FAIL(status, SCS_SOLVED, str, "wrong status");
 
     scs_free_data_cone(data, cone);
@@ -964,7 +1039,10 @@ bool test_scale(char** str) {
     ASSERT_EQUAL_INT_OR_FAIL(cone_loaded->psize, cone->psize, str, "Value of `cone->psize` is wrong"); \
     ASSERT_EQUAL_INT_OR_FAIL(cone_loaded->qsize, cone->qsize, str, "Value of `cone->qsize` is wrong"); \
     ASSERT_EQUAL_INT_OR_FAIL(cone_loaded->ssize, cone->ssize, str, "Value of `cone->ssize` is wrong"); \
+    ASSERT_EQUAL_INT_OR_FAIL(cone_loaded->bsize, cone->bsize, str, "Value of `cone->bsize` is wrong"); \
+    ASSERT_EQUAL_INT_OR_FAIL(cone_loaded->rqsize, cone->rqsize, str, "Value of `cone->rqsize` is wrong"); \
     ASSERT_EQUAL_ARRAY_INT_OR_FAIL(cone_loaded->q, cone->q, cone->qsize, str, "Value of `cone->q` is wrong"); \
+    ASSERT_EQUAL_ARRAY_INT_OR_FAIL(cone_loaded->rq, cone->rq, cone->rqsize, str, "Value of `cone->rq` is wrong"); \
     ASSERT_EQUAL_ARRAY_INT_OR_FAIL(cone_loaded->s, cone->s, cone->ssize, str, "Value of `cone->s` is wrong"); \
     ASSERT_EQUAL_ARRAY_OR_FAIL(cone_loaded->p, cone->p, cone->psize, 1e-16, str, "Value of `cone->p` is wrong");
 
@@ -1523,3 +1601,1433 @@ bool test_overtime_stop_scs(char **str) {
     scs_free_sol(sol);
     SUCCEED(str);
 }
+
+/*
+ * MAXCUT-type SDP whose sparsity pattern is an arrow of 4 dense 10x10 blocks
+ * linked through the last vertex
+ * 
+ *  minimize    sum_{(i,j) in E} c_ij X_ij
+ *  subject to  X_ii = 1, X >= 0
+ */
+static void prepare_arrow_sdp(ScsData ** data, ScsCone ** cone) {
+    const scs_int N = 41;
+    const scs_int block = 10;
+    const scs_float sqrt2 = SQRTF(2.0);
+    scs_int i, j, e = 0;
+    scs_int m = (N * (N + 1)) / 2;
+    scs_int n = 4 * (block * (block - 1)) / 2 + (N - 1);
+    ScsAMatrix * A;
+
+    *data = scs_init_data();
+    (*data)->m = m;
+    (*data)->n = n;
+    (*data)->b = calloc(m, sizeof (scs_float));
+    (*data)->c = malloc(n * sizeof (scs_float));
+    A = malloc(sizeof (ScsAMatrix));
+    A->m = m;
+    A->n = n;
+    A->p = malloc((n + 1) * sizeof (scs_int));
+    A->i = malloc(n * sizeof (scs_int));
+    A->x = malloc(n * sizeof (scs_float));
+
+    for (j = 0; j < N; ++j) {
+        (*data)->b[j * N - (j * (j - 1)) / 2] = 1.0;
+        for (i = j + 1; i < N; ++i) {
+            if (i == N - 1 || i / block == j / block) {
+                A->p[e] = e;
+                A->i[e] = j * N - (j * (j - 1)) / 2 + i - j;
+                A->x[e] = -sqrt2;
+                (*data)->c[e] = sin((scs_float) e + 1.0);
+                e++;
+            }
+        }
+    }
+    A->p[n] = n;
+    (*data)->A = A;
+
+    *cone = calloc(1, sizeof (ScsCone));
+    (*cone)->ssize = 1;
+    (*cone)->s = malloc(sizeof (scs_int));
+    (*cone)->s[0] = N;
+}
+
+extern ScsWork * scs_init(const ScsData *d, const ScsCone *k, ScsInfo * info);
+extern scs_int scs_solve(ScsWork *w, const ScsData *d, const ScsCone *k, ScsSolution *sol, ScsInfo *info);
+extern scs_int superscs_solve(ScsWork *w, const ScsData *d, const ScsCone *k, ScsSolution *sol, ScsInfo *info);
+extern void scs_finish(ScsWork * w);
+
+bool test_chordal_decomposition(char **str) {
+    ScsData * data = SCS_NULL;
+    ScsCone * cone = SCS_NULL;
+    ScsInfo * info = scs_init_info();
+    ScsSolution * sol = scs_init_sol();
+    ScsChordal * chordal;
+    ScsConeWork * cone_work;
+    ScsWork * work;
+    scs_float pobj_ref, * proj;
+    scs_int status, k;
+
+    prepare_arrow_sdp(&data, &cone);
+    data->stgs->eps = 1e-7;
+    data->stgs->verbose = 0;
+
+    /* the cliques are the 4 blocks together with the last vertex */
+    data->stgs->chordal_decomposition = 1;
+    chordal = scs_chordal_init(data, cone);
+    ASSERT_TRUE_OR_FAIL(chordal != SCS_NULL, str, "cone not decomposed");
+    ASSERT_EQUAL_INT_OR_FAIL(chordal->cone->ssize, 4, str, "wrong number of cliques");
+    for (k = 0; k < 4; ++k) {
+        ASSERT_EQUAL_INT_OR_FAIL(chordal->cone->s[k], 11, str, "wrong clique size");
+    }
+    ASSERT_EQUAL_INT_OR_FAIL(chordal->cone->f, 4 * 66 - 3, str, "wrong number of equalities");
+    ASSERT_EQUAL_INT_OR_FAIL(chordal->data->n, data->n + 4 * 66, str, "wrong n");
+    ASSERT_EQUAL_INT_OR_FAIL(chordal->data->m, 4 * 66 - 3 + 4 * 66, str, "wrong m");
+    scs_chordal_free(chordal);
+
+    data->stgs->chordal_decomposition = 0;
+    status = scs(data, cone, sol, info);
+    ASSERT_EQUAL_INT_OR_FAIL(status, SCS_SOLVED, str, "problem not solved");
+    pobj_ref = info->pobj;
+
+    data->stgs->chordal_decomposition = 1;
+    status = scs(data, cone, sol, info);
+    ASSERT_EQUAL_INT_OR_FAIL(status, SCS_SOLVED, str, "decomposed problem not solved");
+    ASSERT_EQUAL_FLOAT_OR_FAIL(info->pobj, pobj_ref, 1e-4 * (1 + ABS(pobj_ref)), str, "wrong objective");
+    ASSERT_EQUAL_FLOAT_OR_FAIL(-scs_inner_product(data->b, sol->y, data->m), pobj_ref,
+            1e-4 * (1 + ABS(pobj_ref)), str, "wrong dual objective");
+
+    /* the recovered s and y are positive semidefinite */
+    cone_work = scs_init_conework(cone);
+    proj = malloc(data->m * sizeof (scs_float));
+    memcpy(proj, sol->s, data->m * sizeof (scs_float));
+    scs_project_dual_cone(proj, cone, cone_work, SCS_NULL, -1);
+    ASSERT_TRUE_OR_FAIL(scs_norm_difference(proj, sol->s, data->m) < 1e-6, str, "s not PSD");
+    memcpy(proj, sol->y, data->m * sizeof (scs_float));
+    scs_project_dual_cone(proj, cone, cone_work, SCS_NULL, -1);
+    ASSERT_TRUE_OR_FAIL(scs_norm_difference(proj, sol->y, data->m) < 1e-6, str, "y not PSD");
+
+    /* re-solve with the same workspace and a new b (within the pattern) */
+    work = scs_init(data, cone, info);
+    ASSERT_TRUE_OR_FAIL(work != SCS_NULL && work->chordal != SCS_NULL, str, "cone not decomposed");
+    scs_scale_array(data->b, 2.0, data->m);
+    status = superscs_solve(work, data, cone, sol, info);
+    ASSERT_EQUAL_INT_OR_FAIL(status, SCS_SOLVED, str, "problem not re-solved");
+    ASSERT_EQUAL_FLOAT_OR_FAIL(info->pobj, 2 * pobj_ref, 1e-4 * (1 + ABS(pobj_ref)), str, "wrong objective (re-solve)");
+
+    /* entry (10, 0) is outside the pattern, so b may not become nonzero there */
+    ASSERT_EQUAL_INT_OR_FAIL(work->chordal->row_map[10], -1, str, "row not dropped");
+    data->b[10] = 0.5;
+    status = superscs_solve(work, data, cone, sol, info);
+    ASSERT_EQUAL_INT_OR_FAIL(status, SCS_FAILED, str, "b outside the pattern accepted");
+    ASSERT_EQUAL_INT_OR_FAIL(info->statusVal, SCS_FAILED, str, "wrong status");
+    scs_finish(work);
+
+    data->stgs->do_super_scs = 0;
+    data->b[10] = 0.0;
+    work = scs_init(data, cone, info);
+    ASSERT_TRUE_OR_FAIL(work != SCS_NULL && work->chordal != SCS_NULL, str, "cone not decomposed");
+    data->b[10] = 0.5;
+    status = scs_solve(work, data, cone, sol, info);
+    ASSERT_EQUAL_INT_OR_FAIL(status, SCS_FAILED, str, "b outside the pattern accepted (SCS)");
+    scs_finish(work);
+
+    free(proj);
+    scs_finish_cone(cone_work);
+    scs_free_data_cone(data, cone);
+    scs_free_info(info);
+    scs_free_sol(sol);
+    SUCCEED(str);
+}
+
+bool test_chordal_large_sparse_cone(char **str) {
+    /* a tridiagonal pattern: the analysis does not need O(N^2) workspace */
+    const scs_int N = 1000;
+    ScsData * data = scs_init_data();
+    ScsCone * cone = calloc(1, sizeof (ScsCone));
+    ScsChordal * chordal;
+    ScsChordalBlock * block;
+    ScsAMatrix * A;
+    scs_int i, j, k, c, covered;
+
+    data->m = (N * (N + 1)) / 2;
+    data->n = N - 1;
+    data->b = calloc(data->m, sizeof (scs_float));
+    data->c = malloc(data->n * sizeof (scs_float));
+    A = malloc(sizeof (ScsAMatrix));
+    A->m = data->m;
+    A->n = data->n;
+    A->p = malloc((data->n + 1) * sizeof (scs_int));
+    A->i = malloc(data->n * sizeof (scs_int));
+    A->x = malloc(data->n * sizeof (scs_float));
+    for (j = 0; j < N; ++j) {
+        data->b[j * N - (j * (j - 1)) / 2] = 1.0;
+    }
+    for (j = 0; j < N - 1; ++j) {
+        A->p[j] = j;
+        A->i[j] = j * N - (j * (j - 1)) / 2 + 1;
+        A->x[j] = -sqrt(2.0);
+        data->c[j] = 1.0;
+    }
+    A->p[data->n] = data->n;
+    data->A = A;
+    cone->ssize = 1;
+    cone->s = malloc(sizeof (scs_int));
+    cone->s[0] = N;
+
+    chordal = scs_chordal_init(data, cone);
+    ASSERT_TRUE_OR_FAIL(chordal != SCS_NULL, str, "cone not decomposed");
+    ASSERT_EQUAL_INT_OR_FAIL(chordal->num_blocks, 1, str, "wrong number of blocks");
+    block = &chordal->blocks[0];
+    ASSERT_TRUE_OR_FAIL(block->num_cliques > 1, str, "no cliques");
+    for (k = 0; k < block->num_cliques; ++k) {
+        c = block->clique_ptr[k + 1] - block->clique_ptr[k];
+        /* the cliques of the path are merged only as long as the fill-in is small */
+        ASSERT_TRUE_OR_FAIL(c <= 100, str, "clique too large");
+        for (i = block->clique_ptr[k] + 1; i < block->clique_ptr[k + 1]; ++i) {
+            ASSERT_TRUE_OR_FAIL(block->clique_vertices[i - 1] < block->clique_vertices[i],
+                    str, "clique not sorted");
+        }
+    }
+    /* every edge (i + 1, i) is in a clique */
+    for (i = 0; i < N - 1; ++i) {
+        covered = 0;
+        for (k = 0; k < block->num_cliques && !covered; ++k) {
+            scs_int has_i = 0, has_next = 0;
+            for (j = block->clique_ptr[k]; j < block->clique_ptr[k + 1]; ++j) {
+                has_i |= block->clique_vertices[j] == i;
+                has_next |= block->clique_vertices[j] == i + 1;
+            }
+            covered = has_i && has_next;
+        }
+        ASSERT_TRUE_OR_FAIL(covered, str, "edge not covered by a clique");
+    }
+    scs_chordal_free(chordal);
+
+    scs_free_data_cone(data, cone);
+    SUCCEED(str);
+}
+
+bool test_exp_cone_projection(char **str) {
+    const scs_int ncones = 200;
+    ScsCone * cone = scs_calloc(1, sizeof (ScsCone));
+    ScsConeWork * cone_work;
+    scs_float * x, * proj, * proj_ws, r, s, t, u, v, w;
+    scs_int i, iter;
+
+    cone->ed = ncones;
+    cone_work = scs_init_conework(cone);
+    x = malloc(3 * ncones * sizeof (scs_float));
+    proj = malloc(3 * ncones * sizeof (scs_float));
+    proj_ws = malloc(3 * ncones * sizeof (scs_float));
+    for (i = 0; i < 3 * ncones; ++i) {
+        x[i] = 5.0 * sin(1.0 + 7.0 * i + 0.1 * i * i);
+    }
+
+    memcpy(proj, x, 3 * ncones * sizeof (scs_float));
+    scs_project_dual_cone(proj, cone, cone_work, SCS_NULL, -1);
+    for (i = 0; i < ncones; ++i) {
+        /* the projection is in the exponential cone */
+        r = proj[3 * i];
+        s = proj[3 * i + 1];
+        t = proj[3 * i + 2];
+        ASSERT_TRUE_OR_FAIL(s >= 0 && t >= 0, str, "projection not in cone");
+        if (s > 1e-8) {
+            ASSERT_TRUE_OR_FAIL(s * exp(r / s) <= t + 1e-6, str, "projection not in cone");
+        }
+        /* the residual is in the dual cone and is orthogonal to the projection */
+        u = r - x[3 * i];
+        v = s - x[3 * i + 1];
+        w = t - x[3 * i + 2];
+        ASSERT_TRUE_OR_FAIL(u <= 1e-8, str, "residual not in dual cone");
+        if (u < -1e-8) {
+            /* exp(v / u) amplifies errors near the boundary, hence the relative tolerance */
+            ASSERT_TRUE_OR_FAIL(-u * exp(v / u) <= exp(1) * w * (1 + 1e-2) + 1e-6, str, "residual not in dual cone");
+        }
+        ASSERT_EQUAL_FLOAT_OR_FAIL(r * u + s * v + t * w, 0.0, 1e-6, str, "not orthogonal");
+    }
+
+    /* warm-started projections of nearby points */
+    for (i = 0; i < 3 * ncones; ++i) {
+        x[i] += 1e-3 * cos(3.0 * i);
+    }
+    memcpy(proj_ws, x, 3 * ncones * sizeof (scs_float));
+    scs_project_dual_cone(proj_ws, cone, cone_work, SCS_NULL, -1);
+    scs_finish_cone(cone_work);
+    cone_work = scs_init_conework(cone);
+    memcpy(proj, x, 3 * ncones * sizeof (scs_float));
+    scs_project_dual_cone(proj, cone, cone_work, SCS_NULL, -1);
+    ASSERT_TRUE_OR_FAIL(scs_norm_difference(proj, proj_ws, 3 * ncones) < 1e-6,
+            str, "warm start changes the projection");
+
+    /*
+     * inexact projections (large tolerance): the dual variable which is kept
+     * to warm-start the next projection is the one of the projection, i.e.,
+     * r_proj = r - rho, even when the bracket of rho is already narrower than
+     * the tolerance
+     */
+    for (iter = 0; iter < 3; ++iter) {
+        scs_finish_cone(cone_work);
+        cone_work = scs_init_conework(cone);
+        memcpy(proj, x, 3 * ncones * sizeof (scs_float));
+        scs_project_dual_cone(proj, cone, cone_work, SCS_NULL, iter);
+        for (i = 0; i < ncones; ++i) {
+            if (cone_work->exp_rho[i] > 0) {
+                ASSERT_EQUAL_FLOAT_OR_FAIL(proj[3 * i], x[3 * i] - cone_work->exp_rho[i],
+                        1e-12, str, "dual variable does not match the projection");
+            }
+        }
+    }
+
+    free(x);
+    free(proj);
+    free(proj_ws);
+    scs_finish_cone(cone_work);
+    scs_free(cone);
+    SUCCEED(str);
+}
+
+bool test_power_cone_projection(char **str) {
+    const scs_int ncones = 100;
+    ScsCone * cone = scs_calloc(1, sizeof (ScsCone));
+    ScsConeWork * cone_work;
+    scs_float * x, * proj, * proj_ws, a, px, py, pr, u, v, w;
+    scs_int i, iters_warm, iters_cold;
+
+    /* power cones K_a (given by -a) followed by their duals (given by a) */
+    cone->psize = 2 * ncones;
+    cone->p = malloc(cone->psize * sizeof (scs_float));
+    for (i = 0; i < ncones; ++i) {
+        cone->p[i] = -(0.05 + 0.9 * i / ncones);
+        cone->p[ncones + i] = -cone->p[i];
+    }
+    cone_work = scs_init_conework(cone);
+    x = malloc(3 * cone->psize * sizeof (scs_float));
+    proj = malloc(3 * cone->psize * sizeof (scs_float));
+    for (i = 0; i < 3 * ncones; ++i) {
+        x[i] = 3.0 * sin(2.0 + 5.0 * i + 0.3 * i * i);
+        x[3 * ncones + i] = -x[i];
+    }
+
+    memcpy(proj, x, 3 * cone->psize * sizeof (scs_float));
+    scs_project_dual_cone(proj, cone, cone_work, SCS_NULL, -1);
+    for (i = 0; i < ncones; ++i) {
+        a = -cone->p[i];
+        px = proj[3 * i];
+        py = proj[3 * i + 1];
+        pr = proj[3 * i + 2];
+        ASSERT_TRUE_OR_FAIL(px >= 0 && py >= 0, str, "projection not in cone");
+        ASSERT_TRUE_OR_FAIL(POWF(px, a) * POWF(py, 1 - a) >= ABS(pr) - 1e-6,
+                str, "projection not in cone");
+        u = px - x[3 * i];
+        v = py - x[3 * i + 1];
+        w = pr - x[3 * i + 2];
+        ASSERT_EQUAL_FLOAT_OR_FAIL(px * u + py * v + pr * w, 0.0, 1e-6, str, "not orthogonal");
+        /* Moreau: the projection of -x onto the dual cone is the projection of x minus x */
+        ASSERT_EQUAL_FLOAT_OR_FAIL(proj[3 * (ncones + i)], u, 1e-9, str, "Moreau decomposition");
+        ASSERT_EQUAL_FLOAT_OR_FAIL(proj[3 * (ncones + i) + 1], v, 1e-9, str, "Moreau decomposition");
+        ASSERT_EQUAL_FLOAT_OR_FAIL(proj[3 * (ncones + i) + 2], w, 1e-9, str, "Moreau decomposition");
+    }
+
+    /* warm-started projections of nearby points need fewer Newton iterations */
+    for (i = 0; i < 3 * cone->psize; ++i) {
+        x[i] += 1e-3 * cos(3.0 * i);
+    }
+    proj_ws = malloc(3 * cone->psize * sizeof (scs_float));
+    memcpy(proj_ws, x, 3 * cone->psize * sizeof (scs_float));
+    cone_work->pow_newton_iters = 0;
+    scs_project_dual_cone(proj_ws, cone, cone_work, SCS_NULL, -1);
+    iters_warm = cone_work->pow_newton_iters;
+    scs_finish_cone(cone_work);
+    cone_work = scs_init_conework(cone);
+    memcpy(proj, x, 3 * cone->psize * sizeof (scs_float));
+    scs_project_dual_cone(proj, cone, cone_work, SCS_NULL, -1);
+    iters_cold = cone_work->pow_newton_iters;
+    ASSERT_TRUE_OR_FAIL(scs_norm_difference(proj, proj_ws, 3 * cone->psize) < 1e-6,
+            str, "warm start changes the projection");
+    ASSERT_TRUE_OR_FAIL(iters_warm < iters_cold, str, "warm start does not save iterations");
+
+    free(x);
+    free(proj);
+    free(proj_ws);
+    scs_finish_cone(cone_work);
+    free(cone->p);
+    scs_free(cone);
+    SUCCEED(str);
+}
+
+bool test_cone_projection_early_iterations(char **str) {
+    const scs_int ncones = 50, nbox = 20;
+    ScsCone * cone = scs_calloc(1, sizeof (ScsCone));
+    ScsConeWork * cone_work;
+    scs_float * x, * proj_exact, * proj, err;
+    scs_int i, iter, len;
+
+    /* dual exponential cones, power cones and a box cone */
+    cone->ed = ncones;
+    cone->psize = ncones;
+    cone->p = malloc(cone->psize * sizeof (scs_float));
+    for (i = 0; i < ncones; ++i) {
+        cone->p[i] = 0.1 + 0.8 * i / ncones;
+    }
+    cone->bsize = nbox + 1;
+    cone->bl = malloc(nbox * sizeof (scs_float));
+    cone->bu = malloc(nbox * sizeof (scs_float));
+    for (i = 0; i < nbox; ++i) {
+        cone->bl[i] = -1.0 - 0.1 * i;
+        cone->bu[i] = 0.5 + 0.2 * i;
+    }
+    len = 3 * (cone->ed + cone->psize) + cone->bsize;
+    x = malloc(len * sizeof (scs_float));
+    proj_exact = malloc(len * sizeof (scs_float));
+    proj = malloc(len * sizeof (scs_float));
+    for (i = 0; i < len; ++i) {
+        x[i] = 5.0 * sin(2.0 + 3.0 * i + 0.1 * i * i);
+    }
+
+    cone_work = scs_init_conework(cone);
+    memcpy(proj_exact, x, len * sizeof (scs_float));
+    scs_project_dual_cone(proj_exact, cone, cone_work, SCS_NULL, -1);
+    scs_finish_cone(cone_work);
+
+    /* the first iterations project inexactly, but not arbitrarily so */
+    for (iter = 0; iter < 3; ++iter) {
+        cone_work = scs_init_conework(cone);
+        memcpy(proj, x, len * sizeof (scs_float));
+        scs_project_dual_cone(proj, cone, cone_work, SCS_NULL, iter);
+        scs_finish_cone(cone_work);
+        for (i = 0; i < len; ++i) {
+            err = ABS(proj[i] - proj_exact[i]);
+            ASSERT_TRUE_OR_FAIL(err <= 5e-2, str, "inexact projection too far from the exact one");
+        }
+    }
+
+    free(x);
+    free(proj_exact);
+    free(proj);
+    free(cone->p);
+    free(cone->bl);
+    free(cone->bu);
+    scs_free(cone);
+    SUCCEED(str);
+}
+
+bool test_cone_projection_batch(char **str) {
+    const scs_int ncones = 30;
+    /* points inside the cone, inside the polar, and projected iteratively */
+    const scs_float exp_v[3][3] = {{0.5, 1.0, 3.0}, {1.0, 0.5, -2.0}, {1.0, 1.0, 0.0}};
+    const scs_float pow_v[3][3] = {{1.0, 2.0, 0.5}, {-1.0, -2.0, 0.5}, {1.0, 1.0, 3.0}};
+    ScsCone * cone = scs_calloc(1, sizeof (ScsCone));
+    ScsCone * single = scs_calloc(1, sizeof (ScsCone));
+    ScsConeWork * cone_work, * single_work;
+    scs_float * x, * proj, * proj_single, * v, scale, sgn;
+    scs_int i, j, len, n_iter = 0;
+
+    /* primal and dual exponential cones, primal and dual power cones */
+    cone->ep = ncones;
+    cone->ed = ncones;
+    cone->psize = 2 * ncones;
+    cone->p = malloc(cone->psize * sizeof (scs_float));
+    len = 3 * (cone->ep + cone->ed + cone->psize);
+    x = malloc(len * sizeof (scs_float));
+    proj = malloc(len * sizeof (scs_float));
+    proj_single = malloc(len * sizeof (scs_float));
+
+    /* the cones are projected onto directly, or via Moreau (given -v) */
+    for (i = 0; i < 2 * ncones; ++i) {
+        scale = 0.5 + 0.25 * i;
+        sgn = i < ncones ? -1.0 : 1.0;
+        for (j = 0; j < 3; ++j) {
+            x[3 * i + j] = sgn * scale * exp_v[i % 3][j];
+        }
+        if (i % 3 == 2) {
+            x[3 * i + 2] = sgn * scale * sin(i);
+            n_iter++;
+        }
+    }
+    v = x + 6 * ncones;
+    for (i = 0; i < 2 * ncones; ++i) {
+        scale = 0.5 + 0.25 * i;
+        sgn = i < ncones ? 1.0 : -1.0;
+        cone->p[i] = -sgn * (0.05 + 0.9 * (i % ncones) / ncones);
+        for (j = 0; j < 3; ++j) {
+            v[3 * i + j] = sgn * scale * pow_v[i % 3][j];
+        }
+        if (i % 3 == 2) {
+            v[3 * i + 2] = sgn * scale * (3.0 + sin(i));
+        }
+    }
+
+    cone_work = scs_init_conework(cone);
+    memcpy(proj, x, len * sizeof (scs_float));
+    scs_project_dual_cone(proj, cone, cone_work, SCS_NULL, -1);
+    ASSERT_EQUAL_INT_OR_FAIL(cone_work->exp_iterative, n_iter, str, "wrong number of iterative projections (exp)");
+    ASSERT_EQUAL_INT_OR_FAIL(cone_work->pow_iterative, n_iter, str, "wrong number of iterative projections (pow)");
+    scs_finish_cone(cone_work);
+
+    /* project onto every cone on its own */
+    for (i = 0; i < 2 * ncones; ++i) {
+        memset(single, 0, sizeof (ScsCone));
+        if (i < ncones) {
+            single->ep = 1;
+        } else {
+            single->ed = 1;
+        }
+        single_work = scs_init_conework(single);
+        memcpy(proj_single + 3 * i, x + 3 * i, 3 * sizeof (scs_float));
+        scs_project_dual_cone(proj_single + 3 * i, single, single_work, SCS_NULL, -1);
+        scs_finish_cone(single_work);
+    }
+    for (i = 0; i < 2 * ncones; ++i) {
+        memset(single, 0, sizeof (ScsCone));
+        single->psize = 1;
+        single->p = &(cone->p[i]);
+        single_work = scs_init_conework(single);
+        memcpy(proj_single + 6 * ncones + 3 * i, v + 3 * i, 3 * sizeof (scs_float));
+        scs_project_dual_cone(proj_single + 6 * ncones + 3 * i, single, single_work, SCS_NULL, -1);
+        scs_finish_cone(single_work);
+    }
+    ASSERT_EQUAL_ARRAY_OR_FAIL(proj, proj_single, len, 1e-14, str, "batch and single-cone projections differ");
+
+    free(x);
+    free(proj);
+    free(proj_single);
+    free(cone->p);
+    scs_free(cone);
+    scs_free(single);
+    SUCCEED(str);
+}
+
+bool test_inexact_cone_projections(char **str) {
+    const char * filepaths[2] = {"tests/c/data/test-4.yml", "tests/c/data/test-5.yml"};
+    ScsData * data = SCS_NULL;
+    ScsCone * cone = SCS_NULL;
+    ScsInfo * info;
+    ScsSolution * sol;
+    scs_float pobj_exact;
+    scs_int status, j;
+
+    for (j = 0; j < 2; ++j) {
+        info = scs_init_info();
+        sol = scs_init_sol();
+        status = scs_from_YAML(filepaths[j], &data, &cone);
+        ASSERT_EQUAL_INT_OR_FAIL(status, 0, str, "status is not 0");
+
+        data->stgs->do_super_scs = 1;
+        data->stgs->direction = anderson_acceleration;
+        data->stgs->memory = 5;
+        data->stgs->eps = 1e-6;
+        data->stgs->verbose = 0;
+        data->stgs->do_override_streams = 1;
+        data->stgs->output_stream = stderr;
+
+        status = scs(data, cone, sol, info);
+        ASSERT_EQUAL_INT_OR_FAIL(status, SCS_SOLVED, str, "Problem not solved");
+        pobj_exact = info->pobj;
+
+        /* projections with a tolerance that goes down like (1/iter)^2 */
+        data->stgs->inexact_cone_projections = 1;
+        status = scs(data, cone, sol, info);
+        ASSERT_EQUAL_INT_OR_FAIL(status, SCS_SOLVED, str, "Problem not solved (inexact)");
+        ASSERT_EQUAL_FLOAT_OR_FAIL(info->pobj, pobj_exact, 1e-4 * (1 + ABS(pobj_exact)),
+                str, "wrong objective (inexact)");
+
+        scs_free_data_cone(data, cone);
+        scs_free_info(info);
+        scs_free_sol(sol);
+    }
+
+    SUCCEED(str);
+}
+
+/*
+ * Bounded LP
+ * 
+ *  minimize    c'x
+ *  subject to  sum(x) = 1, bl <= x <= bu
+ * 
+ * formulated either with a box cone (box = true) or with linear inequalities,
+ * in which case only the finite bounds give rise to constraints
+ */
+static void prepare_bounded_lp(ScsData ** data, ScsCone ** cone, bool box) {
+    const scs_int n = 5;
+    const scs_float c[5] = {1.0, -1.0, 2.0, -3.0, 0.5};
+    const scs_float bl[5] = {-1.0, -1.0, -1.0, -1.0, -1.0};
+    const scs_float bu[5] = {2.0, 2.0, 2.0, 2.0, INFINITY};
+    const scs_int nfinite = 4; /* bu[4] is infinite */
+    scs_int m = box ? 1 + (n + 1) : 1 + n + nfinite;
+    scs_int nnz = box ? 2 * n : 2 * n + nfinite;
+    scs_int j, e = 0;
+    ScsAMatrix * A;
+
+    *data = scs_init_data();
+    (*data)->m = m;
+    (*data)->n = n;
+    (*data)->b = calloc(m, sizeof (scs_float));
+    (*data)->c = malloc(n * sizeof (scs_float));
+    memcpy((*data)->c, c, n * sizeof (scs_float));
+    A = malloc(sizeof (ScsAMatrix));
+    A->m = m;
+    A->n = n;
+    A->p = malloc((n + 1) * sizeof (scs_int));
+    A->i = malloc(nnz * sizeof (scs_int));
+    A->x = malloc(nnz * sizeof (scs_float));
+
+    (*data)->b[0] = 1.0;
+    if (box) {
+        (*data)->b[1] = 1.0; /* t = 1 */
+    } else {
+        for (j = 0; j < n; ++j) (*data)->b[1 + j] = -bl[j];
+        for (j = 0; j < nfinite; ++j) (*data)->b[1 + n + j] = bu[j];
+    }
+    for (j = 0; j < n; ++j) {
+        A->p[j] = e;
+        A->i[e] = 0;
+        A->x[e++] = 1.0;
+        if (box) {
+            A->i[e] = 2 + j;
+            A->x[e++] = -1.0;
+        } else {
+            A->i[e] = 1 + j;
+            A->x[e++] = -1.0;
+            if (j < nfinite) {
+                A->i[e] = 1 + n + j;
+                A->x[e++] = 1.0;
+            }
+        }
+    }
+    A->p[n] = e;
+    (*data)->A = A;
+
+    *cone = calloc(1, sizeof (ScsCone));
+    (*cone)->f = 1;
+    if (box) {
+        (*cone)->bsize = n + 1;
+        (*cone)->bl = malloc(n * sizeof (scs_float));
+        (*cone)->bu = malloc(n * sizeof (scs_float));
+        memcpy((*cone)->bl, bl, n * sizeof (scs_float));
+        memcpy((*cone)->bu, bu, n * sizeof (scs_float));
+    } else {
+        (*cone)->l = n + nfinite;
+    }
+}
+
+bool test_box_cone(char **str) {
+    const char * filepath = "tests/c/data/temp-unit-testing.yml";
+    const scs_float x_expected[5] = {-1.0, 2.0, -1.0, 2.0, -1.0};
+    ScsData * data = SCS_NULL;
+    ScsData * data_lp = SCS_NULL;
+    ScsData * data_loaded = SCS_NULL;
+    ScsCone * cone = SCS_NULL;
+    ScsCone * cone_lp = SCS_NULL;
+    ScsCone * cone_loaded = SCS_NULL;
+    ScsInfo * info = scs_init_info();
+    ScsInfo * info_lp = scs_init_info();
+    ScsSolution * sol = scs_init_sol();
+    ScsSolution * sol_lp = scs_init_sol();
+    ScsConicProblemMetadata * metadata;
+    scs_int status, j;
+
+    prepare_bounded_lp(&data, &cone, true);
+    prepare_bounded_lp(&data_lp, &cone_lp, false);
+    data->stgs->eps = 1e-8;
+    data->stgs->verbose = 0;
+    data_lp->stgs->eps = 1e-8;
+    data_lp->stgs->verbose = 0;
+
+    status = scs(data_lp, cone_lp, sol_lp, info_lp);
+    ASSERT_EQUAL_INT_OR_FAIL(status, SCS_SOLVED, str, "LP not solved");
+    ASSERT_EQUAL_FLOAT_OR_FAIL(info_lp->pobj, -11.5, 1e-5, str, "wrong LP objective");
+
+    status = scs(data, cone, sol, info);
+    ASSERT_EQUAL_INT_OR_FAIL(status, SCS_SOLVED, str, "box-constrained problem not solved");
+    ASSERT_EQUAL_FLOAT_OR_FAIL(info->pobj, info_lp->pobj, 1e-5, str, "wrong objective");
+    ASSERT_EQUAL_ARRAY_OR_FAIL(sol->x, x_expected, data->n, 1e-4, str, "wrong solution");
+    ASSERT_EQUAL_FLOAT_OR_FAIL(sol->s[1], 1.0, 1e-6, str, "t is not 1");
+
+    /* the box cone survives a round trip through YAML */
+    metadata = scs_init_conic_problem_metadata("box-cone");
+    status = scs_to_YAML(filepath, metadata, data, cone);
+    ASSERT_EQUAL_INT_OR_FAIL(status, 0, str, "Saving failed");
+    status = scs_from_YAML(filepath, &data_loaded, &cone_loaded);
+    ASSERT_EQUAL_INT_OR_FAIL(status, 0, str, "Parsing failed");
+    TEST_CONE_EQUALITY(cone_loaded, cone, str)
+    for (j = 0; j < cone->bsize - 1; ++j) {
+        ASSERT_TRUE_OR_FAIL(cone_loaded->bl[j] == cone->bl[j], str, "wrong `bl`");
+        ASSERT_TRUE_OR_FAIL(cone_loaded->bu[j] == cone->bu[j], str, "wrong `bu`");
+    }
+
+    FILE * file_pointer = fopen(filepath, "w");
+    ASSERT_TRUE_OR_FAIL(file_pointer != NULL, str, "pointer to file was NULL");
+    ASSERT_EQUAL_INT_OR_FAIL(fclose(file_pointer), 0, str, "closing stream failed");
+
+    scs_free(metadata);
+    scs_free_data_cone(data, cone);
+    scs_free_data_cone(data_lp, cone_lp);
+    scs_free_data_cone(data_loaded, cone_loaded);
+    scs_free_info(info);
+    scs_free_info(info_lp);
+    scs_free_sol(sol);
+    scs_free_sol(sol_lp);
+    SUCCEED(str);
+}
+
+bool test_cone_stats(char **str) {
+    ScsData * data = SCS_NULL;
+    ScsCone * cone = SCS_NULL;
+    ScsInfo * info = scs_init_info();
+    ScsSolution * sol = scs_init_sol();
+    scs_float time_sum;
+    scs_int status, nproj;
+
+    /* l = 1, q = [2], s = [2, 3], ep = 1 */
+    status = scs_from_YAML("tests/c/data/test-3.yml", &data, &cone);
+    ASSERT_EQUAL_INT_OR_FAIL(status, 0, str, "parsing failed");
+    data->stgs->verbose = 0;
+    data->stgs->max_iters = 200;
+    scs(data, cone, sol, info);
+
+    nproj = info->cone_lp_projections;
+    ASSERT_TRUE_OR_FAIL(nproj > info->iter, str, "too few projections");
+    ASSERT_EQUAL_INT_OR_FAIL(info->cone_soc_projections, nproj, str, "wrong SOC projections");
+    ASSERT_EQUAL_INT_OR_FAIL(info->cone_psd_projections, 2 * nproj, str, "wrong PSD projections");
+    ASSERT_EQUAL_INT_OR_FAIL(info->cone_exp_projections, nproj, str, "wrong exp projections");
+    ASSERT_EQUAL_INT_OR_FAIL(info->cone_pow_projections, 0, str, "wrong power projections");
+    ASSERT_EQUAL_INT_OR_FAIL(info->cone_box_projections, 0, str, "wrong box projections");
+    /* only the 3x3 block is projected with an eigendecomposition */
+    ASSERT_TRUE_OR_FAIL(info->cone_psd_eigenpairs >= 0
+            && info->cone_psd_eigenpairs <= 3 * nproj, str, "wrong number of eigenpairs");
+    ASSERT_TRUE_OR_FAIL(info->cone_exp_avg_iters >= 0, str, "negative exp iterations");
+    ASSERT_TRUE_OR_FAIL(info->cone_lp_time_ms >= 0 && info->cone_soc_time_ms >= 0
+            && info->cone_psd_time_ms >= 0 && info->cone_exp_time_ms >= 0,
+            str, "negative projection time");
+    time_sum = info->cone_lp_time_ms + info->cone_box_time_ms + info->cone_soc_time_ms
+            + info->cone_psd_time_ms + info->cone_exp_time_ms + info->cone_pow_time_ms;
+    ASSERT_TRUE_OR_FAIL(time_sum <= info->cone_time_ms + 1e-9, str, "inconsistent times");
+    ASSERT_TRUE_OR_FAIL(info->cone_time_ms <= info->solveTime, str, "cone time exceeds solve time");
+    scs_free_data_cone(data, cone);
+    scs_free_info(info);
+    scs_free_sol(sol);
+
+    /* l = 40, q = [2], p = [0.1, 0.2, -0.6, -0.95] */
+    info = scs_init_info();
+    sol = scs_init_sol();
+    status = scs_from_YAML("tests/c/data/test-6.yml", &data, &cone);
+    ASSERT_EQUAL_INT_OR_FAIL(status, 0, str, "parsing failed");
+    data->stgs->verbose = 0;
+    data->stgs->max_iters = 200;
+    scs(data, cone, sol, info);
+
+    nproj = info->cone_lp_projections;
+    ASSERT_EQUAL_INT_OR_FAIL(info->cone_pow_projections, 4 * nproj, str, "wrong power projections");
+    ASSERT_EQUAL_INT_OR_FAIL(info->cone_exp_projections, 0, str, "wrong exp projections");
+    ASSERT_EQUAL_INT_OR_FAIL(info->cone_psd_eigenpairs, 0, str, "wrong number of eigenpairs");
+    ASSERT_TRUE_OR_FAIL(info->cone_pow_avg_iters >= 0
+            && info->cone_pow_avg_iters <= 20, str, "wrong power Newton iterations");
+
+    /* the statistics are kept in the workspace, which is required */
+    ASSERT_EQUAL_INT_OR_FAIL(scs_project_dual_cone(sol->y, cone, SCS_NULL, SCS_NULL, -1), -1,
+            str, "projection without workspace");
+
+    scs_free_data_cone(data, cone);
+    scs_free_info(info);
+    scs_free_sol(sol);
+    SUCCEED(str);
+}
+
+/*
+ * Problem with cone f = 1, l = 1, q = [3, 1, 0, 2], s = [1, 2] whose 
+ * optimal solution is built from a complementary pair (s, y) in K x K*
+ */
+static void prepare_noncanonical_problem(ScsData ** data, ScsCone ** cone) {
+    const scs_int m = 12, n = 3;
+    const scs_float s_opt[12] = {0, 1, 1, 1, 0, 0, 2, 0, 0, 1, 0, 0};
+    const scs_float y_opt[12] = {0.5, 0, 1, -1, 0, 2, 0, 0, 1, 0, 0, 1};
+    const scs_float x_opt[3] = {1.0, -2.0, 0.5};
+    scs_int i, j;
+    ScsAMatrix * A;
+
+    *data = scs_init_data();
+    (*data)->m = m;
+    (*data)->n = n;
+    (*data)->b = malloc(m * sizeof (scs_float));
+    (*data)->c = malloc(n * sizeof (scs_float));
+    A = malloc(sizeof (ScsAMatrix));
+    A->m = m;
+    A->n = n;
+    A->p = malloc((n + 1) * sizeof (scs_int));
+    A->i = malloc(m * n * sizeof (scs_int));
+    A->x = malloc(m * n * sizeof (scs_float));
+    for (j = 0; j < n; ++j) {
+        A->p[j] = j * m;
+        for (i = 0; i < m; ++i) {
+            A->i[j * m + i] = i;
+            A->x[j * m + i] = sin(1.0 + i + m * j);
+        }
+    }
+    A->p[n] = m * n;
+    (*data)->A = A;
+
+    /* b = A x + s and c = -A' y */
+    for (i = 0; i < m; ++i) {
+        (*data)->b[i] = s_opt[i];
+    }
+    for (j = 0; j < n; ++j) {
+        (*data)->c[j] = 0.0;
+        for (i = 0; i < m; ++i) {
+            (*data)->b[i] += A->x[j * m + i] * x_opt[j];
+            (*data)->c[j] -= A->x[j * m + i] * y_opt[i];
+        }
+    }
+
+    *cone = calloc(1, sizeof (ScsCone));
+    (*cone)->f = 1;
+    (*cone)->l = 1;
+    (*cone)->qsize = 4;
+    (*cone)->q = malloc(4 * sizeof (scs_int));
+    (*cone)->q[0] = 3;
+    (*cone)->q[1] = 1;
+    (*cone)->q[2] = 0;
+    (*cone)->q[3] = 2;
+    (*cone)->ssize = 2;
+    (*cone)->s = malloc(2 * sizeof (scs_int));
+    (*cone)->s[0] = 1;
+    (*cone)->s[1] = 2;
+}
+
+bool test_presolve_cones(char **str) {
+    const scs_int perm_expected[12] = {0, 1, 5, 8, 6, 7, 2, 3, 4, 9, 10, 11};
+    ScsData * data = SCS_NULL;
+    ScsCone * cone = SCS_NULL;
+    ScsInfo * info = scs_init_info();
+    ScsInfo * info_presolved = scs_init_info();
+    ScsSolution * sol = scs_init_sol();
+    ScsSolution * sol_presolved = scs_init_sol();
+    ScsPresolve * presolve;
+    scs_int status, i, k;
+
+    prepare_noncanonical_problem(&data, &cone);
+    data->stgs->eps = 1e-8;
+    data->stgs->verbose = 0;
+
+    presolve = scs_presolve_init(data, cone);
+    ASSERT_TRUE_OR_FAIL(presolve != SCS_NULL, str, "cone not presolved");
+    ASSERT_EQUAL_INT_OR_FAIL(presolve->cone->f, 1, str, "wrong f");
+    ASSERT_EQUAL_INT_OR_FAIL(presolve->cone->l, 3, str, "wrong l");
+    ASSERT_EQUAL_INT_OR_FAIL(presolve->cone->qsize, 2, str, "wrong qsize");
+    ASSERT_EQUAL_INT_OR_FAIL(presolve->cone->q[0], 2, str, "SOCs not sorted");
+    ASSERT_EQUAL_INT_OR_FAIL(presolve->cone->q[1], 3, str, "SOCs not sorted");
+    ASSERT_EQUAL_INT_OR_FAIL(presolve->cone->ssize, 1, str, "wrong ssize");
+    ASSERT_EQUAL_INT_OR_FAIL(presolve->cone->s[0], 2, str, "wrong s");
+    ASSERT_EQUAL_ARRAY_INT_OR_FAIL(presolve->row_perm, perm_expected, 12, str, "wrong permutation");
+    for (k = 0; k < presolve->data->A->p[presolve->data->n]; ++k) {
+        i = presolve->data->A->i[k];
+        ASSERT_EQUAL_FLOAT_OR_FAIL(presolve->data->A->x[k],
+                sin(1.0 + presolve->row_perm[i] + 12 * (k / 12)), 1e-14, str, "wrong A");
+        ASSERT_TRUE_OR_FAIL(k % 12 == 0 || presolve->data->A->i[k - 1] < i, str, "rows not sorted");
+    }
+
+    /* the presolve does nothing on canonical cones */
+    ASSERT_TRUE_OR_FAIL(scs_presolve_init(presolve->data, presolve->cone) == SCS_NULL,
+            str, "canonical cone presolved");
+    scs_presolve_free(presolve);
+
+    data->stgs->presolve_cones = 0;
+    status = scs(data, cone, sol, info);
+    ASSERT_EQUAL_INT_OR_FAIL(status, SCS_SOLVED, str, "problem not solved");
+
+    data->stgs->presolve_cones = 1;
+    status = scs(data, cone, sol_presolved, info_presolved);
+    ASSERT_EQUAL_INT_OR_FAIL(status, SCS_SOLVED, str, "presolved problem not solved");
+    ASSERT_EQUAL_FLOAT_OR_FAIL(info_presolved->pobj, info->pobj, 1e-5, str, "wrong objective");
+    ASSERT_EQUAL_ARRAY_OR_FAIL(sol_presolved->x, sol->x, data->n, 1e-4, str, "wrong x");
+    ASSERT_EQUAL_ARRAY_OR_FAIL(sol_presolved->y, sol->y, data->m, 1e-4, str, "wrong y");
+    ASSERT_EQUAL_ARRAY_OR_FAIL(sol_presolved->s, sol->s, data->m, 1e-4, str, "wrong s");
+
+    /* warm start from the solution of the original problem */
+    data->stgs->warm_start = 1;
+    status = scs(data, cone, sol_presolved, info_presolved);
+    ASSERT_EQUAL_INT_OR_FAIL(status, SCS_SOLVED, str, "warm-started problem not solved");
+    ASSERT_TRUE_OR_FAIL(info_presolved->iter < 10, str, "warm start not effective");
+
+    scs_free_data_cone(data, cone);
+    scs_free_info(info);
+    scs_free_info(info_presolved);
+    scs_free_sol(sol);
+    scs_free_sol(sol_presolved);
+    SUCCEED(str);
+}
+
+/*
+ * min t s.t. x1 + x2 = 1 and ||x - a||^2 <= 2t with a = (1, 2), stated with a
+ * rotated second-order cone or with the equivalent second-order cone
+ */
+static void prepare_rotated_soc_problem(ScsData ** data, ScsCone ** cone, bool rotated) {
+    const scs_float sqrt2Inv = 1.0 / SQRTF(2.0);
+    const scs_int m = 5, n = 3, nnz = 6;
+    ScsAMatrix * A;
+
+    *data = scs_init_data();
+    (*data)->m = m;
+    (*data)->n = n;
+    (*data)->b = calloc(m, sizeof (scs_float));
+    (*data)->c = calloc(n, sizeof (scs_float));
+    (*data)->c[2] = 1.0;
+    A = malloc(sizeof (ScsAMatrix));
+    A->m = m;
+    A->n = n;
+    A->p = malloc((n + 1) * sizeof (scs_int));
+    A->i = malloc(nnz * sizeof (scs_int));
+    A->x = malloc(nnz * sizeof (scs_float));
+
+    /* columns x1, x2: rows 0 (equality) and 3, 4 (x - a) */
+    A->p[0] = 0;
+    A->i[0] = 0;
+    A->x[0] = 1.0;
+    A->i[1] = 3;
+    A->x[1] = -1.0;
+    A->p[1] = 2;
+    A->i[2] = 0;
+    A->x[2] = 1.0;
+    A->i[3] = 4;
+    A->x[3] = -1.0;
+    A->p[2] = 4;
+    A->i[4] = 1;
+    A->i[5] = 2;
+    A->p[3] = 6;
+    (*data)->b[0] = 1.0;
+    (*data)->b[3] = -1.0;
+    (*data)->b[4] = -2.0;
+    if (rotated) {
+        /* (u, v) = (t, 1) */
+        A->x[4] = -1.0;
+        A->x[5] = 0.0;
+        (*data)->b[2] = 1.0;
+    } else {
+        /* ((t + 1)/sqrt(2), (t - 1)/sqrt(2)) */
+        A->x[4] = -sqrt2Inv;
+        A->x[5] = -sqrt2Inv;
+        (*data)->b[1] = sqrt2Inv;
+        (*data)->b[2] = -sqrt2Inv;
+    }
+    (*data)->A = A;
+
+    *cone = calloc(1, sizeof (ScsCone));
+    (*cone)->f = 1;
+    if (rotated) {
+        (*cone)->rqsize = 1;
+        (*cone)->rq = malloc(sizeof (scs_int));
+        (*cone)->rq[0] = 4;
+    } else {
+        (*cone)->qsize = 1;
+        (*cone)->q = malloc(sizeof (scs_int));
+        (*cone)->q[0] = 4;
+    }
+}
+
+static bool is_in_rotated_soc(const scs_float * x, scs_int n, scs_float tol) {
+    scs_float nw = scs_norm(&(x[2]), n - 2);
+    return x[0] >= -tol && x[1] >= -tol && 2 * x[0] * x[1] >= nw * nw - tol;
+}
+
+bool test_rotated_soc(char **str) {
+    const scs_float x_expected[3] = {0.0, 1.0, 1.0};
+    scs_float x[9] = {
+        3.0, -1.0, 0.5, 2.0, -1.5, /* generic point */
+        -1.0, -2.0, /* polar cone: projects to 0 */
+        0.5, 0.2 /* within the cone */
+    };
+    scs_float proj[9], diff[9];
+    ScsCone * cone = calloc(1, sizeof (ScsCone));
+    ScsConeWork * cone_work;
+    ScsData * data = SCS_NULL;
+    ScsData * data_soc = SCS_NULL;
+    ScsCone * cone_rq = SCS_NULL;
+    ScsCone * cone_soc = SCS_NULL;
+    ScsInfo * info = scs_init_info();
+    ScsInfo * info_soc = scs_init_info();
+    ScsSolution * sol = scs_init_sol();
+    ScsSolution * sol_soc = scs_init_sol();
+    scs_int status, i, j, offset;
+
+    /* the projection is idempotent and satisfies Moreau's decomposition */
+    cone->rqsize = 3;
+    cone->rq = malloc(3 * sizeof (scs_int));
+    cone->rq[0] = 5;
+    cone->rq[1] = 2;
+    cone->rq[2] = 2;
+    cone_work = scs_init_conework(cone);
+    memcpy(proj, x, 9 * sizeof (scs_float));
+    scs_project_dual_cone(proj, cone, cone_work, SCS_NULL, -1);
+    ASSERT_EQUAL_FLOAT_OR_FAIL(proj[5], 0.0, 1e-14, str, "wrong projection on the polar cone");
+    ASSERT_EQUAL_FLOAT_OR_FAIL(proj[6], 0.0, 1e-14, str, "wrong projection on the polar cone");
+    ASSERT_EQUAL_ARRAY_OR_FAIL(&(proj[7]), &(x[7]), 2, 1e-14, str, "point in the cone moved");
+    offset = 0;
+    for (i = 0; i < cone->rqsize; ++i) {
+        for (j = 0; j < cone->rq[i]; ++j) {
+            diff[offset + j] = proj[offset + j] - x[offset + j];
+        }
+        ASSERT_TRUE_OR_FAIL(is_in_rotated_soc(&(proj[offset]), cone->rq[i], 1e-12),
+                str, "projection not in the cone");
+        ASSERT_TRUE_OR_FAIL(is_in_rotated_soc(&(diff[offset]), cone->rq[i], 1e-12),
+                str, "residual not in the dual cone");
+        ASSERT_EQUAL_FLOAT_OR_FAIL(scs_inner_product(&(proj[offset]), &(diff[offset]), cone->rq[i]),
+                0.0, 1e-12, str, "projection and residual not orthogonal");
+        offset += cone->rq[i];
+    }
+    memcpy(diff, proj, 9 * sizeof (scs_float));
+    scs_project_dual_cone(diff, cone, cone_work, SCS_NULL, -1);
+    ASSERT_EQUAL_ARRAY_OR_FAIL(diff, proj, 9, 1e-12, str, "projection not idempotent");
+    scs_finish_cone(cone_work);
+
+    /* rotated and plain second-order cone formulations agree */
+    prepare_rotated_soc_problem(&data, &cone_rq, true);
+    prepare_rotated_soc_problem(&data_soc, &cone_soc, false);
+    data->stgs->eps = 1e-8;
+    data->stgs->verbose = 0;
+    data_soc->stgs->eps = 1e-8;
+    data_soc->stgs->verbose = 0;
+
+    status = scs(data_soc, cone_soc, sol_soc, info_soc);
+    ASSERT_EQUAL_INT_OR_FAIL(status, SCS_SOLVED, str, "SOC problem not solved");
+    ASSERT_EQUAL_FLOAT_OR_FAIL(info_soc->pobj, 1.0, 1e-5, str, "wrong SOC objective");
+
+    status = scs(data, cone_rq, sol, info);
+    ASSERT_EQUAL_INT_OR_FAIL(status, SCS_SOLVED, str, "rotated SOC problem not solved");
+    ASSERT_EQUAL_FLOAT_OR_FAIL(info->pobj, info_soc->pobj, 1e-5, str, "wrong objective");
+    ASSERT_EQUAL_ARRAY_OR_FAIL(sol->x, x_expected, data->n, 1e-4, str, "wrong solution");
+    ASSERT_EQUAL_INT_OR_FAIL(info->cone_soc_projections > 0, 1, str, "no projections recorded");
+
+    scs_free_cone(cone);
+    scs_free_data_cone(data, cone_rq);
+    scs_free_data_cone(data_soc, cone_soc);
+    scs_free_info(info);
+    scs_free_info(info_soc);
+    scs_free_sol(sol);
+    scs_free_sol(sol_soc);
+    SUCCEED(str);
+}
+
+static void prepare_quadratic_problem(ScsData ** data, ScsCone ** cone) {
+    const scs_int m = 3, n = 2;
+    ScsAMatrix * A, * P;
+
+    /* minimize x1^2 + x1 x2 + x2^2 - 3 x2 s.t. x1 + x2 = 1, x >= 0 */
+    *data = scs_init_data();
+    (*data)->m = m;
+    (*data)->n = n;
+    (*data)->b = calloc(m, sizeof (scs_float));
+    (*data)->c = calloc(n, sizeof (scs_float));
+    (*data)->b[0] = 1.0;
+    (*data)->c[1] = -3.0;
+    A = malloc(sizeof (ScsAMatrix));
+    A->m = m;
+    A->n = n;
+    A->p = malloc((n + 1) * sizeof (scs_int));
+    A->i = malloc(4 * sizeof (scs_int));
+    A->x = malloc(4 * sizeof (scs_float));
+    A->p[0] = 0;
+    A->i[0] = 0;
+    A->x[0] = 1.0;
+    A->i[1] = 1;
+    A->x[1] = -1.0;
+    A->p[1] = 2;
+    A->i[2] = 0;
+    A->x[2] = 1.0;
+    A->i[3] = 2;
+    A->x[3] = -1.0;
+    A->p[2] = 4;
+    (*data)->A = A;
+
+    /* upper triangular part of P = [2 1; 1 2] */
+    P = malloc(sizeof (ScsAMatrix));
+    P->m = n;
+    P->n = n;
+    P->p = malloc((n + 1) * sizeof (scs_int));
+    P->i = malloc(3 * sizeof (scs_int));
+    P->x = malloc(3 * sizeof (scs_float));
+    P->p[0] = 0;
+    P->i[0] = 0;
+    P->x[0] = 2.0;
+    P->p[1] = 1;
+    P->i[1] = 0;
+    P->x[1] = 1.0;
+    P->i[2] = 1;
+    P->x[2] = 2.0;
+    P->p[2] = 3;
+    (*data)->P = P;
+
+    *cone = calloc(1, sizeof (ScsCone));
+    (*cone)->f = 1;
+    (*cone)->l = 2;
+}
+
+bool test_quadratic_cost(char **str) {
+    const scs_float x_expected[2] = {0.0, 1.0};
+    ScsData * data = SCS_NULL;
+    ScsCone * cone = SCS_NULL;
+    ScsInfo * info = scs_init_info();
+    ScsSolution * sol = scs_init_sol();
+    scs_int status, mem;
+
+    prepare_quadratic_problem(&data, &cone);
+    data->stgs->eps = 1e-8;
+    data->stgs->verbose = 0;
+
+    status = scs(data, cone, sol, info);
+    ASSERT_EQUAL_INT_OR_FAIL(status, SCS_SOLVED, str, "QP not solved (SuperSCS)");
+    ASSERT_EQUAL_FLOAT_OR_FAIL(info->pobj, -2.0, 1e-5, str, "wrong primal cost (SuperSCS)");
+    ASSERT_EQUAL_FLOAT_OR_FAIL(info->dobj, -2.0, 1e-5, str, "wrong dual cost (SuperSCS)");
+    ASSERT_EQUAL_ARRAY_OR_FAIL(sol->x, x_expected, data->n, 1e-5, str, "wrong solution (SuperSCS)");
+
+    /* the line search must not assume that the projection is linear */
+    for (mem = 2; mem <= 5; ++mem) {
+        data->stgs->memory = mem;
+        status = scs(data, cone, sol, info);
+        ASSERT_EQUAL_INT_OR_FAIL(status, SCS_SOLVED, str, "QP not solved (memory)");
+        ASSERT_EQUAL_FLOAT_OR_FAIL(info->pobj, -2.0, 1e-5, str, "wrong primal cost (memory)");
+    }
+
+    data->stgs->do_super_scs = 0;
+    data->stgs->max_iters = 10000;
+    status = scs(data, cone, sol, info);
+    ASSERT_EQUAL_INT_OR_FAIL(status, SCS_SOLVED, str, "QP not solved (SCS)");
+    ASSERT_EQUAL_FLOAT_OR_FAIL(info->pobj, -2.0, 1e-5, str, "wrong primal cost (SCS)");
+    ASSERT_EQUAL_FLOAT_OR_FAIL(info->dobj, -2.0, 1e-5, str, "wrong dual cost (SCS)");
+    ASSERT_EQUAL_ARRAY_OR_FAIL(sol->x, x_expected, data->n, 1e-5, str, "wrong solution (SCS)");
+
+    /* only the upper triangular part of P may be given */
+    data->P->p[1] = 2;
+    data->P->i[1] = 1;
+    data->P->i[2] = 1;
+    data->stgs->do_override_streams = 1;
+    data->stgs->output_stream = stderr;
+    status = scs(data, cone, sol, info);
+    ASSERT_EQUAL_INT_OR_FAIL(status, SCS_FAILED, str, "lower triangular P accepted");
+
+    scs_free_data_cone(data, cone);
+    scs_free_info(info);
+    scs_free_sol(sol);
+    SUCCEED(str);
+}
+
+bool test_adaptive_memory(char **str) {
+    scs_int status, i, j;
+    ScsSolution* sol;
+    ScsInfo * info;
+    ScsData * data = SCS_NULL;
+    ScsCone * cone = SCS_NULL;
+    const ScsDirectionType directions[3] = {anderson_acceleration, restarted_broyden, full_broyden};
+    bool mem_changed;
+
+    prepare_data(&data);
+    prepare_cone(&cone);
+
+    data->stgs->eps = 1e-8;
+    data->stgs->do_super_scs = 1;
+    data->stgs->verbose = 0;
+    data->stgs->memory = 6;
+    data->stgs->adaptive_memory = 1;
+    data->stgs->do_record_progress = 1;
+
+    info = scs_init_info();
+    sol = scs_init_sol();
+
+    for (j = 0; j < 3; ++j) {
+        data->stgs->direction = directions[j];
+        status = scs(data, cone, sol, info);
+        ASSERT_EQUAL_INT_OR_FAIL(status, SCS_SOLVED, str, "wrong status");
+        ASSERT_EQUAL_FLOAT_OR_FAIL(info->pobj, -16.375426437011065, 1e-5, str, "pobj wrong");
+        mem_changed = false;
+        for (i = 1; i < info->history_length; ++i) {
+            ASSERT_TRUE_OR_FAIL(info->progress_mem[i] >= 1
+                    && info->progress_mem[i] <= data->stgs->memory, str, "active memory out of range");
+            mem_changed = mem_changed || info->progress_mem[i] != info->progress_mem[1];
+        }
+        ASSERT_TRUE_OR_FAIL(mem_changed, str, "active memory not adapted");
+    }
+
+    /* without adaptive memory, the whole memory is used */
+    data->stgs->adaptive_memory = 0;
+    status = scs(data, cone, sol, info);
+    ASSERT_EQUAL_INT_OR_FAIL(status, SCS_SOLVED, str, "wrong status (fixed memory)");
+    for (i = 0; i < info->history_length; ++i) {
+        ASSERT_EQUAL_INT_OR_FAIL(info->progress_mem[i], data->stgs->memory, str, "active memory not fixed");
+    }
+
+    scs_free_data_cone(data, cone);
+    scs_free_sol(sol);
+    scs_free_info(info);
+
+    SUCCEED(str);
+}
+
+bool test_parallel_line_search(char **str) {
+    scs_int status, iter, i;
+    scs_float pobj;
+    scs_float *x;
+    ScsSolution* sol;
+    ScsInfo * info;
+    ScsData * data = SCS_NULL;
+    ScsCone * cone = SCS_NULL;
+
+    prepare_data(&data);
+    prepare_cone(&cone);
+
+    data->stgs->eps = 1e-8;
+    data->stgs->do_super_scs = 1;
+    data->stgs->verbose = 0;
+    data->stgs->k0 = 0;
+    data->stgs->ls = 10;
+
+    info = scs_init_info();
+    sol = scs_init_sol();
+
+    data->stgs->ls_parallel = 1;
+    status = scs(data, cone, sol, info);
+    ASSERT_EQUAL_INT_OR_FAIL(status, SCS_SOLVED, str, "wrong status (sequential)");
+    iter = info->iter;
+    pobj = info->pobj;
+
+    /* the step sizes are accepted in the same order, so the iterates coincide */
+    for (i = 2; i <= 12; i += 5) {
+        data->stgs->ls_parallel = i;
+        status = scs(data, cone, sol, info);
+        ASSERT_EQUAL_INT_OR_FAIL(status, SCS_SOLVED, str, "wrong status (parallel)");
+        ASSERT_EQUAL_INT_OR_FAIL(info->iter, iter, str, "different number of iterations");
+        ASSERT_EQUAL_FLOAT_OR_FAIL(info->pobj, pobj, 1e-12, str, "different pobj");
+    }
+
+    data->stgs->ls_parallel = 0;
+    data->stgs->output_stream = stderr;
+    status = scs(data, cone, sol, info);
+    ASSERT_EQUAL_INT_OR_FAIL(status, SCS_FAILED, str, "ls_parallel=0 accepted");
+
+    scs_free_data_cone(data, cone);
+
+    /* 
+     * exponential cones: the projections are warm-started, so all trial 
+     * points must start from the same warm start for the iterates to coincide
+     */
+    scs_free_sol(sol);
+    sol = scs_init_sol();
+    prepare_exp_problem(&data, &cone, 5);
+    data->stgs->eps = 1e-8;
+    data->stgs->do_super_scs = 1;
+    data->stgs->verbose = 0;
+    data->stgs->k0 = 0;
+    data->stgs->k1 = 0;
+    data->stgs->ls = 10;
+    data->stgs->direction = (ScsDirectionType) anderson_acceleration;
+    data->stgs->ls_parallel = 1;
+    status = scs(data, cone, sol, info);
+    ASSERT_EQUAL_INT_OR_FAIL(status, SCS_SOLVED, str, "wrong status (exp, sequential)");
+    ASSERT_EQUAL_FLOAT_OR_FAIL(sol->x[3], log(3.0), 1e-5, str, "wrong solution (exp)");
+    iter = info->iter;
+    x = malloc(data->n * sizeof (scs_float));
+    memcpy(x, sol->x, data->n * sizeof (scs_float));
+
+    data->stgs->ls_parallel = 4;
+    status = scs(data, cone, sol, info);
+    ASSERT_EQUAL_INT_OR_FAIL(status, SCS_SOLVED, str, "wrong status (exp, parallel)");
+    ASSERT_EQUAL_INT_OR_FAIL(info->iter, iter, str, "different number of iterations (exp)");
+    ASSERT_EQUAL_ARRAY_OR_FAIL(sol->x, x, data->n, 1e-14, str, "different solution (exp)");
+
+    free(x);
+    scs_free_data_cone(data, cone);
+    scs_free_sol(sol);
+    scs_free_info(info);
+
+    SUCCEED(str);
+}
+
+bool test_adaptive_check_interval(char **str) {
+    scs_int status, i, j, iter;
+    ScsSolution* sol;
+    ScsInfo * info;
+    ScsData * data = SCS_NULL;
+    ScsCone * cone = SCS_NULL;
+
+    prepare_data(&data);
+    prepare_cone(&cone);
+
+    data->stgs->eps = 1e-8;
+    data->stgs->verbose = 0;
+    data->stgs->do_record_progress = 1;
+    data->stgs->max_iters = 2000;
+
+    info = scs_init_info();
+    sol = scs_init_sol();
+
+    for (j = 0; j < 2; ++j) {
+        data->stgs->do_super_scs = 1 - j;
+
+        /* the residuals are checked at every iteration */
+        data->stgs->max_check_interval = 1;
+        status = scs(data, cone, sol, info);
+        ASSERT_EQUAL_INT_OR_FAIL(status, SCS_SOLVED, str, "wrong status");
+        ASSERT_EQUAL_INT_OR_FAIL(info->history_length, info->iter, str, "wrong history length");
+        iter = info->iter;
+
+        /* adaptive checks */
+        data->stgs->max_check_interval = 20;
+        status = scs(data, cone, sol, info);
+        ASSERT_EQUAL_INT_OR_FAIL(status, SCS_SOLVED, str, "wrong status (adaptive)");
+        ASSERT_EQUAL_FLOAT_OR_FAIL(info->pobj, -16.375426437011065, 1e-5, str, "pobj wrong");
+        ASSERT_TRUE_OR_FAIL(info->history_length < info->iter, str, "residuals checked at every iteration");
+        ASSERT_TRUE_OR_FAIL(info->iter >= iter && info->iter < iter + data->stgs->max_check_interval,
+                str, "convergence detected too late");
+        ASSERT_EQUAL_INT_OR_FAIL(info->progress_iter[0], 0, str, "first check");
+        for (i = 1; i < info->history_length; ++i) {
+            ASSERT_TRUE_OR_FAIL(info->progress_iter[i] > info->progress_iter[i - 1]
+                    && info->progress_iter[i] - info->progress_iter[i - 1] <= data->stgs->max_check_interval,
+                    str, "wrong check interval");
+        }
+    }
+
+    scs_free_data_cone(data, cone);
+    scs_free_sol(sol);
+    scs_free_info(info);
+
+    SUCCEED(str);
+}
+
+bool test_async_monitor(char **str) {
+    scs_int status, i, j, iter;
+    ScsSolution* sol;
+    ScsInfo * info;
+    ScsData * data = SCS_NULL;
+    ScsCone * cone = SCS_NULL;
+
+    prepare_data(&data);
+    prepare_cone(&cone);
+
+    data->stgs->eps = 1e-8;
+    data->stgs->do_super_scs = 1;
+    data->stgs->verbose = 0;
+    data->stgs->do_record_progress = 1;
+
+    info = scs_init_info();
+    sol = scs_init_sol();
+
+    status = scs(data, cone, sol, info);
+    ASSERT_EQUAL_INT_OR_FAIL(status, SCS_SOLVED, str, "wrong status (synchronous)");
+    iter = info->iter;
+
+    data->stgs->async_monitor = 1;
+    for (j = 0; j < 2; ++j) {
+        data->stgs->max_check_interval = 1 + 9 * j;
+        status = scs(data, cone, sol, info);
+        ASSERT_EQUAL_INT_OR_FAIL(status, SCS_SOLVED, str, "wrong status");
+        ASSERT_EQUAL_FLOAT_OR_FAIL(info->pobj, -16.375426437011065, 1e-5, str, "pobj wrong");
+        /* the reported solution is the certified snapshot */
+        ASSERT_TRUE_OR_FAIL(info->resPri < data->stgs->eps
+                && info->resDual < data->stgs->eps
+                && info->relGap < data->stgs->eps, str, "reported solution not certified");
+        ASSERT_TRUE_OR_FAIL(info->iter >= iter, str, "converged earlier than the synchronous checks");
+        ASSERT_TRUE_OR_FAIL(info->history_length >= 1 && info->history_length <= info->iter,
+                str, "wrong history length");
+        for (i = 1; i < info->history_length; ++i) {
+            ASSERT_TRUE_OR_FAIL(info->progress_iter[i] > info->progress_iter[i - 1],
+                    str, "progress not increasing");
+        }
+    }
+
+    scs_free_data_cone(data, cone);
+    scs_free_sol(sol);
+    scs_free_info(info);
+
+    SUCCEED(str);
+}
+
+bool test_interrupt_listeners(char **str) {
+#if CTRLC > 0
+    ScsInterruptListener first, second, disabled;
+
+    startInterruptListener(&disabled, 0);
+    startInterruptListener(&first, 1);
+    ASSERT_TRUE_OR_FAIL(!isInterrupted(&first), str, "interrupted on start");
+    raise(SIGINT);
+    ASSERT_TRUE_OR_FAIL(isInterrupted(&first), str, "interrupt not detected");
+    ASSERT_TRUE_OR_FAIL(!isInterrupted(&disabled), str, "disabled listener interrupted");
+
+    /* a listener started later does not see earlier interrupts */
+    startInterruptListener(&second, 1);
+    ASSERT_TRUE_OR_FAIL(!isInterrupted(&second), str, "earlier interrupt detected");
+    endInterruptListener(&first);
+    ASSERT_TRUE_OR_FAIL(!isInterrupted(&first), str, "ended listener interrupted");
+    raise(SIGINT);
+    ASSERT_TRUE_OR_FAIL(isInterrupted(&second), str, "interrupt not detected (2)");
+    endInterruptListener(&second);
+    endInterruptListener(&disabled);
+#endif
+    SUCCEED(str);
+}
+
+#ifdef SCS_TEST_THREADS
+#define SCS_TEST_NUM_SOLVES 4
+
+typedef struct {
+    scs_int status;
+    scs_int iter;
+    scs_float pobj;
+    scs_int parsed_m;
+} ScsConcurrentSolve;
+
+static void *scs_concurrent_solve(void *arg) {
+    ScsConcurrentSolve *result = (ScsConcurrentSolve *) arg;
+    ScsData * data = SCS_NULL;
+    ScsCone * cone = SCS_NULL;
+    ScsSolution *sol = scs_init_sol();
+    ScsInfo *info = scs_init_info();
+
+    if (scs_from_YAML("tests/c/data/test-1.yml", &data, &cone) == 0) {
+        result->parsed_m = data->m;
+    }
+    scs_free_data_cone(data, cone);
+
+    prepare_data(&data);
+    prepare_cone(&cone);
+    data->stgs->eps = 1e-8;
+    data->stgs->verbose = 0;
+    data->stgs->direction = (ScsDirectionType) anderson_acceleration;
+    result->status = scs(data, cone, sol, info);
+    result->iter = info->iter;
+    result->pobj = info->pobj;
+
+    scs_free_data_cone(data, cone);
+    scs_free_sol(sol);
+    scs_free_info(info);
+    return SCS_NULL;
+}
+#endif
+
+bool test_concurrent_solves(char **str) {
+#ifdef SCS_TEST_THREADS
+    pthread_t threads[SCS_TEST_NUM_SOLVES];
+    ScsConcurrentSolve results[SCS_TEST_NUM_SOLVES + 1];
+    scs_int i;
+
+    memset(results, 0, sizeof (results));
+    /* reference: sequential solve */
+    scs_concurrent_solve(&results[SCS_TEST_NUM_SOLVES]);
+    ASSERT_EQUAL_INT_OR_FAIL(results[SCS_TEST_NUM_SOLVES].status, SCS_SOLVED, str, "not solved");
+    ASSERT_EQUAL_INT_OR_FAIL(results[SCS_TEST_NUM_SOLVES].parsed_m, 4, str, "wrong m");
+
+    for (i = 0; i < SCS_TEST_NUM_SOLVES; ++i) {
+        ASSERT_EQUAL_INT_OR_FAIL(pthread_create(&threads[i], SCS_NULL,
+                scs_concurrent_solve, &results[i]), 0, str, "thread not created");
+    }
+    for (i = 0; i < SCS_TEST_NUM_SOLVES; ++i) {
+        pthread_join(threads[i], SCS_NULL);
+    }
+    for (i = 0; i < SCS_TEST_NUM_SOLVES; ++i) {
+        ASSERT_EQUAL_INT_OR_FAIL(results[i].status, SCS_SOLVED, str, "not solved (concurrent)");
+        ASSERT_EQUAL_INT_OR_FAIL(results[i].parsed_m, 4, str, "wrong m (concurrent)");
+        ASSERT_EQUAL_INT_OR_FAIL(results[i].iter, results[SCS_TEST_NUM_SOLVES].iter,
+                str, "different number of iterations");
+        ASSERT_EQUAL_FLOAT_OR_FAIL(results[i].pobj, results[SCS_TEST_NUM_SOLVES].pobj,
+                1e-14, str, "different pobj");
+    }
+#endif
+    SUCCEED(str);
+}
@@ -93,6 +93,42 @@ extern "C" {
     bool test_overtime_stop(char **str);
     
     bool test_overtime_stop_scs(char **str);
+    
+    bool test_chordal_decomposition(char **str);
+    
+    bool test_chordal_large_sparse_cone(char **str);
+    
+    bool test_exp_cone_projection(char **str);
+    
+    bool test_power_cone_projection(char **str);
+    
+    bool test_cone_projection_batch(char **str);
+    
+    bool test_cone_projection_early_iterations(char **str);
+    
+    bool test_inexact_cone_projections(char **str);
+    
+    bool test_box_cone(char **str);
+    
+    bool test_cone_stats(char **str);
+    
+    bool test_presolve_cones(char **str);
+    
+    bool test_rotated_soc(char **str);
+    
+    bool test_quadratic_cost(char **str);
+    
+    bool test_adaptive_memory(char **str);
+    
+    bool test_parallel_line_search(char **str);
+    
+    bool test_adaptive_check_interval(char **str);
+    
+    bool test_async_monitor(char **str);
+    
+    bool test_interrupt_listeners(char **str);
+    
+    bool test_concurrent_solves(char **str);
 
 #ifdef __cplusplus
 }
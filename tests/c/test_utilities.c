@@ -28,6 +28,7 @@
 #include <float.h>
 
 #include "test_utilities.h"
+#include "linsys/amatrix.h"
 
 extern void scs_dgemm_nn(
         int m,
@@ -179,6 +180,37 @@ bool test_scs_gemm(char** str) {
 
 }
 
+bool test_scs_gemm_blocks(char** str) {
+    /* larger than the block sizes of scs_dgemm_nn and not multiples of them */
+    const int m = 203, n = 101, k = 197;
+    double *A = scs_malloc(m * k * sizeof (double));
+    double *B = scs_malloc(k * n * sizeof (double));
+    double *C = scs_malloc(m * n * sizeof (double));
+    double *Cexp = scs_malloc(m * n * sizeof (double));
+    int i, j, l;
+
+    /* small integers, so that all sums are exact */
+    for (i = 0; i < m * k; ++i) A[i] = (double) (i % 7) - 3.;
+    for (i = 0; i < k * n; ++i) B[i] = (double) (i % 5) - 2.;
+    for (i = 0; i < m * n; ++i) C[i] = Cexp[i] = (double) (i % 3);
+    for (j = 0; j < n; ++j) {
+        for (i = 0; i < m; ++i) {
+            Cexp[i + j * m] *= 3.;
+            for (l = 0; l < k; ++l) {
+                Cexp[i + j * m] += 2. * A[i + l * m] * B[l + j * k];
+            }
+        }
+    }
+    scs_dgemm_nn(m, n, k, 2., A, 1, m, B, 1, k, 3., C, 1, m);
+    ASSERT_EQUAL_ARRAY_OR_FAIL(C, Cexp, m * n, 1e-12, str, "gemm failed");
+
+    scs_free(A);
+    scs_free(B);
+    scs_free(C);
+    scs_free(Cexp);
+    SUCCEED(str);
+}
+
 bool test_scs_gemm_cp(char** str) {
     double A[10] = {
         0.334430155748757,
@@ -362,6 +394,122 @@ bool test_scs_norm_difference(char** str) {
     SUCCEED(str);
 }
 
+bool test_fused_kernels(char** str) {
+    scs_float a[] = {7.61, 3.52, 2.56, 2.31, 1.41, 9.74, 4.63, 2.97, 4.85, 1.59};
+    scs_float b[] = {5.20, 9.57, 4.52, 1.61, 0.70, 4.74, 2.05, 7.51, 1.36, 7.17};
+    scs_float c[] = {-1.3, 0.2, 4.1, -0.7, 2.2, 0.9, -3.4, 1.8, 0.5, -2.6};
+    scs_float x[10], y[10], x_exp[10], y_exp[10];
+    scs_float nrm_sq;
+    const scs_float rho = 0.1, gamma = SQRTF(0.1);
+    const scs_int n = 4, l = 10;
+    scs_int i;
+
+    /* x = a + 0.3 b, y = c + 0.3 a */
+    scs_axpy2(x, a, b, y, c, a, 0.3, l);
+    scs_axpy(x_exp, a, b, 1.0, 0.3, l);
+    scs_axpy(y_exp, c, a, 1.0, 0.3, l);
+    ASSERT_EQUAL_ARRAY_OR_FAIL(x, x_exp, l, 1e-12, str, "scs_axpy2 (x)");
+    ASSERT_EQUAL_ARRAY_OR_FAIL(y, y_exp, l, 1e-12, str, "scs_axpy2 (y)");
+
+    /* x = a - b and rho |x(1:n)|^2 + |x(n+1:l)|^2 */
+    nrm_sq = scs_difference_weighted_norm_squared(x, a, b, rho, n, l);
+    scs_axpy(x_exp, a, b, 1.0, -1.0, l);
+    ASSERT_EQUAL_ARRAY_OR_FAIL(x, x_exp, l, 1e-12, str, "difference");
+    ASSERT_EQUAL_FLOAT_OR_FAIL(nrm_sq,
+            rho * scs_norm_squared(x_exp, n) + scs_norm_squared(x_exp + n, l - n),
+            1e-12, str, "weighted norm");
+
+    /* x = D(a - b), y = D(c - a), D = diag(gamma I_n, I) */
+    scs_scaled_difference2(x, a, b, y, c, a, gamma, n, l);
+    for (i = 0; i < l; ++i) {
+        ASSERT_EQUAL_FLOAT_OR_FAIL(x[i], (i < n ? gamma : 1.0) * (a[i] - b[i]), 1e-12, str, "scaled difference (x)");
+        ASSERT_EQUAL_FLOAT_OR_FAIL(y[i], (i < n ? gamma : 1.0) * (c[i] - a[i]), 1e-12, str, "scaled difference (y)");
+    }
+    SUCCEED(str);
+}
+
+bool test_accum_by_a_and_a_trans(char** str) {
+    /* A = [1 0 2; 0 3 0; 4 0 5; 0 6 0] */
+    scs_float Ax[] = {1.0, 4.0, 3.0, 6.0, 2.0, 5.0};
+    scs_int Ai[] = {0, 2, 1, 3, 0, 2};
+    scs_int Ap[] = {0, 2, 4, 6};
+    ScsAMatrix A;
+    scs_float x[] = {0.5, -1.0, 2.0};
+    scs_float y[] = {1.0, -2.0, 0.5, 3.0};
+    scs_float z[] = {1.0, 1.0, 1.0, 1.0};
+    scs_float w[] = {-1.0, 0.0, 1.0};
+    const scs_float z_exp[] = {5.5, -2.0, 13.0, -5.0};
+    const scs_float w_exp[] = {2.0, 12.0, 5.5};
+
+    A.x = Ax;
+    A.i = Ai;
+    A.p = Ap;
+    A.m = 4;
+    A.n = 3;
+    scs_accum_by_a_and_a_trans(&A, x, y, z, w);
+    ASSERT_EQUAL_ARRAY_OR_FAIL(z, z_exp, 4, 1e-14, str, "A*x");
+    ASSERT_EQUAL_ARRAY_OR_FAIL(w, w_exp, 3, 1e-14, str, "A'*y");
+    SUCCEED(str);
+}
+
+bool test_deadline(char** str) {
+    ScsTimer timer;
+    ScsDeadline deadline;
+    scs_float elapsed;
+    scs_int calls = 0;
+
+    scs_tic(&timer);
+    scs_deadline_start(&deadline, &timer, 0.0);
+    ASSERT_TRUE_OR_FAIL(scs_deadline_passed(&deadline), str, "zero budget not exceeded");
+
+    scs_tic(&timer);
+    scs_deadline_start(&deadline, &timer, 5.0);
+    while (!scs_deadline_passed(&deadline)) {
+        calls++;
+    }
+    elapsed = scs_toc_quiet(&timer);
+    ASSERT_TRUE_OR_FAIL(elapsed >= 5.0, str, "deadline passed too early");
+    ASSERT_TRUE_OR_FAIL(elapsed < 100.0, str, "deadline passed too late");
+    ASSERT_TRUE_OR_FAIL(calls > 1, str, "too few calls");
+    /* once passed, it remains passed */
+    ASSERT_TRUE_OR_FAIL(scs_deadline_passed(&deadline), str, "deadline not passed");
+    SUCCEED(str);
+}
+
+bool test_long_vector_kernels(char** str) {
+    const scs_int n = 3 * SCS_PARALLEL_VECTOR_THRESHOLD + 17;
+    scs_float *x = scs_malloc(n * sizeof (scs_float));
+    scs_float *y = scs_malloc(n * sizeof (scs_float));
+    scs_float *z = scs_malloc(n * sizeof (scs_float));
+    scs_float ip, ip_expected = 0.;
+    scs_int i;
+
+    /* small integers, so that all sums are exact */
+    for (i = 0; i < n; ++i) {
+        x[i] = (scs_float) (i % 7) - 3.;
+        y[i] = (scs_float) (i % 5) + 1.;
+        ip_expected += x[i] * y[i];
+    }
+    ip = scs_inner_product(x, y, n);
+    ASSERT_EQUAL_FLOAT_OR_FAIL(ip, ip_expected, 1e-12, str, "inner product");
+    ASSERT_TRUE_OR_FAIL(ip == scs_inner_product(x, y, n), str, "not reproducible");
+
+    scs_axpy(z, x, y, 2., -1., n);
+    ASSERT_EQUAL_FLOAT_OR_FAIL(z[n - 1], 2. * x[n - 1] - y[n - 1], 1e-12, str, "axpy (last)");
+    ASSERT_EQUAL_FLOAT_OR_FAIL(z[n / 2], 2. * x[n / 2] - y[n / 2], 1e-12, str, "axpy (middle)");
+
+    scs_add_scaled_array(z, y, n, 1.); /* z = 2x */
+    scs_subtract_array(z, x, n); /* z = x */
+    ASSERT_EQUAL_ARRAY_OR_FAIL(z, x, n, 1e-12, str, "add/subtract");
+    ASSERT_EQUAL_FLOAT_OR_FAIL(scs_norm_squared(z, n), scs_inner_product(x, x, n),
+            1e-12, str, "norm squared");
+
+    scs_free(x);
+    scs_free(y);
+    scs_free(z);
+    SUCCEED(str);
+}
+
 bool testscs_millis_to_time(char** str) {
     scs_float t;
     scs_int hours;
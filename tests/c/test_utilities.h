@@ -51,6 +51,8 @@ extern "C" {
 
     bool test_scs_gemm(char** str);
 
+    bool test_scs_gemm_blocks(char** str);
+
     bool test_scs_gemm_cp(char** str);
 
     bool test_scs_gemm_trans_cp(char** str);
@@ -61,6 +63,14 @@ extern "C" {
 
     bool test_scs_norm_difference(char** str);
 
+    bool test_fused_kernels(char** str);
+
+    bool test_accum_by_a_and_a_trans(char** str);
+
+    bool test_deadline(char** str);
+
+    bool test_long_vector_kernels(char** str);
+
     bool testscs_millis_to_time(char** str);
 
     bool test_scs_axpy(char** str);